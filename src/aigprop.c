@@ -877,6 +877,94 @@ select_move (BtorAIGProp *aprop,
   }
 }
 
+/* Set the simulation values of all inputs to their current assignment. */
+static void
+sync_sim_vars (BtorAIGProp *aprop)
+{
+  assert (aprop);
+  assert (aprop->sim);
+
+  uint32_t i;
+  BtorAIG *var;
+
+  for (i = 0; i < BTOR_COUNT_STACK (aprop->sim->vars); i++)
+  {
+    var = BTOR_PEEK_STACK (aprop->sim->vars, i);
+    btor_aigsim_set_var (
+        aprop->sim,
+        var,
+        btor_aigprop_get_assignment_aig (aprop, var) > 0 ? ~(uint64_t) 0 : 0);
+  }
+}
+
+/* Evaluate the propagation move (lane 0) together with 'nsim_flips' random
+ * input flips (lanes 1 to nsim_flips) via bit-parallel simulation and select
+ * the move that maximizes the number of satisfied roots (prefer the
+ * propagation move on ties). */
+static void
+select_move_sim (BtorAIGProp *aprop, BtorAIG **input, int32_t *assignment)
+{
+  assert (aprop);
+  assert (aprop->sim);
+  assert (aprop->nsim_flips < BTOR_AIGSIM_NLANES);
+  assert (input);
+  assert (BTOR_IS_REGULAR_AIG (*input));
+  assert (assignment);
+
+  double start;
+  uint32_t i, n, best, nsat[BTOR_AIGSIM_NLANES];
+  uint64_t val;
+  BtorAIG *vars[BTOR_AIGSIM_NLANES];
+  BtorAIGSim *sim;
+  BtorIntHashTableIterator it;
+
+  start = btor_util_time_stamp ();
+  sim   = aprop->sim;
+  n     = aprop->nsim_flips + 1;
+
+  vars[0] = *input;
+  if (btor_aigprop_get_assignment_aig (aprop, *input) != *assignment)
+    btor_aigsim_set_var (sim, *input, btor_aigsim_get (sim, *input) ^ 1);
+  for (i = 1; i < n; i++)
+  {
+    vars[i] = BTOR_PEEK_STACK (
+        sim->vars,
+        btor_rng_pick_rand (&aprop->rng, 0, BTOR_COUNT_STACK (sim->vars) - 1));
+    btor_aigsim_set_var (
+        sim, vars[i], btor_aigsim_get (sim, vars[i]) ^ ((uint64_t) 1 << i));
+  }
+
+  btor_aigsim_simulate (sim);
+
+  memset (nsat, 0, sizeof (nsat));
+  btor_iter_hashint_init (&it, aprop->roots);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    val = btor_aigsim_get (
+        sim, btor_aig_get_by_id (aprop->amgr, btor_iter_hashint_next (&it)));
+    for (i = 0; i < n; i++) nsat[i] += (val >> i) & 1;
+  }
+
+  for (i = 1, best = 0; i < n; i++)
+    if (nsat[i] > nsat[best]) best = i;
+
+  /* reset inputs to current assignment */
+  for (i = 0; i < n; i++)
+    btor_aigsim_set_var (
+        sim,
+        vars[i],
+        btor_aigprop_get_assignment_aig (aprop, vars[i]) > 0 ? ~(uint64_t) 0
+                                                              : 0);
+
+  if (best)
+  {
+    *input      = vars[best];
+    *assignment = -btor_aigprop_get_assignment_aig (aprop, vars[best]);
+    aprop->stats.sim_moves += 1;
+  }
+  aprop->time.sim += btor_util_time_stamp () - start;
+}
+
 static int32_t
 move (BtorAIGProp *aprop, uint32_t nmoves)
 {
@@ -892,6 +980,7 @@ move (BtorAIGProp *aprop, uint32_t nmoves)
   if (!(root = select_root (aprop, nmoves))) return 0;
 
   select_move (aprop, root, &input, &assignment);
+  if (aprop->sim) select_move_sim (aprop, &input, &assignment);
 
   BTOR_AIGPROPLOG (1, "");
   BTOR_AIGPROPLOG (1, "*** move");
@@ -906,6 +995,9 @@ move (BtorAIGProp *aprop, uint32_t nmoves)
 #endif
 
   update_cone (aprop, input, assignment);
+  if (aprop->sim)
+    btor_aigsim_set_var (
+        aprop->sim, input, assignment > 0 ? ~(uint64_t) 0 : 0);
   aprop->stats.moves += 1;
   return 1;
 }
@@ -998,6 +1090,17 @@ btor_aigprop_sat (BtorAIGProp *aprop, BtorIntHashTable *roots)
   /* generate initial model, all inputs are initialized with false */
   btor_aigprop_generate_model (aprop, true);
 
+  if (aprop->nsim_flips)
+  {
+    assert (!aprop->sim);
+    aprop->sim = btor_aigsim_new (aprop->amgr);
+    btor_iter_hashint_init (&it, roots);
+    while (btor_iter_hashint_has_next (&it))
+      btor_aigsim_add_root (
+          aprop->sim,
+          btor_aig_get_by_id (aprop->amgr, btor_iter_hashint_next (&it)));
+  }
+
   for (;;)
   {
     /* collect unsatisfied roots (kept up-to-date in update_cone) */
@@ -1020,6 +1123,8 @@ btor_aigprop_sat (BtorAIGProp *aprop, BtorIntHashTable *roots)
     /* compute initial score */
     compute_scores (aprop);
 
+    if (aprop->sim) sync_sim_vars (aprop);
+
     if (!aprop->unsatroots->count) goto SAT;
 
     for (j = 0, max_steps = BTOR_AIGPROP_MAXSTEPS (aprop->stats.restarts + 1);
@@ -1055,6 +1160,8 @@ DONE:
   }
   btor_hashint_map_delete (aprop->parents);
   aprop->parents = 0;
+  if (aprop->sim) btor_aigsim_delete (aprop->sim);
+  aprop->sim = 0;
   if (aprop->unsatroots) btor_hashint_map_delete (aprop->unsatroots);
   aprop->unsatroots = 0;
   aprop->roots      = 0;
@@ -1087,6 +1194,7 @@ btor_aigprop_clone_aigprop (BtorAIGMgr *clone, BtorAIGProp *aprop)
       btor_hashint_map_clone (mm, aprop->score, btor_clone_data_as_dbl, 0);
   res->model =
       btor_hashint_map_clone (mm, aprop->model, btor_clone_data_as_int, 0);
+  res->sim = 0;
   return res;
 }
 
@@ -9,6 +9,7 @@
 #define BTOR_AIGPROP_H_INCLUDED
 
 #include "btoraig.h"
+#include "btoraigsim.h"
 #include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 #include "utils/btorrng.h"
@@ -25,6 +26,7 @@ struct BtorAIGProp
   BtorIntHashTable *score;
   BtorIntHashTable *model;
   BtorIntHashTable *parents;
+  BtorAIGSim *sim; /* bit-parallel evaluation of flips */
 
   BtorRNG rng;
 
@@ -32,11 +34,13 @@ struct BtorAIGProp
   uint32_t seed;
   uint32_t use_restarts;
   uint32_t use_bandit;
+  uint32_t nsim_flips;
 
   struct
   {
     uint32_t moves;
     uint32_t restarts;
+    uint32_t sim_moves; /* moves selected via simulation */
   } stats;
 
   struct
@@ -46,6 +50,7 @@ struct BtorAIGProp
     double update_cone_reset;
     double update_cone_model_gen;
     double update_cone_compute_score;
+    double sim;
   } time;
 };
 
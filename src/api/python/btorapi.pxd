@@ -10,7 +10,7 @@
 from libc.stdio cimport FILE
 from libcpp cimport bool
 from cpython.ref cimport PyObject
-from libc.stdint cimport int32_t, uint32_t
+from libc.stdint cimport int32_t, uint32_t, uint64_t
 from pyboolector import BoolectorException
 
 #include "pyboolector_enums.pxd"
@@ -69,6 +69,16 @@ cdef extern from "boolector.h":
     void boolector_print_stats (Btor * btor) \
       except +raise_py_error
 
+    void boolector_get_simp_pass_stats (Btor * btor,
+                                        const char * pass_name,
+                                        uint32_t * runs,
+                                        double * time,
+                                        uint64_t * nodes_before,
+                                        uint64_t * nodes_after,
+                                        uint64_t * substitutions,
+                                        uint32_t * inconsistent) \
+      except +raise_py_error
+
     #void boolector_set_trapi (Btor * btor,
     #                          FILE * apitrace) \
     #  except +raise_py_error
@@ -111,6 +121,9 @@ cdef extern from "boolector.h":
     void boolector_set_sat_solver (Btor * btor, const char * solver) \
       except +raise_py_error
 
+    void boolector_set_simp_pipeline (Btor * btor, const char * pipeline) \
+      except +raise_py_error
+
     void boolector_set_opt (Btor * btor, BtorOption opt, uint32_t val) \
       except +raise_py_error
 
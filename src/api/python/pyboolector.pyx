@@ -942,6 +942,48 @@ cdef class Boolector:
         """
         return btorapi.boolector_simplify(self._c_btor)
 
+    def Set_simp_pipeline(self, str pipeline):
+        """ Set_simp_pipeline(pipeline)
+
+            Set the preprocessing pipeline.
+
+            E.g., ::
+
+              btor = Boolector()
+              btor.Set_simp_pipeline("skeleton:1,linear,ucopt")
+
+            :param pipeline: Comma-separated list of preprocessing passes
+                             with optional repetition limit
+                             (``<pass>[:<limit>]``).
+            :type pipeline:  str
+        """
+        btorapi.boolector_set_simp_pipeline(self._c_btor,
+                                            _ChPtr(pipeline)._c_str)
+
+    def Get_simp_pass_stats(self, str pass_name):
+        """ Get_simp_pass_stats(pass_name)
+
+            Get the statistics of a preprocessing pass.
+
+            :param pass_name: The name of the preprocessing pass.
+            :type pass_name:  str
+            :return: A dictionary with keys ``runs``, ``time``,
+                     ``nodes_before``, ``nodes_after``, ``substitutions``
+                     and ``inconsistent``.
+            :rtype: dict
+        """
+        cdef uint32_t runs, inconsistent
+        cdef double time
+        cdef uint64_t nodes_before, nodes_after, substitutions
+        btorapi.boolector_get_simp_pass_stats(self._c_btor,
+                                              _ChPtr(pass_name)._c_str,
+                                              &runs, &time, &nodes_before,
+                                              &nodes_after, &substitutions,
+                                              &inconsistent)
+        return {"runs": runs, "time": time, "nodes_before": nodes_before,
+                "nodes_after": nodes_after, "substitutions": substitutions,
+                "inconsistent": inconsistent}
+
     def Clone(self):
         """ Clone()
 
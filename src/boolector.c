@@ -391,6 +391,42 @@ boolector_print_stats (Btor *btor)
 #endif
 }
 
+void
+boolector_get_simp_pass_stats (Btor *btor,
+                               const char *pass,
+                               uint32_t *runs,
+                               double *time,
+                               uint64_t *nodes_before,
+                               uint64_t *nodes_after,
+                               uint64_t *substitutions,
+                               uint32_t *inconsistent)
+{
+  uint32_t i;
+  BtorSimpPassStats *stats;
+
+  BTOR_ABORT_ARG_NULL (btor);
+  BTOR_TRAPI ("%s", pass);
+  BTOR_ABORT_ARG_NULL (pass);
+  BTOR_ABORT_ARG_NULL (runs);
+  BTOR_ABORT_ARG_NULL (time);
+  BTOR_ABORT_ARG_NULL (nodes_before);
+  BTOR_ABORT_ARG_NULL (nodes_after);
+  BTOR_ABORT_ARG_NULL (substitutions);
+  BTOR_ABORT_ARG_NULL (inconsistent);
+
+  for (i = 0; i < BTOR_SIMP_PASS_NUM; i++)
+    if (!strcmp (pass, g_btor_simp_pass_names[i])) break;
+  BTOR_ABORT (i == BTOR_SIMP_PASS_NUM, "invalid preprocessing pass '%s'", pass);
+
+  stats          = &btor->stats.simp_passes[i];
+  *runs          = stats->runs;
+  *time          = btor->time.simp_passes[i];
+  *nodes_before  = stats->nodes_before;
+  *nodes_after   = stats->nodes_after;
+  *substitutions = stats->substitutions;
+  *inconsistent  = stats->inconsistent;
+}
+
 void
 boolector_set_trapi (Btor *btor, FILE *apitrace)
 {
@@ -735,6 +771,23 @@ boolector_set_sat_solver (Btor *btor, const char *solver)
 #endif
 }
 
+void
+boolector_set_simp_pipeline (Btor *btor, const char *pipeline)
+{
+  BtorSimpPipeline p;
+
+  BTOR_ABORT_ARG_NULL (btor);
+  BTOR_TRAPI ("%s", pipeline);
+  BTOR_ABORT_ARG_NULL (pipeline);
+  BTOR_ABORT (!btor_simplify_parse_pipeline (pipeline, &p),
+              "invalid preprocessing pipeline '%s'",
+              pipeline);
+  btor_opt_set_str (btor, BTOR_OPT_SIMP_PIPELINE, pipeline);
+#ifndef NDEBUG
+  BTOR_CHKCLONE_NORES (set_simp_pipeline, pipeline);
+#endif
+}
+
 /*------------------------------------------------------------------------*/
 
 void
@@ -756,38 +809,17 @@ boolector_set_opt (Btor *btor, BtorOption opt, uint32_t val)
       BTOR_ABORT (btor->btor_sat_btor_called > 0,
                   "enabling/disabling incremental usage must be done "
                   "before calling 'boolector_sat'");
-      BTOR_ABORT (btor_opt_get (btor, BTOR_OPT_UCOPT),
-                  "incremental solving cannot be enabled "
-                  "if unconstrained optimization is enabled");
-    }
-    else if (opt == BTOR_OPT_UCOPT)
-    {
-      BTOR_ABORT (btor_opt_get (btor, BTOR_OPT_MODEL_GEN),
-                  "Unconstrained optimization cannot be enabled "
-                  "if model generation is enabled");
-      BTOR_ABORT (btor_opt_get (btor, BTOR_OPT_INCREMENTAL),
-                  "Unconstrained optimization cannot be enabled "
-                  "in incremental mode");
     }
     else if (opt == BTOR_OPT_FUN_DUAL_PROP)
     {
       BTOR_ABORT (btor_opt_get (btor, BTOR_OPT_FUN_JUST),
                   "enabling multiple optimization techniques is not allowed");
-      BTOR_ABORT (btor_opt_get (btor, BTOR_OPT_NONDESTR_SUBST),
-                  "Non-destructive substitution is not supported with dual "
-                  "propagation");
     }
     else if (opt == BTOR_OPT_FUN_JUST)
     {
       BTOR_ABORT (btor_opt_get (btor, BTOR_OPT_FUN_DUAL_PROP),
                   "enabling multiple optimization techniques is not allowed");
     }
-    else if (opt == BTOR_OPT_NONDESTR_SUBST)
-    {
-      BTOR_ABORT (btor_opt_get (btor, BTOR_OPT_FUN_DUAL_PROP),
-                  "Non-destructive substitution is not supported with dual "
-                  "propagation");
-    }
   }
 
   uint32_t oldval = btor_opt_get (btor, opt);
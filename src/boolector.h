@@ -178,6 +178,34 @@ void boolector_reset_stats (Btor *btor);
 */
 void boolector_print_stats (Btor *btor);
 
+/*!
+  Get the statistics of preprocessing pass ``pass``.
+
+  Valid pass names are ``varsubst``, ``embedded``, ``elimslices``,
+  ``skeleton``, ``linear``, ``knownbits``, ``symmetry``, ``ucopt``,
+  ``extract``, ``merge``, ``elimapplies``, ``ackermann`` and ``normadd``.
+
+  :param btor: Boolector instance.
+  :param pass: The name of the preprocessing pass.
+  :param runs: Number of runs of the pass.
+  :param time: Time spent in the pass (in seconds).
+  :param nodes_before: Sum of the number of nodes before each run.
+  :param nodes_after: Sum of the number of nodes after each run.
+  :param substitutions: Number of nodes simplified by the pass.
+  :param inconsistent: Number of runs that detected an inconsistency.
+
+  .. seealso::
+    boolector_set_simp_pipeline
+*/
+void boolector_get_simp_pass_stats (Btor *btor,
+                                    const char *pass,
+                                    uint32_t *runs,
+                                    double *time,
+                                    uint64_t *nodes_before,
+                                    uint64_t *nodes_after,
+                                    uint64_t *substitutions,
+                                    uint32_t *inconsistent);
+
 /*!
   Set the output API trace file and enable API tracing.
 
@@ -396,6 +424,30 @@ int32_t boolector_simplify (Btor *btor);
 */
 void boolector_set_sat_solver (Btor *btor, const char *solver);
 
+/*!
+  Set the preprocessing pipeline.
+
+  The pipeline is a comma-separated list of preprocessing passes of the form
+  ``<pass>[:<limit>]``, where ``<limit>`` is the maximum number of runs of the
+  pass per call to the preprocessor (unlimited if omitted or ``0``), e.g.,
+  ``"skeleton:1,linear,ucopt,elimapplies,ackermann"``.
+  Passes are run in the given order, passes that are not listed are not run.
+  Listing a pass enables it independent of its corresponding option, but
+  passes that are not supported for the current formula are still skipped
+  (``elimslices`` with UFs or quantifiers, ``ucopt`` with quantifiers).
+  Passes ``elimapplies`` and ``ackermann`` are required by the solver engines,
+  they are appended if omitted and their limits are ignored.
+  Variable substitution (``varsubst``) and embedded constraints processing
+  (``embedded``) are always run first and can not be configured.
+
+  :param btor: Boolector instance.
+  :param pipeline: The preprocessing pipeline.
+
+  .. seealso::
+    boolector_get_simp_pass_stats
+*/
+void boolector_set_simp_pipeline (Btor *btor, const char *pipeline);
+
 /*------------------------------------------------------------------------*/
 
 /*!
@@ -0,0 +1,153 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btoraigsim.h"
+#include "btorcore.h"
+#include "utils/btorstack.h"
+
+/*------------------------------------------------------------------------*/
+
+BtorAIGSim *
+btor_aigsim_new (BtorAIGMgr *amgr)
+{
+  assert (amgr);
+
+  BtorAIGSim *res;
+  BtorMemMgr *mm;
+
+  mm = amgr->btor->mm;
+  BTOR_CNEW (mm, res);
+  res->amgr = amgr;
+  res->cone = btor_hashint_table_new (mm);
+  BTOR_INIT_STACK (mm, res->ands);
+  BTOR_INIT_STACK (mm, res->vars);
+  res->sorted = true;
+  return res;
+}
+
+void
+btor_aigsim_delete (BtorAIGSim *sim)
+{
+  assert (sim);
+
+  BtorMemMgr *mm;
+
+  mm = sim->amgr->btor->mm;
+  btor_hashint_table_delete (sim->cone);
+  BTOR_RELEASE_STACK (sim->ands);
+  BTOR_RELEASE_STACK (sim->vars);
+  if (sim->values) BTOR_DELETEN (mm, sim->values, sim->size);
+  BTOR_DELETE (mm, sim);
+}
+
+void
+btor_aigsim_add_root (BtorAIGSim *sim, BtorAIG *aig)
+{
+  assert (sim);
+  assert (aig);
+
+  uint32_t size;
+  BtorAIG *cur, *left, *right;
+  BtorAIGPtrStack stack;
+  BtorMemMgr *mm;
+
+  if (btor_aig_is_const (aig)) return;
+
+  mm = sim->amgr->btor->mm;
+
+  size = BTOR_COUNT_STACK (sim->amgr->id2aig);
+  if (size > sim->size)
+  {
+    BTOR_REALLOC (mm, sim->values, sim->size, size);
+    BTOR_CLRN (sim->values + sim->size, size - sim->size);
+    sim->size = size;
+  }
+
+  BTOR_INIT_STACK (mm, stack);
+  BTOR_PUSH_STACK (stack, BTOR_REAL_ADDR_AIG (aig));
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_POP_STACK (stack);
+    assert (BTOR_IS_REGULAR_AIG (cur));
+    assert ((uint32_t) cur->id < sim->size);
+
+    if (btor_hashint_table_contains (sim->cone, cur->id)) continue;
+    btor_hashint_table_add (sim->cone, cur->id);
+
+    if (btor_aig_is_var (cur))
+    {
+      BTOR_PUSH_STACK (sim->vars, cur);
+      continue;
+    }
+
+    assert (btor_aig_is_and (cur));
+    if (!BTOR_EMPTY_STACK (sim->ands) && BTOR_TOP_STACK (sim->ands)->id > cur->id)
+      sim->sorted = false;
+    BTOR_PUSH_STACK (sim->ands, cur);
+    left  = btor_aig_get_left_child (sim->amgr, cur);
+    right = btor_aig_get_right_child (sim->amgr, cur);
+    if (!btor_aig_is_const (left))
+      BTOR_PUSH_STACK (stack, BTOR_REAL_ADDR_AIG (left));
+    if (!btor_aig_is_const (right))
+      BTOR_PUSH_STACK (stack, BTOR_REAL_ADDR_AIG (right));
+  }
+  BTOR_RELEASE_STACK (stack);
+}
+
+void
+btor_aigsim_set_var (BtorAIGSim *sim, BtorAIG *var, uint64_t value)
+{
+  assert (sim);
+  assert (btor_aig_is_var (var));
+  assert (btor_hashint_table_contains (sim->cone, var->id));
+
+  sim->values[var->id] = value;
+}
+
+uint64_t
+btor_aigsim_get (BtorAIGSim *sim, BtorAIG *aig)
+{
+  assert (sim);
+
+  uint64_t res;
+
+  if (btor_aig_is_true (aig)) return ~(uint64_t) 0;
+  if (btor_aig_is_false (aig)) return 0;
+
+  assert (btor_hashint_table_contains (sim->cone, BTOR_REAL_ADDR_AIG (aig)->id));
+  res = sim->values[BTOR_REAL_ADDR_AIG (aig)->id];
+  return BTOR_IS_INVERTED_AIG (aig) ? ~res : res;
+}
+
+void
+btor_aigsim_simulate (BtorAIGSim *sim)
+{
+  assert (sim);
+
+  uint32_t i;
+  BtorAIG *cur;
+
+  /* AIG ids are assigned on construction, i.e., children have smaller ids
+   * than their parents */
+  if (!sim->sorted)
+  {
+    qsort (sim->ands.start,
+           BTOR_COUNT_STACK (sim->ands),
+           sizeof (BtorAIG *),
+           btor_compare_aig_by_id_qsort_asc);
+    sim->sorted = true;
+  }
+
+  for (i = 0; i < BTOR_COUNT_STACK (sim->ands); i++)
+  {
+    cur = BTOR_PEEK_STACK (sim->ands, i);
+    sim->values[cur->id] =
+        btor_aigsim_get (sim, btor_aig_get_left_child (sim->amgr, cur))
+        & btor_aigsim_get (sim, btor_aig_get_right_child (sim->amgr, cur));
+  }
+}
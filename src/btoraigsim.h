@@ -0,0 +1,53 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORAIGSIM_H_INCLUDED
+#define BTORAIGSIM_H_INCLUDED
+
+#include "btoraig.h"
+#include "utils/btorhashint.h"
+#include "utils/btormem.h"
+
+/*------------------------------------------------------------------------*/
+
+/* Bit-parallel AIG simulator.
+ *
+ * Simulates the cone of a set of root AIGs on 64 assignments at once, where
+ * bit i of the value of an AIG represents its value under assignment i. */
+
+#define BTOR_AIGSIM_NLANES 64
+
+struct BtorAIGSim
+{
+  BtorAIGMgr *amgr;
+  BtorIntHashTable *cone; /* AIGs (ids) in the cone of the roots */
+  BtorAIGPtrStack ands;   /* AND AIGs in the cone, ordered by id */
+  BtorAIGPtrStack vars;   /* AIG variables in the cone */
+  bool sorted;            /* 'ands' ordered by id? */
+  uint64_t *values;       /* simulation values (indexed by AIG id) */
+  uint32_t size;          /* size of 'values' */
+};
+
+typedef struct BtorAIGSim BtorAIGSim;
+
+BtorAIGSim *btor_aigsim_new (BtorAIGMgr *amgr);
+void btor_aigsim_delete (BtorAIGSim *sim);
+
+/* Add the cone of 'aig' to the set of simulated AIGs. */
+void btor_aigsim_add_root (BtorAIGSim *sim, BtorAIG *aig);
+
+/* Set the simulation value of AIG variable 'var' (all lanes). */
+void btor_aigsim_set_var (BtorAIGSim *sim, BtorAIG *var, uint64_t value);
+
+/* Get the simulation value of 'aig' (all lanes), 'aig' may be inverted. */
+uint64_t btor_aigsim_get (BtorAIGSim *sim, BtorAIG *aig);
+
+/* Compute the values of all AND AIGs in the cone of the roots. */
+void btor_aigsim_simulate (BtorAIGSim *sim);
+
+#endif
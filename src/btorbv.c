@@ -227,6 +227,69 @@ btor_bv_new_random_bit_range (
   return res;
 }
 
+uint64_t
+btor_bv_random_uint64 (BtorMemMgr *mm, BtorRNG *rng, uint32_t bw)
+{
+  assert (mm);
+  assert (rng);
+  assert (bw > 0);
+  assert (bw <= 64);
+
+  uint64_t res;
+
+#ifdef BTOR_USE_GMP
+  BtorBitVector *bv;
+  bv  = btor_bv_new_random (mm, rng, bw);
+  res = btor_bv_to_uint64 (bv);
+  btor_bv_free (mm, bv);
+#else
+  /* same as btor_bv_new_random_bit_range (mm, rng, bw, bw - 1, 0) */
+  uint32_t len;
+  BTOR_BV_TYPE lsw, msw;
+
+  (void) mm;
+  len = bw / BTOR_BV_TYPE_BW + (bw % BTOR_BV_TYPE_BW ? 1 : 0);
+  lsw = len > 1 ? (BTOR_BV_TYPE) btor_rng_rand (rng) : 0;
+  msw = (BTOR_BV_TYPE) btor_rng_pick_rand (
+      rng, 0, ((~0) >> (BTOR_BV_TYPE_BW - bw % BTOR_BV_TYPE_BW)) - 1);
+  res = len > 1 ? ((uint64_t) msw << BTOR_BV_TYPE_BW) | lsw : msw;
+  if (bw < 64) res &= (((uint64_t) 1) << bw) - 1;
+#endif
+  return res;
+}
+
+uint64_t
+btor_bv_random_range_uint64 (
+    BtorMemMgr *mm, BtorRNG *rng, uint32_t bw, uint64_t from, uint64_t to)
+{
+  assert (mm);
+  assert (rng);
+  assert (bw > 0);
+  assert (bw <= 64);
+  assert (from <= to);
+
+  uint64_t res;
+
+#ifdef BTOR_USE_GMP
+  BtorBitVector *bvfrom, *bvto, *bv;
+  bvfrom = btor_bv_uint64_to_bv (mm, from, bw);
+  bvto   = btor_bv_uint64_to_bv (mm, to, bw);
+  bv     = btor_bv_new_random_range (mm, rng, bw, bvfrom, bvto);
+  res    = btor_bv_to_uint64 (bv);
+  btor_bv_free (mm, bv);
+  btor_bv_free (mm, bvto);
+  btor_bv_free (mm, bvfrom);
+#else
+  uint64_t n;
+
+  res = btor_bv_random_uint64 (mm, rng, bw);
+  /* n = to + 1 - from, overflows (n = 0) only for the full 64-bit range */
+  n = to - from + 1;
+  if (n) res = res % n + from;
+#endif
+  return res;
+}
+
 /*------------------------------------------------------------------------*/
 
 BtorBitVector *
@@ -43,6 +43,20 @@ BtorBitVector *btor_bv_new_random_range (BtorMemMgr *mm,
 BtorBitVector *btor_bv_new_random_bit_range (
     BtorMemMgr *mm, BtorRNG *rng, uint32_t bw, uint32_t up, uint32_t lo);
 
+/**
+ * Get a random value of given bit-width (<= 64) as unsigned integer.
+ * Draws the same random numbers as btor_bv_new_random.
+ */
+uint64_t btor_bv_random_uint64 (BtorMemMgr *mm, BtorRNG *rng, uint32_t bw);
+
+/**
+ * Get a random value of given bit-width (<= 64) within the given value range
+ * as unsigned integer.
+ * Draws the same random numbers as btor_bv_new_random_range.
+ */
+uint64_t btor_bv_random_range_uint64 (
+    BtorMemMgr *mm, BtorRNG *rng, uint32_t bw, uint64_t from, uint64_t to);
+
 /**
  * Create bit-vector from given binary string.
  * The bit-width of the resulting bit-vector is the length of the given string.
@@ -227,6 +227,7 @@ chkclone_stats (Btor *btor, Btor *clone)
   assert (btor);
   assert (clone);
 
+  uint32_t i;
 #ifndef NDEBUG
   BtorPtrHashTableIterator it, cit;
   BtorHashTableData *data, *cdata;
@@ -239,15 +240,36 @@ chkclone_stats (Btor *btor, Btor *clone)
   BTOR_CHKCLONE_STATS (ec_substitutions);
   BTOR_CHKCLONE_STATS (linear_equations);
   BTOR_CHKCLONE_STATS (gaussian_eliminations);
+  BTOR_CHKCLONE_STATS (linear_vars_eliminated);
+  BTOR_CHKCLONE_STATS (known_bits_consts);
+  BTOR_CHKCLONE_STATS (known_bits_cmps);
+  BTOR_CHKCLONE_STATS (known_bits_slices);
+  BTOR_CHKCLONE_STATS (known_bits_conds);
+  BTOR_CHKCLONE_STATS (symmetry_classes);
+  BTOR_CHKCLONE_STATS (symmetry_constraints);
+  BTOR_CHKCLONE_STATS (simplified_exps);
+  for (i = 0; i < BTOR_SIMP_PASS_NUM; i++)
+  {
+    BTOR_CHKCLONE_STATS (simp_passes[i].runs);
+    BTOR_CHKCLONE_STATS (simp_passes[i].inconsistent);
+    BTOR_CHKCLONE_STATS (simp_passes[i].nodes_before);
+    BTOR_CHKCLONE_STATS (simp_passes[i].nodes_after);
+    BTOR_CHKCLONE_STATS (simp_passes[i].substitutions);
+  }
   BTOR_CHKCLONE_STATS (eliminated_slices);
   BTOR_CHKCLONE_STATS (skeleton_constraints);
+  BTOR_CHKCLONE_STATS (extracted_set_2d);
+  BTOR_CHKCLONE_STATS (extracted_affine);
   BTOR_CHKCLONE_STATS (adds_normalized);
   BTOR_CHKCLONE_STATS (ands_normalized);
   BTOR_CHKCLONE_STATS (muls_normalized);
   BTOR_CHKCLONE_STATS (muls_normalized);
   BTOR_CHKCLONE_STATS (ackermann_constraints);
+  BTOR_CHKCLONE_STATS (ackermann_pairs_skipped);
+  BTOR_CHKCLONE_STATS (simplify_skipped);
   BTOR_CHKCLONE_STATS (bv_uc_props);
   BTOR_CHKCLONE_STATS (fun_uc_props);
+  BTOR_CHKCLONE_STATS (uc_reinstated);
   BTOR_CHKCLONE_STATS (lambdas_merged);
   BTOR_CHKCLONE_STATS (expressions);
   BTOR_CHKCLONE_STATS (clone_calls);
@@ -1073,6 +1095,9 @@ chkclone_slv (Btor *btor, Btor *clone)
       assert (!cslv->score);
     }
 
+    chkclone_int_hash_table (slv->score_cache, cslv->score_cache);
+    chkclone_int_hash_table (slv->score_cache_dp, cslv->score_cache_dp);
+
     assert (BTOR_COUNT_STACK (slv->stats.lemmas_size)
             == BTOR_COUNT_STACK (cslv->stats.lemmas_size));
     for (i = 0; i < BTOR_COUNT_STACK (slv->stats.lemmas_size); i++)
@@ -1210,6 +1210,9 @@ clone_aux_btor (Btor *btor,
       btor_hashint_table_clone (clone->mm, btor->assertions_cache);
   assert ((allocated += MEM_INT_HASH_TABLE (btor->assertions_cache))
           == clone->mm->allocated);
+  clone->ack_cache = btor_hashint_table_clone (clone->mm, btor->ack_cache);
+  assert ((allocated += MEM_INT_HASH_TABLE (btor->ack_cache))
+          == clone->mm->allocated);
 
   btor_clone_node_ptr_stack (
       mm, &btor->assertions, &clone->assertions, emap, false);
@@ -1226,6 +1229,17 @@ clone_aux_btor (Btor *btor,
            BTOR_SIZE_STACK (btor->assertions_trail) * sizeof (uint32_t))
           == clone->mm->allocated);
 
+  btor_clone_node_ptr_stack (
+      mm, &btor->uc_terms, &clone->uc_terms, emap, false);
+  assert ((allocated += BTOR_SIZE_STACK (btor->uc_terms) * sizeof (BtorNode *))
+          == clone->mm->allocated);
+  BTOR_INIT_STACK (clone->mm, clone->uc_info);
+  for (i = 0; i < BTOR_COUNT_STACK (btor->uc_info); i++)
+    BTOR_PUSH_STACK (clone->uc_info, BTOR_PEEK_STACK (btor->uc_info, i));
+  BTOR_ADJUST_STACK (btor->uc_info, clone->uc_info);
+  assert ((allocated += BTOR_SIZE_STACK (btor->uc_info) * sizeof (uint32_t))
+          == clone->mm->allocated);
+
   if (btor->bv_model)
   {
     clone->bv_model = btor_model_clone_bv (clone, btor->bv_model, false);
@@ -1449,6 +1463,18 @@ clone_aux_btor (Btor *btor,
         }
       }
 
+      if (slv->score_cache)
+      {
+        CHKCLONE_MEM_INT_HASH_TABLE (slv->score_cache, cslv->score_cache);
+        allocated += MEM_INT_HASH_TABLE (slv->score_cache);
+      }
+      if (slv->score_cache_dp)
+      {
+        CHKCLONE_MEM_INT_HASH_TABLE (slv->score_cache_dp,
+                                     cslv->score_cache_dp);
+        allocated += MEM_INT_HASH_TABLE (slv->score_cache_dp);
+      }
+
       assert (BTOR_SIZE_STACK (slv->stats.lemmas_size)
               == BTOR_SIZE_STACK (cslv->stats.lemmas_size));
       assert (BTOR_COUNT_STACK (slv->stats.lemmas_size)
@@ -1862,8 +1888,11 @@ btor_clone_recursively_rebuild_exp (Btor *btor,
         case BTOR_FORALL_NODE:
           cur_clone = btor_exp_forall (clone, e[0], e[1]);
           break;
+        case BTOR_UPDATE_NODE:
+          cur_clone = btor_exp_update (clone, e[0], e[1], e[2]);
+          break;
         default:
-          assert (btor_node_is_bv_cond (cur));
+          assert (btor_node_is_cond (cur));
           cur_clone = btor_exp_cond (clone, e[0], e[1], e[2]);
       }
       btor_nodemap_map (exp_map, cur, cur_clone);
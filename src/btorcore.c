@@ -30,6 +30,7 @@
 #include "btorslvsls.h"
 #include "btorsubst.h"
 #include "preprocess/btorpreprocess.h"
+#include "preprocess/btorunconstrained.h"
 #include "preprocess/btorvarsubst.h"
 #include "utils/btorhashint.h"
 #include "utils/btornodeiter.h"
@@ -380,8 +381,8 @@ report_constraint_stats (Btor *btor, bool force)
 }
 
 /* we do not count proxies */
-static uint32_t
-number_of_ops (Btor *btor)
+uint32_t
+btor_number_of_ops (Btor *btor)
 {
   int32_t i, result;
   assert (btor);
@@ -405,6 +406,7 @@ btor_print_stats (Btor *btor)
 {
   uint32_t i, num_final_ops;
   uint32_t verbosity;
+  BtorSimpPassStats *pass;
 
   if (!btor) return;
 
@@ -422,7 +424,7 @@ btor_print_stats (Btor *btor)
               2,
               "%5lld number of expressions ever created",
               btor->stats.expressions);
-    num_final_ops = number_of_ops (btor);
+    num_final_ops = btor_number_of_ops (btor);
     BTOR_MSG (btor->msg, 2, "%5d number of final expressions", num_final_ops);
     assert (sizeof g_btor_op2str / sizeof *g_btor_op2str == BTOR_NUM_OPS_NODE);
 
@@ -454,6 +456,10 @@ btor_print_stats (Btor *btor)
               1,
               "%5d unconstrained parameterized props",
               btor->stats.param_uc_props);
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d unconstrained terms reinstated",
+              btor->stats.uc_reinstated);
   }
   BTOR_MSG (btor->msg,
             1,
@@ -480,6 +486,34 @@ btor_print_stats (Btor *btor)
             1,
             "%5d gaussian eliminations in linear equations",
             btor->stats.gaussian_eliminations);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5d variables eliminated by solving linear systems",
+            btor->stats.linear_vars_eliminated);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5d nodes replaced by constants based on known bits",
+            btor->stats.known_bits_consts);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5d comparisons narrowed based on known bits",
+            btor->stats.known_bits_cmps);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5d slices narrowed based on known bits",
+            btor->stats.known_bits_slices);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5d ite branches dropped based on known bits",
+            btor->stats.known_bits_conds);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5d classes of symmetric variables",
+            btor->stats.symmetry_classes);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5d symmetry breaking constraints",
+            btor->stats.symmetry_constraints);
   BTOR_MSG (btor->msg,
             1,
             "%5d eliminated sliced variables",
@@ -488,6 +522,27 @@ btor_print_stats (Btor *btor)
             1,
             "%5d extracted skeleton constraints",
             btor->stats.skeleton_constraints);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5d extracted 2-dimensional memset patterns",
+            btor->stats.extracted_set_2d);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5d extracted affine value patterns",
+            btor->stats.extracted_affine);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5d ackermann constraints",
+            btor->stats.ackermann_constraints);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5lld ackermann pairs with distinct arguments skipped",
+            btor->stats.ackermann_pairs_skipped);
+  if (btor_opt_get (btor, BTOR_OPT_INCREMENTAL))
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d skipped simplifications",
+              btor->stats.simplify_skipped);
   BTOR_MSG (
       btor->msg, 1, "%5d and normalizations", btor->stats.ands_normalized);
   BTOR_MSG (
@@ -540,6 +595,25 @@ btor_print_stats (Btor *btor)
   }
 #endif
 
+  BTOR_MSG (btor->msg, 1, "");
+  BTOR_MSG (btor->msg, 1, "preprocessing pass statistics:");
+  for (i = 0; i < BTOR_SIMP_PASS_NUM; i++)
+  {
+    pass = &btor->stats.simp_passes[i];
+    if (!pass->runs) continue;
+    BTOR_MSG (btor->msg,
+              1,
+              "  %-11s %5u runs %8.2f seconds %8lld -> %8lld nodes "
+              "%7lld substitutions %u inconsistent",
+              g_btor_simp_pass_names[i],
+              pass->runs,
+              btor->time.simp_passes[i],
+              pass->nodes_before,
+              pass->nodes_after,
+              pass->substitutions,
+              pass->inconsistent);
+  }
+
   BTOR_MSG (btor->msg, 1, "");
   BTOR_MSG (btor->msg, 1, "bit blasting statistics:");
   BTOR_MSG (btor->msg,
@@ -617,13 +691,12 @@ btor_print_stats (Btor *btor)
               btor->time.slicing,
               percent (btor->time.slicing, btor->time.simplify));
 
-#ifndef BTOR_DO_NOT_PROCESS_SKELETON
-  BTOR_MSG (btor->msg,
-            1,
-            "    %.2f seconds skeleton preprocessing (%.0f%%)",
-            btor->time.skel,
-            percent (btor->time.skel, btor->time.simplify));
-#endif
+  if (btor_opt_get (btor, BTOR_OPT_SKELETON_PREPROC))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds skeleton preprocessing (%.0f%%)",
+              btor->time.skel,
+              percent (btor->time.skel, btor->time.simplify));
 
   if (btor_opt_get (btor, BTOR_OPT_UCOPT))
     BTOR_MSG (btor->msg,
@@ -659,6 +732,34 @@ btor_print_stats (Btor *btor)
               btor->time.ack,
               percent (btor->time.ack, btor->time.simplify));
 
+  if (btor_opt_get (btor, BTOR_OPT_SIMP_NORMAMLIZE_ADDERS))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds adder normalization (%.0f%%)",
+              btor->time.normadd,
+              percent (btor->time.normadd, btor->time.simplify));
+
+  if (btor_opt_get (btor, BTOR_OPT_SIMP_LINEAR_SYSTEMS))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds linear system solving (%.0f%%)",
+              btor->time.linear,
+              percent (btor->time.linear, btor->time.simplify));
+
+  if (btor_opt_get (btor, BTOR_OPT_SIMP_KNOWN_BITS))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds known bits propagation (%.0f%%)",
+              btor->time.known_bits,
+              percent (btor->time.known_bits, btor->time.simplify));
+
+  if (btor_opt_get (btor, BTOR_OPT_SIMP_SYMMETRY))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds symmetry breaking (%.0f%%)",
+              btor->time.symmetry,
+              percent (btor->time.symmetry, btor->time.simplify));
+
   if (btor->slv) btor->slv->api.print_time_stats (btor->slv);
 #endif
 
@@ -765,6 +866,8 @@ btor_new (void)
 
   BTOR_INIT_STACK (mm, btor->assertions);
   BTOR_INIT_STACK (mm, btor->assertions_trail);
+  BTOR_INIT_STACK (mm, btor->uc_terms);
+  BTOR_INIT_STACK (mm, btor->uc_info);
   btor->assertions_cache = btor_hashint_table_new (mm);
 
 #ifndef NDEBUG
@@ -941,7 +1044,12 @@ btor_delete (Btor *btor)
     btor_node_release (btor, BTOR_PEEK_STACK (btor->assertions, i));
   BTOR_RELEASE_STACK (btor->assertions);
   BTOR_RELEASE_STACK (btor->assertions_trail);
+  for (i = 0; i < BTOR_COUNT_STACK (btor->uc_terms); i++)
+    btor_node_release (btor, BTOR_PEEK_STACK (btor->uc_terms, i));
+  BTOR_RELEASE_STACK (btor->uc_terms);
+  BTOR_RELEASE_STACK (btor->uc_info);
   btor_hashint_table_delete (btor->assertions_cache);
+  if (btor->ack_cache) btor_hashint_table_delete (btor->ack_cache);
 
   btor_model_delete (btor);
   btor_node_release (btor, btor->true_exp);
@@ -2144,6 +2252,7 @@ btor_set_simplified_exp (Btor *btor, BtorNode *exp, BtorNode *simplified)
    * synthesized nodes are rewritten, it can significantly slow-down the
    * solver. */
   if (btor_node_is_synth (exp)) btor->stats.rewrite_synth++;
+  btor->stats.simplified_exps++;
 
   if (exp->simplified) btor_node_release (btor, exp->simplified);
 
@@ -3050,6 +3159,8 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
         btor->slv->api.generate_model (
             btor->slv, btor_opt_get (btor, BTOR_OPT_MODEL_GEN) == 2, true);
     }
+    btor_reconstruct_unconstrained_model (
+        btor, btor->bv_model, btor->fun_model);
   }
 
 #ifndef NDEBUG
@@ -3066,7 +3177,9 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 
   if (chkmodel)
   {
-    if (res == BTOR_RESULT_SAT && !btor_opt_get (btor, BTOR_OPT_UCOPT))
+    if (res == BTOR_RESULT_SAT
+        && (!btor_opt_get (btor, BTOR_OPT_UCOPT)
+            || btor_opt_get (btor, BTOR_OPT_MODEL_GEN)))
     {
       btor_check_model (chkmodel);
     }
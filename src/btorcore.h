@@ -26,10 +26,6 @@
 
 /*------------------------------------------------------------------------*/
 
-#ifndef BTOR_USE_LINGELING
-#define BTOR_DO_NOT_PROCESS_SKELETON
-#endif
-
 // Currently, 'BoolectorNode' (external) vs. 'BtorNode' (internal)
 // syntactically hides internal nodes.  Hence, we assume that both structs
 // 'BoolectorNode' and 'BtorNode' have/ the same structure and provide the
@@ -84,6 +80,38 @@ struct BtorConstraintStats
 
 typedef struct BtorConstraintStats BtorConstraintStats;
 
+/* Preprocessing passes run by btor_simplify (see g_btor_simp_pass_names). */
+enum BtorSimpPass
+{
+  BTOR_SIMP_PASS_VAR_SUBST,
+  BTOR_SIMP_PASS_EMBEDDED,
+  BTOR_SIMP_PASS_ELIM_SLICES,
+  BTOR_SIMP_PASS_SKELETON,
+  BTOR_SIMP_PASS_LINEAR,
+  BTOR_SIMP_PASS_KNOWN_BITS,
+  BTOR_SIMP_PASS_SYMMETRY,
+  BTOR_SIMP_PASS_UCOPT,
+  BTOR_SIMP_PASS_EXTRACT,
+  BTOR_SIMP_PASS_MERGE,
+  BTOR_SIMP_PASS_ELIM_APPLIES,
+  BTOR_SIMP_PASS_ACKERMANN,
+  BTOR_SIMP_PASS_NORMADD,
+  BTOR_SIMP_PASS_NUM
+};
+
+typedef enum BtorSimpPass BtorSimpPass;
+
+struct BtorSimpPassStats
+{
+  uint32_t runs;                /* number of runs */
+  uint32_t inconsistent;        /* runs that detected an inconsistency */
+  uint_least64_t nodes_before;  /* sum of the number of nodes before a run */
+  uint_least64_t nodes_after;   /* sum of the number of nodes after a run */
+  uint_least64_t substitutions; /* number of simplified nodes */
+};
+
+typedef struct BtorSimpPassStats BtorSimpPassStats;
+
 struct Btor
 {
   BtorMemMgr *mm;
@@ -134,6 +162,16 @@ struct Btor
   uint32_t btor_sat_btor_called; /* how often is btor_check_sat been called */
   BtorSolverResult last_sat_result; /* status of last SAT call (SAT/UNSAT) */
 
+  /* nodes with id >= simp_frontier have been created since the last call
+   * to btor_simplify (incremental preprocessing) */
+  uint32_t simp_frontier;
+  /* nodes already considered for ackermann constraints (incremental) */
+  BtorIntHashTable *ack_cache;
+  /* unconstrained terms eliminated in incremental mode or with model
+   * generation enabled (see btorunconstrained.c) */
+  BtorNodePtrStack uc_terms;
+  BtorUIntStack uc_info;
+
   BtorPtrHashTable *varsubst_constraints;
   BtorPtrHashTable *embedded_constraints;
   BtorPtrHashTable *unsynthesized_constraints;
@@ -185,17 +223,30 @@ struct Btor
     uint32_t ec_substitutions;  /* embedded constraint substitutions */
     uint32_t linear_equations;  /* number of linear equations */
     uint32_t gaussian_eliminations; /* number of gaussian eliminations */
+    uint32_t linear_vars_eliminated; /* vars eliminated by linear systems */
+    uint32_t known_bits_consts; /* nodes with known bits replaced by consts */
+    uint32_t known_bits_cmps;   /* comparisons narrowed by known bits */
+    uint32_t known_bits_slices; /* slices narrowed by known bits */
+    uint32_t known_bits_conds;  /* ites with known condition eliminated */
+    uint32_t symmetry_classes;     /* classes of symmetric variables */
+    uint32_t symmetry_constraints; /* symmetry breaking constraints */
     uint32_t eliminated_slices;     /* number of eliminated slices */
     uint32_t skeleton_constraints;  /* number of skeleton constraints */
+    uint32_t extracted_set_2d;      /* extracted 2-dimensional memsets */
+    uint32_t extracted_affine;      /* extracted affine value patterns */
     uint32_t adds_normalized;       /* number of add chains normalizations */
     uint32_t ands_normalized;       /* number of and chains normalizations */
     uint32_t muls_normalized;       /* number of mul chains normalizations */
     uint32_t ackermann_constraints;
+    uint_least64_t ackermann_pairs_skipped; /* pairs with distinct args */
+    uint32_t simplify_skipped; /* calls to btor_simplify without new
+                                  constraints (incremental) */
     uint_least64_t prop_apply_lambda; /* number of static props over lambdas */
     uint_least64_t prop_apply_update; /* number of static props over updates */
     uint32_t bv_uc_props;
     uint32_t fun_uc_props;
     uint32_t param_uc_props;
+    uint32_t uc_reinstated; /* number of reinstated unconstrained terms */
     uint_least64_t lambdas_merged;
     BtorConstraintStats constraints;
     BtorConstraintStats oldconstraints;
@@ -208,6 +259,8 @@ struct Btor
     BtorPtrHashTable *rw_rules_applied;
 #endif
     uint_least64_t rewrite_synth;
+    uint_least64_t simplified_exps; /* calls to btor_set_simplified_exp */
+    BtorSimpPassStats simp_passes[BTOR_SIMP_PASS_NUM];
   } stats;
 
   struct
@@ -220,6 +273,10 @@ struct Btor
     double embedded;
     double slicing;
     double skel;
+    double normadd;
+    double linear;
+    double known_bits;
+    double symmetry;
     double propagate;
     double beta;
     double betap;
@@ -233,6 +290,7 @@ struct Btor
     double ack;
     double rewrite;
     double occurrence;
+    double simp_passes[BTOR_SIMP_PASS_NUM];
   } time;
 };
 
@@ -260,6 +318,9 @@ void btor_set_msg_prefix (Btor *btor, const char *prefix);
 /* Prints statistics. */
 void btor_print_stats (Btor *btor);
 
+/* Returns the number of nodes (without proxies). */
+uint32_t btor_number_of_ops (Btor *btor);
+
 /* Reset time statistics. */
 void btor_reset_time (Btor *btor);
 
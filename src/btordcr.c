@@ -55,6 +55,14 @@ compute_scores_aux_min_dep (Btor *btor, BtorNodePtrStack *nodes)
       if (!d)
       {
         d = btor_hashint_map_add (mark, cur->id);
+
+        /* score of 'cur' has already been computed in a previous call */
+        if ((b = btor_hashptr_table_get (score, cur)) && b->data.as_int > 0)
+        {
+          d->as_int = 1;
+          continue;
+        }
+
         BTOR_PUSH_STACK (stack, cur);
 
         if (cur->arity == 0)
@@ -232,7 +240,7 @@ btor_dcr_compute_scores (Btor *btor)
   BtorNode *cur, *e;
   BtorPtrHashTableIterator it;
   BtorNodePtrStack stack, nodes;
-  BtorIntHashTable *mark;
+  BtorIntHashTable *cache;
   BtorMemMgr *mm;
 
   /* computing scores only required for BTOR_JUST_HEUR_BRANCH_MIN_DEP and
@@ -245,13 +253,16 @@ btor_dcr_compute_scores (Btor *btor)
    * only need the children of AND nodes. If dual prop is enabled, we only need
    * APPLY nodes (BV var nodes always have score 0 or 1 depending on the
    * selected heuristic and are treated as such in compare_scores).
-   * -> see btor_dcr_compute_scores_dual_prop */
+   * -> see btor_dcr_compute_scores_dual_prop
+   *
+   * Scores only depend on the cone of a node, hence nodes visited in previous
+   * calls are cached and only the cones of new constraints (e.g., lemmas
+   * added in the last refinement iteration) are traversed. */
 
   start = btor_util_time_stamp ();
   mm    = btor->mm;
   BTOR_INIT_STACK (mm, stack);
   BTOR_INIT_STACK (mm, nodes);
-  mark = btor_hashint_table_new (mm);
 
   slv = BTOR_FUN_SOLVER (btor);
 
@@ -259,6 +270,8 @@ btor_dcr_compute_scores (Btor *btor)
     slv->score = btor_hashptr_table_new (mm,
                                          (BtorHashPtr) btor_node_hash_by_id,
                                          (BtorCmpPtr) btor_node_compare_by_id);
+  if (!slv->score_cache) slv->score_cache = btor_hashint_table_new (mm);
+  cache = slv->score_cache;
 
   btor_iter_hashptr_init (&it, btor->synthesized_constraints);
   btor_iter_hashptr_queue (&it, btor->assumptions);
@@ -269,8 +282,8 @@ btor_dcr_compute_scores (Btor *btor)
     while (!BTOR_EMPTY_STACK (stack))
     {
       cur = btor_node_real_addr (BTOR_POP_STACK (stack));
-      if (btor_hashint_table_contains (mark, cur->id)) continue;
-      btor_hashint_table_add (mark, cur->id);
+      if (btor_hashint_table_contains (cache, cur->id)) continue;
+      btor_hashint_table_add (cache, cur->id);
       for (i = 0; i < cur->arity; i++)
       {
         e = btor_node_real_addr (cur->e[i]);
@@ -287,7 +300,6 @@ btor_dcr_compute_scores (Btor *btor)
   }
 
   BTOR_RELEASE_STACK (stack);
-  btor_hashint_table_delete (mark);
 
   compute_scores_aux (btor, &nodes);
 
@@ -307,7 +319,7 @@ btor_dcr_compute_scores_dual_prop (Btor *btor)
   BtorNode *cur;
   BtorNodePtrStack stack, nodes;
   BtorPtrHashTableIterator it;
-  BtorIntHashTable *mark;
+  BtorIntHashTable *cache;
   BtorMemMgr *mm;
 
   /* computing scores only required for BTOR_JUST_HEUR_BRANCH_MIN_DEP and
@@ -319,7 +331,6 @@ btor_dcr_compute_scores_dual_prop (Btor *btor)
   start = btor_util_time_stamp ();
   mm    = btor->mm;
   BTOR_INIT_STACK (mm, stack);
-  mark = btor_hashint_table_new (mm);
 
   slv = BTOR_FUN_SOLVER (btor);
 
@@ -335,6 +346,12 @@ btor_dcr_compute_scores_dual_prop (Btor *btor)
     slv->score = btor_hashptr_table_new (mm,
                                          (BtorHashPtr) btor_node_hash_by_id,
                                          (BtorCmpPtr) btor_node_compare_by_id);
+  /* the traversal stops at applies and function equalities, hence the
+   * nodes visited here differ from btor_dcr_compute_scores, which may be
+   * called on the same solver (e.g., after disabling dual prop) */
+  if (!slv->score_cache_dp)
+    slv->score_cache_dp = btor_hashint_table_new (mm);
+  cache = slv->score_cache_dp;
 
   /* collect applies in bv skeleton */
   btor_iter_hashptr_init (&it, btor->synthesized_constraints);
@@ -346,8 +363,8 @@ btor_dcr_compute_scores_dual_prop (Btor *btor)
     while (!BTOR_EMPTY_STACK (stack))
     {
       cur = btor_node_real_addr (BTOR_POP_STACK (stack));
-      if (btor_hashint_table_contains (mark, cur->id)) continue;
-      btor_hashint_table_add (mark, cur->id);
+      if (btor_hashint_table_contains (cache, cur->id)) continue;
+      btor_hashint_table_add (cache, cur->id);
 
       if (btor_node_is_apply (cur) || btor_node_is_fun_eq (cur))
       {
@@ -366,7 +383,6 @@ btor_dcr_compute_scores_dual_prop (Btor *btor)
   }
 
   BTOR_RELEASE_STACK (stack);
-  btor_hashint_table_delete (mark);
 
   /* compute scores from applies downwards */
   compute_scores_aux (btor, &nodes);
@@ -9,6 +9,7 @@
 #include "btorlsutils.h"
 
 #include "btorbv.h"
+#include "btorclone.h"
 #include "btorlog.h"
 #include "btormodel.h"
 #include "btornode.h"
@@ -65,6 +66,191 @@ update_roots_table (Btor *btor,
   }
 }
 
+/*------------------------------------------------------------------------*/
+
+/* Maximum number of nodes held in cached cones. */
+#define BTOR_LSUTILS_CONE_INDEX_MAX_CACHED (1u << 22)
+
+BtorLsConeIndex *
+btor_lsutils_new_cone_index (Btor *btor)
+{
+  assert (btor);
+
+  BtorLsConeIndex *res;
+
+  BTOR_CNEW (btor->mm, res);
+  res->mm    = btor->mm;
+  res->size  = BTOR_COUNT_STACK (btor->nodes_id_table);
+  res->epoch = 0;
+  BTOR_CNEWN (btor->mm, res->mark, res->size);
+  BTOR_CNEWN (btor->mm, res->changed, res->size);
+  res->cones = btor_hashint_map_new (btor->mm);
+  BTOR_INIT_STACK (btor->mm, res->cone);
+  BTOR_INIT_STACK (btor->mm, res->cone_exps);
+  return res;
+}
+
+void
+btor_lsutils_delete_cone_index (BtorLsConeIndex *index)
+{
+  assert (index);
+
+  BtorNodePtrStack *cone;
+  BtorIntHashTableIterator it;
+  BtorMemMgr *mm;
+
+  mm = index->mm;
+  btor_iter_hashint_init (&it, index->cones);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    cone = btor_iter_hashint_next_data (&it)->as_ptr;
+    BTOR_RELEASE_STACK (*cone);
+    BTOR_DELETE (mm, cone);
+  }
+  btor_hashint_map_delete (index->cones);
+  BTOR_RELEASE_STACK (index->cone);
+  BTOR_RELEASE_STACK (index->cone_exps);
+  BTOR_DELETEN (mm, index->mark, index->size);
+  BTOR_DELETEN (mm, index->changed, index->size);
+  BTOR_DELETE (mm, index);
+}
+
+/* Start a new cone update, i.e., invalidate all marks. */
+static void
+next_epoch_cone_index (Btor *btor, BtorLsConeIndex *index)
+{
+  uint32_t size;
+
+  size = BTOR_COUNT_STACK (btor->nodes_id_table);
+  if (size > index->size)
+  {
+    BTOR_REALLOC (index->mm, index->mark, index->size, size);
+    BTOR_REALLOC (index->mm, index->changed, index->size, size);
+    BTOR_CLRN (index->mark + index->size, size - index->size);
+    BTOR_CLRN (index->changed + index->size, size - index->size);
+    index->size = size;
+  }
+  index->epoch += 1;
+  if (!index->epoch)
+  {
+    BTOR_CLRN (index->mark, index->size);
+    BTOR_CLRN (index->changed, index->size);
+    index->epoch = 1;
+  }
+}
+
+/* Collect the cone of 'exps' (excluding 'exps'), ordered by id. */
+static void
+collect_cone (Btor *btor, BtorLsConeIndex *index, BtorIntHashTable *exps)
+{
+  BtorNode *cur;
+  BtorNodeIterator nit;
+  BtorIntHashTableIterator iit;
+  BtorNodePtrStack stack;
+
+  BTOR_RESET_STACK (index->cone);
+  BTOR_RESET_STACK (index->cone_exps);
+  BTOR_INIT_STACK (index->mm, stack);
+  btor_iter_hashint_init (&iit, exps);
+  while (btor_iter_hashint_has_next (&iit))
+  {
+    cur = btor_node_get_by_id (btor, btor_iter_hashint_next (&iit));
+    assert (btor_node_is_regular (cur));
+    assert (btor_node_is_bv_var (cur));
+    BTOR_PUSH_STACK (index->cone_exps, cur->id);
+    index->mark[cur->id] = index->epoch;
+    btor_iter_parent_init (&nit, cur);
+    while (btor_iter_parent_has_next (&nit))
+      BTOR_PUSH_STACK (stack, btor_iter_parent_next (&nit));
+  }
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_POP_STACK (stack);
+    assert (btor_node_is_regular (cur));
+    if (index->mark[cur->id] == index->epoch) continue;
+    index->mark[cur->id] = index->epoch;
+    BTOR_PUSH_STACK (index->cone, cur);
+
+    btor_iter_parent_init (&nit, cur);
+    while (btor_iter_parent_has_next (&nit))
+      BTOR_PUSH_STACK (stack, btor_iter_parent_next (&nit));
+  }
+  BTOR_RELEASE_STACK (stack);
+
+  qsort (index->cone.start,
+         BTOR_COUNT_STACK (index->cone),
+         sizeof (BtorNode *),
+         btor_node_compare_by_id_qsort_asc);
+}
+
+/* Check if 'index->cone' is the cone of 'exps'. */
+static bool
+is_current_cone (BtorLsConeIndex *index, BtorIntHashTable *exps)
+{
+  size_t i;
+
+  if (BTOR_COUNT_STACK (index->cone_exps) != exps->count) return false;
+  for (i = 0; i < BTOR_COUNT_STACK (index->cone_exps); i++)
+    if (!btor_hashint_table_contains (exps,
+                                      BTOR_PEEK_STACK (index->cone_exps, i)))
+      return false;
+  return true;
+}
+
+/* Get the id-ordered cone of 'exps', cached for single inputs. */
+static BtorNodePtrStack *
+get_cone (Btor *btor, BtorLsConeIndex *index, BtorIntHashTable *exps)
+{
+  int32_t id;
+  BtorHashTableData *d;
+  BtorNodePtrStack *res;
+  BtorIntHashTableIterator iit;
+
+  id = 0;
+  if (exps->count == 1)
+  {
+    btor_iter_hashint_init (&iit, exps);
+    id = btor_iter_hashint_next (&iit);
+    if ((d = btor_hashint_map_get (index->cones, id))) return d->as_ptr;
+  }
+  else if (is_current_cone (index, exps))
+    return &index->cone;
+
+  collect_cone (btor, index, exps);
+
+  if (exps->count != 1
+      || index->ncached + BTOR_COUNT_STACK (index->cone)
+             > BTOR_LSUTILS_CONE_INDEX_MAX_CACHED)
+    return &index->cone;
+
+  BTOR_NEW (index->mm, res);
+  BTOR_INIT_STACK (index->mm, *res);
+  BTOR_FIT_STACK (*res, BTOR_COUNT_STACK (index->cone));
+  memcpy (res->start,
+          index->cone.start,
+          BTOR_COUNT_STACK (index->cone) * sizeof (BtorNode *));
+  res->top = res->start + BTOR_COUNT_STACK (index->cone);
+  index->ncached += BTOR_COUNT_STACK (*res);
+  btor_hashint_map_add (index->cones, id)->as_ptr = res;
+  return res;
+}
+
+BtorNodePtrStack *
+btor_lsutils_get_cone (Btor *btor,
+                       BtorLsConeIndex *index,
+                       BtorIntHashTable *exps)
+{
+  assert (btor);
+  assert (index);
+  assert (exps);
+  assert (exps->count);
+
+  next_epoch_cone_index (btor, index);
+  return get_cone (btor, index, exps);
+}
+
+/*------------------------------------------------------------------------*/
+
 /**
  * Update cone of influence.
  *
@@ -85,6 +271,7 @@ btor_lsutils_update_cone (Btor *btor,
                           BtorIntHashTable *roots,
                           BtorIntHashTable *score,
                           BtorIntHashTable *exps,
+                          BtorLsConeIndex *index,
                           bool update_roots,
                           uint64_t *stats_updates,
                           double *time_update_cone,
@@ -99,6 +286,7 @@ btor_lsutils_update_cone (Btor *btor,
   assert (roots);
   assert (exps);
   assert (exps->count);
+  assert (index);
   assert (btor_opt_get (btor, BTOR_OPT_ENGINE) != BTOR_ENGINE_PROP
           || update_roots);
   assert (time_update_cone);
@@ -108,12 +296,11 @@ btor_lsutils_update_cone (Btor *btor,
   double start, delta;
   uint32_t i, j;
   int32_t id;
-  BtorNode *exp, *cur;
-  BtorNodeIterator nit;
+  bool changed, free_e[3];
+  BtorNode *exp, *cur, *real_e;
   BtorIntHashTableIterator iit;
   BtorHashTableData *d;
-  BtorNodePtrStack stack, cone;
-  BtorIntHashTable *cache;
+  BtorNodePtrStack *cone;
   BtorBitVector *bv, *e[3], *ass;
   BtorMemMgr *mm;
 
@@ -142,34 +329,9 @@ btor_lsutils_update_cone (Btor *btor,
 
   /* reset cone ----------------------------------------------------------- */
 
-  BTOR_INIT_STACK (mm, cone);
-  BTOR_INIT_STACK (mm, stack);
-  btor_iter_hashint_init (&iit, exps);
-  while (btor_iter_hashint_has_next (&iit))
-  {
-    exp = btor_node_get_by_id (btor, btor_iter_hashint_next (&iit));
-    assert (btor_node_is_regular (exp));
-    assert (btor_node_is_bv_var (exp));
-    BTOR_PUSH_STACK (stack, exp);
-  }
-  cache = btor_hashint_table_new (mm);
-  while (!BTOR_EMPTY_STACK (stack))
-  {
-    cur = BTOR_POP_STACK (stack);
-    assert (btor_node_is_regular (cur));
-    if (btor_hashint_table_contains (cache, cur->id)) continue;
-    btor_hashint_table_add (cache, cur->id);
-    if (!btor_hashint_table_contains (exps, cur->id))
-      BTOR_PUSH_STACK (cone, cur);
-    *stats_updates += 1;
-
-    /* push parents */
-    btor_iter_parent_init (&nit, cur);
-    while (btor_iter_parent_has_next (&nit))
-      BTOR_PUSH_STACK (stack, btor_iter_parent_next (&nit));
-  }
-  BTOR_RELEASE_STACK (stack);
-  btor_hashint_table_delete (cache);
+  next_epoch_cone_index (btor, index);
+  cone = get_cone (btor, index, exps);
+  *stats_updates += BTOR_COUNT_STACK (*cone) + exps->count;
 
   *time_update_cone_reset += btor_util_time_stamp () - delta;
 
@@ -181,6 +343,9 @@ btor_lsutils_update_cone (Btor *btor,
     ass = (BtorBitVector *) exps->data[iit.cur_pos].as_ptr;
     exp = btor_node_get_by_id (btor, btor_iter_hashint_next (&iit));
 
+    /* the parents of exps are always recomputed */
+    index->changed[exp->id] = index->epoch;
+
     /* update model */
     d = btor_hashint_map_get (bv_model, exp->id);
     assert (d);
@@ -216,42 +381,55 @@ btor_lsutils_update_cone (Btor *btor,
     }
   }
 
-  qsort (cone.start,
-         BTOR_COUNT_STACK (cone),
-         sizeof (BtorNode *),
-         btor_node_compare_by_id_qsort_asc);
-
   /* update model of cone ------------------------------------------------- */
 
   delta = btor_util_time_stamp ();
 
-  for (i = 0; i < BTOR_COUNT_STACK (cone); i++)
+  /* The cone is ordered by id, i.e., the children of a node are updated
+   * before the node itself. Nodes whose children did not change keep their
+   * assignment. */
+  for (i = 0; i < BTOR_COUNT_STACK (*cone); i++)
   {
-    cur = BTOR_PEEK_STACK (cone, i);
+    cur = BTOR_PEEK_STACK (*cone, i);
     assert (btor_node_is_regular (cur));
+
+    d = btor_hashint_map_get (bv_model, cur->id);
+    if (d)
+    {
+      changed = false;
+      for (j = 0; j < cur->arity && !changed; j++)
+        changed = index->changed[btor_node_real_addr (cur->e[j])->id]
+                  == index->epoch;
+      if (!changed) continue;
+    }
+
     for (j = 0; j < cur->arity; j++)
     {
-      if (btor_node_is_bv_const (cur->e[j]))
+      real_e    = btor_node_real_addr (cur->e[j]);
+      free_e[j] = false;
+      if (btor_node_is_bv_const (real_e))
       {
-        e[j] =
-            btor_node_is_inverted (cur->e[j])
-                ? btor_bv_copy (mm, btor_node_bv_const_get_invbits (cur->e[j]))
-                : btor_bv_copy (mm, btor_node_bv_const_get_bits (cur->e[j]));
+        e[j] = btor_node_is_inverted (cur->e[j])
+                   ? btor_node_bv_const_get_invbits (real_e)
+                   : btor_node_bv_const_get_bits (real_e);
+        continue;
       }
-      else
+      d = btor_hashint_map_get (bv_model, real_e->id);
+      /* Note: generate model enabled branch for ite (and does not
+       * generate model for nodes in the branch, hence !b may happen */
+      if (!d)
+      {
+        e[j] = btor_model_recursively_compute_assignment (
+            btor, bv_model, btor->fun_model, cur->e[j]);
+        free_e[j] = true;
+      }
+      else if (btor_node_is_inverted (cur->e[j]))
       {
-        d = btor_hashint_map_get (bv_model,
-                                  btor_node_real_addr (cur->e[j])->id);
-        /* Note: generate model enabled branch for ite (and does not
-         * generate model for nodes in the branch, hence !b may happen */
-        if (!d)
-          e[j] = btor_model_recursively_compute_assignment (
-              btor, bv_model, btor->fun_model, cur->e[j]);
-        else
-          e[j] = btor_node_is_inverted (cur->e[j])
-                     ? btor_bv_not (mm, d->as_ptr)
-                     : btor_bv_copy (mm, d->as_ptr);
+        e[j]      = btor_bv_not (mm, d->as_ptr);
+        free_e[j] = true;
       }
+      else
+        e[j] = d->as_ptr;
     }
     switch (cur->kind)
     {
@@ -277,10 +455,22 @@ btor_lsutils_update_cone (Btor *btor,
                                     : btor_bv_copy (mm, e[2]);
     }
 
+    /* cleanup */
+    for (j = 0; j < cur->arity; j++)
+      if (free_e[j]) btor_bv_free (mm, e[j]);
+
     /* update assignment */
 
     d = btor_hashint_map_get (bv_model, cur->id);
 
+    /* assignment did not change */
+    if (d && !btor_bv_compare (d->as_ptr, bv))
+    {
+      btor_bv_free (mm, bv);
+      continue;
+    }
+    index->changed[cur->id] = index->epoch;
+
     /* update roots table */
     if (update_roots
         && (cur->constraint || btor_hashptr_table_get (btor->assumptions, cur)
@@ -288,9 +478,7 @@ btor_lsutils_update_cone (Btor *btor,
                                        btor_node_invert (cur))))
     {
       assert (d); /* must be contained, is root */
-      /* old assignment != new assignment */
-      if (btor_bv_compare (d->as_ptr, bv))
-        update_roots_table (btor, roots, cur, bv);
+      update_roots_table (btor, roots, cur, bv);
     }
 
     /* update assignments */
@@ -312,8 +500,6 @@ btor_lsutils_update_cone (Btor *btor,
       btor_bv_free (mm, d->as_ptr);
       d->as_ptr = btor_bv_not (mm, bv);
     }
-    /* cleanup */
-    for (j = 0; j < cur->arity; j++) btor_bv_free (mm, e[j]);
   }
   *time_update_cone_model_gen += btor_util_time_stamp () - delta;
 
@@ -322,9 +508,9 @@ btor_lsutils_update_cone (Btor *btor,
   if (score)
   {
     delta = btor_util_time_stamp ();
-    for (i = 0; i < BTOR_COUNT_STACK (cone); i++)
+    for (i = 0; i < BTOR_COUNT_STACK (*cone); i++)
     {
-      cur = BTOR_PEEK_STACK (cone, i);
+      cur = BTOR_PEEK_STACK (*cone, i);
       assert (btor_node_is_regular (cur));
 
       if (btor_node_bv_get_width (btor, cur) != 1) continue;
@@ -347,8 +533,6 @@ btor_lsutils_update_cone (Btor *btor,
     *time_update_cone_compute_score += btor_util_time_stamp () - delta;
   }
 
-  BTOR_RELEASE_STACK (cone);
-
 #ifndef NDEBUG
   btor_iter_hashptr_init (&pit, btor->unsynthesized_constraints);
   btor_iter_hashptr_queue (&pit, btor->assumptions);
@@ -363,3 +547,229 @@ btor_lsutils_update_cone (Btor *btor,
 #endif
   *time_update_cone += btor_util_time_stamp () - start;
 }
+
+/*------------------------------------------------------------------------*/
+
+static void
+reset_assignment (Btor *btor,
+                  BtorIntHashTable *bv_model,
+                  BtorIntHashTable *src_bv_model,
+                  int32_t id)
+{
+  BtorHashTableData *d, *s, data;
+
+  d = btor_hashint_map_get (bv_model, id);
+  s = btor_hashint_map_get (src_bv_model, id);
+
+  if (s)
+  {
+    if (!d)
+    {
+      btor_node_copy (btor, btor_node_get_by_id (btor, id));
+      btor_hashint_map_add (bv_model, id)->as_ptr =
+          btor_bv_copy (btor->mm, s->as_ptr);
+    }
+    else if (btor_bv_compare (d->as_ptr, s->as_ptr))
+    {
+      btor_bv_free (btor->mm, d->as_ptr);
+      d->as_ptr = btor_bv_copy (btor->mm, s->as_ptr);
+    }
+  }
+  else if (d)
+  {
+    /* assignment was generated on demand while trying a move */
+    btor_hashint_map_remove (bv_model, id, &data);
+    btor_bv_free (btor->mm, data.as_ptr);
+    btor_node_release (btor, btor_node_get_by_id (btor, id));
+  }
+}
+
+static void
+reset_node (Btor *btor,
+            BtorIntHashTable *bv_model,
+            BtorIntHashTable *score,
+            BtorIntHashTable *src_bv_model,
+            BtorIntHashTable *src_score,
+            BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  BtorHashTableData *d;
+
+  reset_assignment (btor, bv_model, src_bv_model, exp->id);
+  reset_assignment (btor, bv_model, src_bv_model, -exp->id);
+
+  if (!score || btor_node_bv_get_width (btor, exp) != 1) return;
+
+  if ((d = btor_hashint_map_get (score, exp->id)))
+  {
+    assert (btor_hashint_map_contains (src_score, exp->id));
+    d->as_dbl = btor_hashint_map_get (src_score, exp->id)->as_dbl;
+  }
+  if ((d = btor_hashint_map_get (score, -exp->id)))
+  {
+    assert (btor_hashint_map_contains (src_score, -exp->id));
+    d->as_dbl = btor_hashint_map_get (src_score, -exp->id)->as_dbl;
+  }
+}
+
+void
+btor_lsutils_reset_cone (Btor *btor,
+                         BtorIntHashTable *bv_model,
+                         BtorIntHashTable *score,
+                         BtorIntHashTable *src_bv_model,
+                         BtorIntHashTable *src_score,
+                         BtorIntHashTable *exps,
+                         BtorLsConeIndex *index)
+{
+  assert (btor);
+  assert (bv_model);
+  assert (src_bv_model);
+  assert (!score || src_score);
+  assert (exps);
+  assert (index);
+
+  uint32_t i;
+  BtorNodePtrStack *cone;
+  BtorIntHashTableIterator iit;
+
+  next_epoch_cone_index (btor, index);
+  cone = get_cone (btor, index, exps);
+
+  btor_iter_hashint_init (&iit, exps);
+  while (btor_iter_hashint_has_next (&iit))
+    reset_node (btor,
+                bv_model,
+                score,
+                src_bv_model,
+                src_score,
+                btor_node_get_by_id (btor, btor_iter_hashint_next (&iit)));
+
+  for (i = 0; i < BTOR_COUNT_STACK (*cone); i++)
+    reset_node (btor,
+                bv_model,
+                score,
+                src_bv_model,
+                src_score,
+                BTOR_PEEK_STACK (*cone, i));
+}
+
+/*------------------------------------------------------------------------*/
+
+BtorLsWarmStart *
+btor_lsutils_new_warm_start (Btor *btor)
+{
+  assert (btor);
+  assert (btor->bv_model);
+
+  uint32_t i;
+  int32_t id;
+  BtorNode *cur;
+  BtorBitVector *bv;
+  BtorLsWarmStart *res;
+  BtorIntHashTableIterator it;
+
+  BTOR_CNEW (btor->mm, res);
+  res->mm     = btor->mm;
+  res->inputs = btor_hashint_map_new (btor->mm);
+  BTOR_INIT_STACK (btor->mm, res->assertions);
+
+  btor_iter_hashint_init (&it, btor->bv_model);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    bv  = btor->bv_model->data[it.cur_pos].as_ptr;
+    id  = btor_iter_hashint_next (&it);
+    cur = btor_node_get_by_id (btor, id);
+    if (id < 0 || !btor_node_is_bv_var (cur)) continue;
+    btor_hashint_map_add (res->inputs, id)->as_ptr =
+        btor_bv_copy (btor->mm, bv);
+  }
+
+  for (i = 0; i < BTOR_COUNT_STACK (btor->assertions); i++)
+    BTOR_PUSH_STACK (res->assertions,
+                     btor_node_get_id (BTOR_PEEK_STACK (btor->assertions, i)));
+  return res;
+}
+
+BtorLsWarmStart *
+btor_lsutils_clone_warm_start (BtorMemMgr *mm, BtorLsWarmStart *ws)
+{
+  assert (mm);
+
+  uint32_t i;
+  BtorLsWarmStart *res;
+
+  if (!ws) return 0;
+
+  BTOR_CNEW (mm, res);
+  res->mm     = mm;
+  res->inputs =
+      btor_hashint_map_clone (mm, ws->inputs, btor_clone_data_as_bv_ptr, 0);
+  BTOR_INIT_STACK (mm, res->assertions);
+  for (i = 0; i < BTOR_COUNT_STACK (ws->assertions); i++)
+    BTOR_PUSH_STACK (res->assertions, BTOR_PEEK_STACK (ws->assertions, i));
+  return res;
+}
+
+void
+btor_lsutils_delete_warm_start (BtorLsWarmStart *ws)
+{
+  assert (ws);
+
+  BtorIntHashTableIterator it;
+
+  btor_iter_hashint_init (&it, ws->inputs);
+  while (btor_iter_hashint_has_next (&it))
+    btor_bv_free (ws->mm, btor_iter_hashint_next_data (&it)->as_ptr);
+  btor_hashint_map_delete (ws->inputs);
+  BTOR_RELEASE_STACK (ws->assertions);
+  BTOR_DELETE (ws->mm, ws);
+}
+
+bool
+btor_lsutils_is_warm_start_valid (Btor *btor, BtorLsWarmStart *ws)
+{
+  assert (btor);
+  assert (ws);
+
+  uint32_t i;
+
+  /* assertions of the last call must be a prefix of the current ones,
+   * assertions on level 0 are permanent */
+  if (BTOR_COUNT_STACK (ws->assertions) > BTOR_COUNT_STACK (btor->assertions))
+    return false;
+  for (i = 0; i < BTOR_COUNT_STACK (ws->assertions); i++)
+    if (BTOR_PEEK_STACK (ws->assertions, i)
+        != btor_node_get_id (BTOR_PEEK_STACK (btor->assertions, i)))
+      return false;
+  return true;
+}
+
+void
+btor_lsutils_init_model (Btor *btor, BtorLsWarmStart *ws)
+{
+  assert (btor);
+
+  BtorNode *cur;
+  BtorBitVector *bv;
+  BtorIntHashTableIterator it;
+
+  btor_model_init_bv (btor, &btor->bv_model);
+  btor_model_init_fun (btor, &btor->fun_model);
+
+  if (ws)
+  {
+    btor_iter_hashint_init (&it, ws->inputs);
+    while (btor_iter_hashint_has_next (&it))
+    {
+      bv  = ws->inputs->data[it.cur_pos].as_ptr;
+      cur = btor_node_get_by_id (btor, btor_iter_hashint_next (&it));
+      /* skip inputs that have been released or substituted */
+      if (!cur || !btor_node_is_bv_var (cur) || btor_node_is_simplified (cur))
+        continue;
+      btor_model_add_to_bv (btor, btor->bv_model, cur, bv);
+    }
+  }
+
+  btor_model_generate (btor, btor->bv_model, btor->fun_model, false);
+}
@@ -9,9 +9,47 @@
 #ifndef BTORLSUTILS_H_INCLUDED
 #define BTORLSUTILS_H_INCLUDED
 
+#include "btornode.h"
 #include "btortypes.h"
 #include "utils/btorhashint.h"
 
+/**
+ * Dependency index for cone updates, built once per sat call.
+ *
+ * Maintains dense (id-indexed) marks for collecting the cone of a set of
+ * inputs and caches the id-ordered (i.e., topologically ordered) cone of
+ * single inputs, which is static for the duration of a sat call. The cone
+ * of the most recent set of multiple inputs is kept until it is replaced.
+ */
+struct BtorLsConeIndex
+{
+  BtorMemMgr* mm;
+  uint32_t size;           /* number of id-indexed slots */
+  uint32_t epoch;          /* current mark value */
+  uint32_t* mark;          /* mark[id] == epoch: in current cone */
+  uint32_t* changed;       /* changed[id] == epoch: assignment changed */
+  BtorIntHashTable* cones; /* maps input id to its cone */
+  uint64_t ncached;        /* number of cached cone nodes */
+  BtorNodePtrStack cone;   /* cone of the current update */
+  BtorIntStack cone_exps;  /* inputs of 'cone' */
+};
+
+typedef struct BtorLsConeIndex BtorLsConeIndex;
+
+BtorLsConeIndex* btor_lsutils_new_cone_index (Btor* btor);
+
+void btor_lsutils_delete_cone_index (BtorLsConeIndex* index);
+
+/**
+ * Get the id-ordered cone of influence of 'exps' (excluding 'exps').
+ *
+ * Note: The cone of multiple inputs is only valid until the cone of a
+ *       different set of inputs is requested (or updated).
+ */
+BtorNodePtrStack* btor_lsutils_get_cone (Btor* btor,
+                                         BtorLsConeIndex* index,
+                                         BtorIntHashTable* exps);
+
 /**
  * Update cone of incluence as a consequence of a local search move.
  *
@@ -25,6 +63,7 @@ void btor_lsutils_update_cone (Btor* btor,
                                BtorIntHashTable* roots,
                                BtorIntHashTable* score,
                                BtorIntHashTable* exps,
+                               BtorLsConeIndex* index,
                                bool update_roots,
                                uint64_t* stats_updates,
                                double* time_update_cone,
@@ -32,4 +71,52 @@ void btor_lsutils_update_cone (Btor* btor,
                                double* time_update_cone_model_gen,
                                double* time_update_cone_compute_score);
 
+/**
+ * Reset the assignments and scores of 'exps' and their cone in 'bv_model'
+ * and 'score' to the ones in 'src_bv_model' and 'src_score'.
+ *
+ * Used to restore a snapshot of 'src_bv_model' after candidate moves have
+ * been tried on it (only nodes in the cone of the moved inputs may differ).
+ */
+void btor_lsutils_reset_cone (Btor* btor,
+                              BtorIntHashTable* bv_model,
+                              BtorIntHashTable* score,
+                              BtorIntHashTable* src_bv_model,
+                              BtorIntHashTable* src_score,
+                              BtorIntHashTable* exps,
+                              BtorLsConeIndex* index);
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * Input assignment of the last sat call, used as initial model of the next
+ * sat call in incremental mode as long as the formula has only grown, i.e.,
+ * no assertions have been popped in the meantime.
+ */
+struct BtorLsWarmStart
+{
+  BtorMemMgr* mm;
+  BtorIntHashTable* inputs; /* maps bv var ids to assignments */
+  BtorIntStack assertions;  /* ids of 'btor->assertions' */
+};
+
+typedef struct BtorLsWarmStart BtorLsWarmStart;
+
+/* Save the current input assignment of 'btor->bv_model'. */
+BtorLsWarmStart* btor_lsutils_new_warm_start (Btor* btor);
+
+BtorLsWarmStart* btor_lsutils_clone_warm_start (BtorMemMgr* mm,
+                                                BtorLsWarmStart* ws);
+
+void btor_lsutils_delete_warm_start (BtorLsWarmStart* ws);
+
+/* Check if the formula has only grown since 'ws' has been saved. */
+bool btor_lsutils_is_warm_start_valid (Btor* btor, BtorLsWarmStart* ws);
+
+/**
+ * Generate the initial model, inputs are initialized with their assignment
+ * in 'ws' (if any) and with zero otherwise.
+ */
+void btor_lsutils_init_model (Btor* btor, BtorLsWarmStart* ws);
+
 #endif
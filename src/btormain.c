@@ -13,6 +13,7 @@
 #include "btorexit.h"
 #include "btoropt.h"
 #include "btorparse.h"
+#include "preprocess/btorpreprocess.h"
 #include "utils/btorhashptr.h"
 #include "utils/btormem.h"
 #include "utils/btoroptparse.h"
@@ -402,7 +403,7 @@ btormain_opt_has_str_arg (const char *opt, BtorOpt *btor_opts)
   {
     if (((btor_opts[i].shrt && strcmp (opt, btor_opts[i].shrt) == 0)
          || strcmp (opt, btor_opts[i].lng) == 0)
-        && btor_opts[i].options)
+        && (btor_opts[i].options || i == BTOR_OPT_SIMP_PIPELINE))
       return true;
   }
   return false;
@@ -1001,6 +1002,7 @@ boolector_main (int32_t argc, char **argv)
   BtorMainOpt *bmo;
   BtorMemMgr *mm;
   Btor *btor;
+  BtorSimpPipeline pipeline;
   BtorPtrHashBucket *b;
 
   g_start_time_real = btor_util_current_time ();
@@ -1238,6 +1240,24 @@ boolector_main (int32_t argc, char **argv)
         btormain_error (g_app, "invalid option '%s'", po->orig.start);
         goto DONE;
       }
+      if (bopt == BTOR_OPT_SIMP_PIPELINE)
+      {
+        if (BTOR_ARG_IS_MISSING (BTOR_ARG_EXPECT_STR, false, po->readval))
+        {
+          btormain_error (g_app, "missing argument for '%s'", po->orig.start);
+          goto DONE;
+        }
+        if (!btor_simplify_parse_pipeline (po->valstr, &pipeline))
+        {
+          btormain_error (g_app,
+                          "invalid argument '%s' for '%s'",
+                          po->valstr,
+                          po->orig.start);
+          goto DONE;
+        }
+        boolector_set_simp_pipeline (btor, po->valstr);
+        continue;
+      }
       if ((bo->options
            && BTOR_ARG_IS_MISSING (
                   BTOR_ARG_EXPECT_STR, bo->isflag, po->readval))
@@ -549,6 +549,17 @@ btor_opt_init_opts (Btor *btor)
             1,
             "run sls engine as preprocessing within a sequential portfolio "
             "(QF_BV only)");
+  init_opt (btor,
+            BTOR_OPT_FUN_PREPHASE,
+            false,
+            true,
+            "fun-prephase",
+            0,
+            1,
+            0,
+            1,
+            "use assignment of failed prop/sls preprocessing as phases "
+            "of the SAT solver");
   init_opt (btor,
             BTOR_OPT_FUN_DUAL_PROP,
             false,
@@ -677,6 +688,28 @@ btor_opt_init_opts (Btor *btor)
             1,
             "represent array store as lambda");
 
+  init_opt (btor,
+            BTOR_OPT_FUN_WEAK_EQ,
+            false,
+            true,
+            "fun-weak-eq",
+            "fun-weq",
+            0,
+            0,
+            1,
+            "check array reads via weak equivalence graph");
+
+  init_opt (btor,
+            BTOR_OPT_FUN_LEMMA_MIN,
+            false,
+            true,
+            "fun-lemma-min",
+            "fun-lm",
+            0,
+            0,
+            1,
+            "minimize premises of lemmas");
+
   init_opt (
       btor,
       BTOR_OPT_PRINT_DIMACS,
@@ -902,6 +935,16 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "use bandit scheme for constraint selection");
+  init_opt (btor,
+            BTOR_OPT_SLS_WARM_START,
+            false,
+            true,
+            "sls-warm-start",
+            0,
+            1,
+            0,
+            1,
+            "start from previous model and weights in incremental mode");
 
   /* PROP engine ---------------------------------------------------------- */
   init_opt (btor,
@@ -934,6 +977,16 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "use bandit scheme for constraint selection");
+  init_opt (btor,
+            BTOR_OPT_PROP_USE_DOMAINS,
+            false,
+            true,
+            "prop-use-domains",
+            0,
+            0,
+            0,
+            1,
+            "use known bits and bounds to guide path selection");
 
   init_opt (btor,
             BTOR_OPT_PROP_PATH_SEL,
@@ -1107,6 +1160,26 @@ btor_opt_init_opts (Btor *btor)
             1,
             "do not perform a propagation move when encountering a conflict"
             "during inverse computation");
+  init_opt (btor,
+            BTOR_OPT_PROP_NWALKERS,
+            false,
+            false,
+            "prop-nwalkers",
+            0,
+            1,
+            1,
+            BTOR_PROP_NWALKERS_MAX,
+            "number of parallel random walks for prop engine");
+  init_opt (btor,
+            BTOR_OPT_PROP_WARM_START,
+            false,
+            true,
+            "prop-warm-start",
+            0,
+            1,
+            0,
+            1,
+            "start from previous model in incremental mode");
 
   /* AIGPROP engine ------------------------------------------------------- */
   init_opt (btor,
@@ -1129,6 +1202,17 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "use bandit scheme for constraint selection");
+  init_opt (btor,
+            BTOR_OPT_AIGPROP_NSIM_FLIPS,
+            false,
+            false,
+            "aigprop-nsim-flips",
+            0,
+            0,
+            0,
+            BTOR_AIGPROP_NSIM_FLIPS_MAX,
+            "number of random flips evaluated via bit-parallel simulation "
+            "per move");
 
   /* QUANT engine ----------------------------------------------------------- */
   init_opt (btor,
@@ -1246,6 +1330,16 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "synthesize quantifier instantiations from counterexamples");
+  init_opt (btor,
+            BTOR_OPT_QUANT_NSOLVERS,
+            false,
+            false,
+            "quant-nsolvers",
+            0,
+            1,
+            1,
+            BTOR_QUANT_NSOLVERS_MAX,
+            "number of parallel ground solvers for the original formula");
 
   /* internal options ---------------------------------------------------- */
   init_opt (btor,
@@ -1369,6 +1463,60 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "enable global adder normalization");
+  init_opt (btor,
+            BTOR_OPT_SIMP_FRONTIER,
+            true,
+            true,
+            "simp-frontier",
+            0,
+            1,
+            0,
+            1,
+            "only preprocess constraints and nodes added since the last call "
+            "in incremental mode");
+  init_opt (btor,
+            BTOR_OPT_SIMP_LINEAR_SYSTEMS,
+            true,
+            true,
+            "simp-linear-systems",
+            0,
+            0,
+            0,
+            1,
+            "eliminate variables by solving systems of linear equations "
+            "modulo 2^n");
+  init_opt (btor,
+            BTOR_OPT_SIMP_KNOWN_BITS,
+            true,
+            true,
+            "simp-known-bits",
+            0,
+            0,
+            0,
+            1,
+            "rewrite nodes based on their known bits and unsigned bounds");
+  init_opt (btor,
+            BTOR_OPT_SIMP_SYMMETRY,
+            true,
+            true,
+            "simp-symmetry",
+            0,
+            0,
+            0,
+            1,
+            "add lex-leader constraints for symmetric variables "
+            "(non-incremental only)");
+  init_opt (btor,
+            BTOR_OPT_SIMP_PIPELINE,
+            true,
+            false,
+            "simp-pipeline",
+            0,
+            0,
+            0,
+            0,
+            "comma-separated list of preprocessing passes with optional "
+            "repetition limit (<pass>[:<limit>])");
   init_opt (btor,
             BTOR_OPT_DECLSORT_BV_WIDTH,
             true,
@@ -1612,27 +1760,6 @@ btor_opt_set (Btor *btor, const BtorOption opt, uint32_t val)
   else if (opt == BTOR_OPT_MODEL_GEN)
   {
     if (!val && btor_opt_get (btor, opt)) btor_model_delete (btor);
-    if (val && btor_opt_get (btor, BTOR_OPT_UCOPT))
-    {
-      btor_opt_set (btor, BTOR_OPT_UCOPT, 0);
-      BTOR_MSG (btor->msg,
-                1,
-                "Disabling unconstrained optimization since model generation "
-                "is enabled");
-    }
-    assert (!val || !btor_opt_get (btor, BTOR_OPT_UCOPT));
-  }
-  else if (opt == BTOR_OPT_UCOPT)
-  {
-    if (val && btor_opt_get (btor, BTOR_OPT_MODEL_GEN))
-    {
-      BTOR_MSG (btor->msg,
-                1,
-                "Disabling unconstrained optimization since model generation "
-                "is enabled");
-      val = 0;
-    }
-    assert (!val || !btor_opt_get (btor, BTOR_OPT_INCREMENTAL));
   }
   else if (opt == BTOR_OPT_SAT_ENGINE)
   {
@@ -1708,8 +1835,10 @@ btor_opt_set_str (Btor *btor, const BtorOption opt, const char *str)
 {
   assert (btor);
   assert (btor_opt_is_valid (btor, opt));
-  assert (opt == BTOR_OPT_SAT_ENGINE);
+  assert (opt == BTOR_OPT_SAT_ENGINE || opt == BTOR_OPT_SIMP_PIPELINE);
 
+  if (btor->options[opt].valstr)
+    btor_mem_freestr (btor->mm, btor->options[opt].valstr);
   btor->options[opt].valstr = btor_mem_strdup (btor->mm, str);
 }
 
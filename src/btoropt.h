@@ -109,10 +109,16 @@ extern const char *const g_btor_se_name[BTOR_SAT_ENGINE_MAX + 1];
 #define BTOR_PROP_PATH_SEL_MAX BTOR_PROP_PATH_SEL_RANDOM
 #define BTOR_PROP_PATH_SEL_DFLT BTOR_PROP_PATH_SEL_ESSENTIAL
 
+#define BTOR_PROP_NWALKERS_MAX 64
+
+#define BTOR_AIGPROP_NSIM_FLIPS_MAX 63
+
 #define BTOR_QUANT_SYNTH_MIN BTOR_QUANT_SYNTH_NONE
 #define BTOR_QUANT_SYNTH_MAX BTOR_QUANT_SYNTH_ELMR
 #define BTOR_QUANT_SYNTH_DFLT BTOR_QUANT_SYNTH_ELMR
 
+#define BTOR_QUANT_NSOLVERS_MAX 16
+
 #define BTOR_FUN_EAGER_LEMMAS_MIN BTOR_FUN_EAGER_LEMMAS_NONE
 #define BTOR_FUN_EAGER_LEMMAS_MAX BTOR_FUN_EAGER_LEMMAS_ALL
 #define BTOR_FUN_EAGER_LEMMAS_DFLT BTOR_FUN_EAGER_LEMMAS_CONF
@@ -871,6 +871,433 @@ select_path_cond (Btor *btor,
   return eidx;
 }
 
+/* ========================================================================== */
+/* Native value computation for bit-widths <= 64                              */
+/* ========================================================================== */
+
+/* Consistent and inverse values of bit-vectors with a bit-width of at most
+ * 64 bits are computed on unsigned integers rather than via the generic
+ * bit-vector functions (which allocate several temporaries per call).
+ * The native variants draw the same random numbers as the generic ones. */
+
+#define BTOR_PROPUTILS_NATIVE_BW 64
+
+static inline uint64_t
+native_ones (uint32_t bw)
+{
+  assert (bw > 0 && bw <= BTOR_PROPUTILS_NATIVE_BW);
+  return bw == 64 ? ~((uint64_t) 0) : (((uint64_t) 1) << bw) - 1;
+}
+
+static inline uint32_t
+native_ctz (uint64_t v, uint32_t bw)
+{
+  return v ? (uint32_t) __builtin_ctzll (v) : bw;
+}
+
+static inline uint32_t
+native_clz (uint64_t v, uint32_t bw)
+{
+  return v ? (uint32_t) __builtin_clzll (v) - (64 - bw) : bw;
+}
+
+static inline bool
+native_is_umulo (uint64_t a, uint64_t b, uint32_t bw)
+{
+  return a && b && a > native_ones (bw) / b;
+}
+
+static inline uint64_t
+native_set_bit (uint64_t v, uint32_t pos, uint32_t bit)
+{
+  return (v & ~(((uint64_t) 1) << pos)) | (((uint64_t) bit) << pos);
+}
+
+/* Modular inverse of odd 'v' (mod 2^bw) via Newton iteration, each step
+ * doubles the number of correct bits (v * v = 1 mod 8). */
+static uint64_t
+native_mod_inverse (uint64_t v, uint32_t bw)
+{
+  assert (v & 1);
+
+  uint32_t i;
+  uint64_t res;
+
+  res = v;
+  for (i = 0; i < 5; i++) res *= 2 - v * res;
+  assert (v * res == 1);
+  return res & native_ones (bw);
+}
+
+static uint64_t
+native_random (Btor *btor, uint32_t bw)
+{
+  return btor_bv_random_uint64 (btor->mm, &btor->rng, bw);
+}
+
+static uint64_t
+native_random_range (Btor *btor, uint32_t bw, uint64_t from, uint64_t to)
+{
+  return btor_bv_random_range_uint64 (btor->mm, &btor->rng, bw, from, to);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static uint64_t
+cons_mul_native (Btor *btor, uint64_t bvmul, uint32_t bw)
+{
+  uint32_t r, ctz_bvmul;
+  uint64_t res;
+
+  res = native_random (btor, bw);
+  if (bvmul)
+  {
+    if (!res) res = native_random (btor, bw);
+    /* bvmul odd -> choose odd value > 0 */
+    if (bvmul & 1)
+    {
+      res |= 1;
+    }
+    /* bvmul even -> choose random value > 0 with number of 0-LSBs in res
+     * less or equal than in bvmul */
+    else
+    {
+      ctz_bvmul = native_ctz (bvmul, bw);
+      if (btor_rng_pick_with_prob (&btor->rng, 100))
+      {
+        res = ((uint64_t) 1) << btor_rng_pick_rand (&btor->rng, 0, ctz_bvmul - 1);
+      }
+      else if (btor_rng_pick_with_prob (&btor->rng, 100))
+      {
+        r   = btor_rng_pick_rand (&btor->rng, 0, ctz_bvmul);
+        res = bvmul >> r;
+      }
+      else if (native_ctz (res, bw) > ctz_bvmul)
+      {
+        res = native_set_bit (
+            res, btor_rng_pick_rand (&btor->rng, 0, ctz_bvmul - 1), 1);
+      }
+    }
+  }
+  return res;
+}
+
+static uint64_t
+cons_udiv_native (Btor *btor, uint64_t bvudiv, uint32_t bw, int32_t eidx)
+{
+  uint64_t res, bvmax, tmpbve;
+
+  bvmax = native_ones (bw);
+
+  if (eidx)
+  {
+    if (bvudiv == bvmax)
+      res = btor_rng_pick_rand (&btor->rng, 0, 1);
+    else
+    {
+      res = native_random_range (btor, bw, 1, bvmax);
+      while (native_is_umulo (res, bvudiv, bw))
+        res = native_random_range (btor, bw, 1, res - 1);
+    }
+  }
+  else
+  {
+    if (!bvudiv)
+      res = native_random_range (btor, bw, 0, bvmax - 1);
+    else if (bvudiv == bvmax)
+      res = native_random (btor, bw);
+    else
+    {
+      tmpbve = native_random_range (btor, bw, 1, bvmax);
+      while (native_is_umulo (tmpbve, bvudiv, bw))
+        tmpbve = native_random_range (btor, bw, 1, tmpbve - 1);
+      res = (tmpbve * bvudiv) & bvmax;
+    }
+  }
+  return res;
+}
+
+static uint64_t
+cons_urem_native (Btor *btor, uint64_t bvurem, uint32_t bw, int32_t eidx)
+{
+  uint64_t bvmax;
+
+  bvmax = native_ones (bw);
+
+  if (bvurem == bvmax) return eidx ? 0 : bvmax;
+  return eidx ? native_random_range (btor, bw, bvurem + 1, bvmax)
+              : native_random_range (btor, bw, bvurem, bvmax);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* Note: the inverse value functions below return false on conflict. */
+
+static bool
+inv_sll_native (Btor *btor,
+                uint64_t bvsll,
+                uint64_t bve,
+                uint32_t bw,
+                int32_t eidx,
+                uint64_t *res)
+{
+  uint32_t i, ctz_bve, ctz_bvsll, shift;
+
+  ctz_bvsll = native_ctz (bvsll, bw);
+
+  if (eidx)
+  {
+    if (!bve && !bvsll)
+    {
+      *res = native_random (btor, bw);
+      return true;
+    }
+    ctz_bve = native_ctz (bve, bw);
+    if (ctz_bve > ctz_bvsll) return false;
+    shift = ctz_bvsll - ctz_bve;
+    if (!bvsll)
+    {
+      *res = native_random_range (btor, bw, shift, native_ones (bw));
+      return true;
+    }
+    /* shifted bits must match */
+    if (((bve << shift) & native_ones (bw)) != bvsll) return false;
+    *res = shift;
+    return true;
+  }
+
+  /* same as generic version, shift is truncated to 32 bit */
+  shift = (uint32_t) bve;
+  if ((shift < bw && ctz_bvsll < shift) || (shift >= bw && ctz_bvsll != bw))
+    return false;
+  *res = bve >= bw ? 0 : bvsll >> bve;
+  for (i = 0; i < shift && i < bw; i++)
+    *res = native_set_bit (
+        *res, bw - 1 - i, btor_rng_pick_rand (&btor->rng, 0, 1));
+  return true;
+}
+
+static bool
+inv_srl_native (Btor *btor,
+                uint64_t bvsrl,
+                uint64_t bve,
+                uint32_t bw,
+                int32_t eidx,
+                uint64_t *res)
+{
+  uint32_t i, clz_bve, clz_bvsrl, shift;
+
+  clz_bvsrl = native_clz (bvsrl, bw);
+
+  if (eidx)
+  {
+    if (!bve && !bvsrl)
+    {
+      *res = native_random (btor, bw);
+      return true;
+    }
+    clz_bve = native_clz (bve, bw);
+    if (clz_bve > clz_bvsrl) return false;
+    shift = clz_bvsrl - clz_bve;
+    if (!bvsrl)
+    {
+      *res = native_random_range (btor, bw, shift, native_ones (bw));
+      return true;
+    }
+    /* shifted bits must match */
+    if ((bve >> shift) != bvsrl) return false;
+    *res = shift;
+    return true;
+  }
+
+  /* same as generic version, shift is truncated to 32 bit */
+  shift = (uint32_t) bve;
+  if ((shift < bw && clz_bvsrl < shift) || (shift >= bw && clz_bvsrl != bw))
+    return false;
+  *res = bve >= bw ? 0 : (bvsrl << bve) & native_ones (bw);
+  for (i = 0; i < shift && i < bw; i++)
+    *res = native_set_bit (*res, i, btor_rng_pick_rand (&btor->rng, 0, 1));
+  return true;
+}
+
+static bool
+inv_mul_native (
+    Btor *btor, uint64_t bvmul, uint64_t bve, uint32_t bw, uint64_t *res)
+{
+  uint32_t i, j;
+
+  if (!bve)
+  {
+    if (bvmul) return false;
+    *res = native_random (btor, bw);
+    return true;
+  }
+  /* bvmul odd and bve even */
+  if ((bvmul & 1) && !(bve & 1)) return false;
+
+  /* bve odd -> unique solution via modular inverse */
+  if (bve & 1)
+  {
+    *res = (native_mod_inverse (bve, bw) * bvmul) & native_ones (bw);
+    return true;
+  }
+
+  /* bve = 2^j * m, m odd (covers bve = 2^j with m = 1) */
+  i = native_ctz (bvmul, bw);
+  j = native_ctz (bve, bw);
+  if (i < j) return false;
+  *res = bvmul >> j;
+  if (bve & (bve - 1))
+    *res = (*res * native_mod_inverse (bve >> j, bw)) & native_ones (bw);
+  for (i = 0; i < j; i++)
+    *res = native_set_bit (
+        *res, bw - 1 - i, btor_rng_pick_rand (&btor->rng, 0, 1));
+  return true;
+}
+
+static bool
+inv_udiv_native (Btor *btor,
+                 uint64_t bvudiv,
+                 uint64_t bve,
+                 uint32_t bw,
+                 int32_t eidx,
+                 uint64_t *res)
+{
+  uint64_t bvmax, lo, up;
+
+  bvmax = native_ones (bw);
+
+  if (eidx)
+  {
+    if (bvudiv == bvmax)
+    {
+      *res = bve == bvudiv && btor_rng_pick_with_prob (&btor->rng, 500);
+      return true;
+    }
+    if (!bvudiv)
+    {
+      if (bve == bvmax) return false;
+      *res = native_random_range (btor, bw, bve + 1, bvmax);
+      return true;
+    }
+    if (bve < bvudiv) return false;
+    if (bve % bvudiv == 0 && btor_rng_pick_with_prob (&btor->rng, 500))
+    {
+      *res = bve / bvudiv;
+      return true;
+    }
+    up = bve / bvudiv;
+    lo = bve / (bvudiv + 1) + 1;
+    if (lo > up) return false;
+    *res = native_random_range (btor, bw, lo, up);
+    return true;
+  }
+
+  if (bvudiv == bvmax)
+  {
+    if (bve == 1)
+      *res = bvmax;
+    else if (!bve)
+      *res = native_random (btor, bw);
+    else
+      return false;
+    return true;
+  }
+  if (!bve || native_is_umulo (bve, bvudiv, bw)) return false;
+  if (btor_rng_pick_with_prob (&btor->rng, 500))
+  {
+    *res = bve * bvudiv;
+    return true;
+  }
+  lo = bve * bvudiv;
+  up = native_is_umulo (bve, bvudiv + 1, bw) ? bvmax
+                                             : bve * (bvudiv + 1) - 1;
+  *res = native_random_range (btor, bw, lo, up);
+  return true;
+}
+
+static bool
+inv_urem_native (Btor *btor,
+                 uint64_t bvurem,
+                 uint64_t bve,
+                 uint32_t bw,
+                 int32_t eidx,
+                 uint64_t *res)
+{
+  uint32_t cnt;
+  uint64_t bvmax, sub, up, n, mul;
+
+  bvmax = native_ones (bw);
+
+  if (eidx)
+  {
+    if (bvurem == bvmax)
+    {
+      if (bve != bvmax) return false;
+      *res = 0;
+      return true;
+    }
+    if (bve == bvurem)
+    {
+      *res = btor_rng_pick_with_prob (&btor->rng, 250)
+                 ? 0
+                 : native_random_range (btor, bw, bvurem + 1, bvmax);
+      return true;
+    }
+    if (bve < bvurem) return false;
+    /* bvurem = bve - 1 -> not possible if bvurem > 0 */
+    if (bvurem && bvurem == bve - 1) return false;
+    sub = bve - bvurem;
+    if (sub <= bvurem) return false;
+    if (btor_rng_pick_with_prob (&btor->rng, 500))
+    {
+      *res = sub;
+      return true;
+    }
+    if (!bvurem)
+      up = bve;
+    else
+      up = sub % bvurem ? sub / bvurem : sub / bvurem - 1;
+    if (!up)
+    {
+      *res = sub;
+      return true;
+    }
+    /* choose 1 <= n <= up randomly s.t (bve - bvurem) % n = 0 */
+    n = native_random_range (btor, bw, 1, up);
+    for (cnt = 0; cnt < bw && sub % n; cnt++)
+      n = native_random_range (btor, bw, 1, up);
+    *res = sub % n ? sub : sub / n;
+    return true;
+  }
+
+  if (!bve)
+  {
+    *res = bvurem;
+    return true;
+  }
+  if ((bvurem && bve == 1) || bvurem == bvmax || bve <= bvurem) return false;
+  /* choose simplest solution (res = bvurem) with prob 0.5, or if there is
+   * an overflow for n = 1 */
+  if (btor_rng_pick_with_prob (&btor->rng, 500) || bvmax - bve < bvurem)
+  {
+    *res = bvurem;
+    return true;
+  }
+  /* res = bve * n + bvurem, with n s.t. (bve * n + bvurem) does not overflow */
+  n = native_random_range (btor, bw, 1, bvmax);
+  while (native_is_umulo (bve, n, bw))
+    n = native_random_range (btor, bw, 1, n - 1);
+  mul = bve * n;
+  if (bvmax - mul < bvurem)
+  {
+    n   = native_random_range (btor, bw, 1, n - 1);
+    mul = bve * n;
+  }
+  *res = mul + bvurem;
+  return true;
+}
+
 /* ========================================================================== */
 /* Consistent value computation                                               */
 /* ========================================================================== */
@@ -1222,8 +1649,13 @@ cons_mul_bv (Btor *btor,
     BTOR_PROP_SOLVER (btor)->stats.props_cons += 1;
   }
 
-  mm  = btor->mm;
-  bw  = btor_bv_get_width (bvmul);
+  mm = btor->mm;
+  bw = btor_bv_get_width (bvmul);
+
+  if (bw <= BTOR_PROPUTILS_NATIVE_BW)
+    return btor_bv_uint64_to_bv (
+        mm, cons_mul_native (btor, btor_bv_to_uint64 (bvmul), bw), bw);
+
   res = btor_bv_new_random (mm, &btor->rng, bw);
   if (!btor_bv_is_zero (bvmul))
   {
@@ -1301,12 +1733,6 @@ cons_udiv_bv (Btor *btor,
   BtorBitVector *res, *tmp, *tmpbve, *zero, *one, *bvmax;
   BtorMemMgr *mm;
 
-  mm    = btor->mm;
-  bw    = btor_bv_get_width (bvudiv);
-  zero  = btor_bv_new (mm, bw);
-  one   = btor_bv_one (mm, bw);
-  bvmax = btor_bv_ones (mm, bw);
-
   (void) udiv;
   (void) bve;
 
@@ -1318,6 +1744,19 @@ cons_udiv_bv (Btor *btor,
     BTOR_PROP_SOLVER (btor)->stats.props_cons += 1;
   }
 
+  mm = btor->mm;
+  bw = btor_bv_get_width (bvudiv);
+
+  if (bw <= BTOR_PROPUTILS_NATIVE_BW)
+    return btor_bv_uint64_to_bv (
+        mm,
+        cons_udiv_native (btor, btor_bv_to_uint64 (bvudiv), bw, eidx),
+        bw);
+
+  zero  = btor_bv_new (mm, bw);
+  one   = btor_bv_one (mm, bw);
+  bvmax = btor_bv_ones (mm, bw);
+
   if (eidx)
   {
     /* -> bvudiv = 1...1 then res = 0 or res = 1
@@ -1403,8 +1842,15 @@ cons_urem_bv (Btor *btor,
 #endif
     BTOR_PROP_SOLVER (btor)->stats.props_cons += 1;
   }
-  mm    = btor->mm;
-  bw    = btor_bv_get_width (bvurem);
+  mm = btor->mm;
+  bw = btor_bv_get_width (bvurem);
+
+  if (bw <= BTOR_PROPUTILS_NATIVE_BW)
+    return btor_bv_uint64_to_bv (
+        mm,
+        cons_urem_native (btor, btor_bv_to_uint64 (bvurem), bw, eidx),
+        bw);
+
   bvmax = btor_bv_ones (mm, bw);
 
   if (eidx)
@@ -1724,7 +2170,14 @@ inv_add_bv (Btor *btor,
   }
 
   /* res + bve = bve + res = bvadd -> res = bvadd - bve */
-  res = btor_bv_sub (btor->mm, bvadd, bve);
+  if (btor_bv_get_width (bvadd) <= BTOR_PROPUTILS_NATIVE_BW)
+    res = btor_bv_uint64_to_bv (
+        btor->mm,
+        (btor_bv_to_uint64 (bvadd) - btor_bv_to_uint64 (bve))
+            & native_ones (btor_bv_get_width (bvadd)),
+        btor_bv_get_width (bvadd));
+  else
+    res = btor_bv_sub (btor->mm, bvadd, bve);
 #ifndef NDEBUG
   check_result_binary_dbg (btor, btor_bv_add, add, bve, bvadd, res, eidx, "+");
 #endif
@@ -2037,6 +2490,7 @@ inv_sll_bv (Btor *btor,
   assert (!btor_node_is_bv_const (sll->e[eidx]));
 
   uint32_t i, j, ctz_bve, ctz_bvsll, shift, bw;
+  uint64_t r;
   BtorNode *e;
   BtorBitVector *res, *tmp, *bvmax;
   BtorMemMgr *mm;
@@ -2058,7 +2512,27 @@ inv_sll_bv (Btor *btor,
   bw = btor_bv_get_width (bvsll);
 
   res = 0;
-  bw        = btor_bv_get_width (bvsll);
+  bw  = btor_bv_get_width (bvsll);
+
+  if (bw <= BTOR_PROPUTILS_NATIVE_BW)
+  {
+    if (inv_sll_native (btor,
+                        btor_bv_to_uint64 (bvsll),
+                        btor_bv_to_uint64 (bve),
+                        bw,
+                        eidx,
+                        &r))
+      res = btor_bv_uint64_to_bv (mm, r, bw);
+    else
+    {
+      res = res_rec_conf (btor, sll, e, bvsll, bve, eidx, cons_sll_bv, "<<");
+#ifndef NDEBUG
+      is_inv = false;
+#endif
+    }
+    goto DONE;
+  }
+
   ctz_bvsll = btor_bv_get_num_trailing_zeros (bvsll);
 
   /* ------------------------------------------------------------------------
@@ -2156,6 +2630,7 @@ inv_sll_bv (Btor *btor,
                        btor_rng_pick_rand (&btor->rng, 0, 1));
     }
   }
+DONE:
 #ifndef NDEBUG
   if (is_inv)
     check_result_binary_dbg (
@@ -2188,6 +2663,7 @@ inv_srl_bv (Btor *btor,
   assert (!btor_node_is_bv_const (srl->e[eidx]));
 
   uint32_t i, j, clz_bve, clz_bvsrl, shift, bw;
+  uint64_t r;
   BtorNode *e;
   BtorBitVector *res, *bvmax, *tmp;
   BtorMemMgr *mm;
@@ -2209,7 +2685,27 @@ inv_srl_bv (Btor *btor,
   bw = btor_bv_get_width (bvsrl);
 
   res = 0;
-  bw        = btor_bv_get_width (bvsrl);
+  bw  = btor_bv_get_width (bvsrl);
+
+  if (bw <= BTOR_PROPUTILS_NATIVE_BW)
+  {
+    if (inv_srl_native (btor,
+                        btor_bv_to_uint64 (bvsrl),
+                        btor_bv_to_uint64 (bve),
+                        bw,
+                        eidx,
+                        &r))
+      res = btor_bv_uint64_to_bv (mm, r, bw);
+    else
+    {
+      res = res_rec_conf (btor, srl, e, bvsrl, bve, eidx, cons_srl_bv, ">>");
+#ifndef NDEBUG
+      is_inv = false;
+#endif
+    }
+    goto DONE;
+  }
+
   clz_bvsrl = btor_bv_get_num_leading_zeros (bvsrl);
 
   /* ------------------------------------------------------------------------
@@ -2310,6 +2806,7 @@ inv_srl_bv (Btor *btor,
     }
   }
 
+DONE:
 #ifndef NDEBUG
   if (is_inv)
     check_result_binary_dbg (
@@ -2343,6 +2840,7 @@ inv_mul_bv (Btor *btor,
 
   int32_t lsbve, lsbvmul, ispow2_bve;
   uint32_t i, j, bw;
+  uint64_t r;
   BtorBitVector *res, *inv, *tmp, *tmp2;
   BtorMemMgr *mm;
   BtorNode *e;
@@ -2365,6 +2863,24 @@ inv_mul_bv (Btor *btor,
 
   res = 0;
 
+  if (bw <= BTOR_PROPUTILS_NATIVE_BW)
+  {
+    if (inv_mul_native (btor,
+                        btor_bv_to_uint64 (bvmul),
+                        btor_bv_to_uint64 (bve),
+                        bw,
+                        &r))
+      res = btor_bv_uint64_to_bv (mm, r, bw);
+    else
+    {
+      res = res_rec_conf (btor, mul, e, bvmul, bve, eidx, cons_mul_bv, "*");
+#ifndef NDEBUG
+      is_inv = false;
+#endif
+    }
+    goto DONE;
+  }
+
   /* ------------------------------------------------------------------------
    * bve * res = bvmul
    *
@@ -2505,6 +3021,7 @@ inv_mul_bv (Btor *btor,
     }
   }
 
+DONE:
 #ifndef NDEBUG
   if (is_inv)
     check_result_binary_dbg (
@@ -2537,6 +3054,7 @@ inv_udiv_bv (Btor *btor,
   assert (!btor_node_is_bv_const (udiv->e[eidx]));
 
   uint32_t bw;
+  uint64_t r;
   BtorNode *e;
   BtorBitVector *res, *lo, *up, *one, *bvmax, *tmp;
   BtorMemMgr *mm;
@@ -2559,11 +3077,30 @@ inv_udiv_bv (Btor *btor,
   assert (e);
   bw = btor_bv_get_width (bve);
 
+  res = 0;
+
+  if (bw <= BTOR_PROPUTILS_NATIVE_BW)
+  {
+    if (inv_udiv_native (btor,
+                         btor_bv_to_uint64 (bvudiv),
+                         btor_bv_to_uint64 (bve),
+                         bw,
+                         eidx,
+                         &r))
+      res = btor_bv_uint64_to_bv (mm, r, bw);
+    else
+    {
+      res = res_rec_conf (btor, udiv, e, bvudiv, bve, eidx, cons_udiv_bv, "/");
+#ifndef NDEBUG
+      is_inv = false;
+#endif
+    }
+    goto DONE;
+  }
+
   one   = btor_bv_one (mm, bw);
   bvmax = btor_bv_ones (mm, bw); /* 2^bw - 1 */
 
-  res = 0;
-
   /* ------------------------------------------------------------------------
    * bve / e[1] = bvudiv
    *
@@ -2764,6 +3301,7 @@ inv_udiv_bv (Btor *btor,
 
   btor_bv_free (mm, bvmax);
   btor_bv_free (mm, one);
+DONE:
 #ifndef NDEBUG
   if (is_inv)
     check_result_binary_dbg (
@@ -2796,6 +3334,7 @@ inv_urem_bv (Btor *btor,
   assert (!btor_node_is_bv_const (urem->e[eidx]));
 
   uint32_t bw, cnt;
+  uint64_t r;
   int32_t cmp;
   BtorNode *e;
   BtorBitVector *res, *bvmax, *tmp, *tmp2, *one, *n, *mul, *up, *sub;
@@ -2818,11 +3357,30 @@ inv_urem_bv (Btor *btor,
 
   bw = btor_bv_get_width (bvurem);
 
+  res = 0;
+
+  if (bw <= BTOR_PROPUTILS_NATIVE_BW)
+  {
+    if (inv_urem_native (btor,
+                         btor_bv_to_uint64 (bvurem),
+                         btor_bv_to_uint64 (bve),
+                         bw,
+                         eidx,
+                         &r))
+      res = btor_bv_uint64_to_bv (mm, r, bw);
+    else
+    {
+      res = res_rec_conf (btor, urem, e, bvurem, bve, eidx, cons_urem_bv, "%");
+#ifndef NDEBUG
+      is_inv = false;
+#endif
+    }
+    goto DONE;
+  }
+
   bvmax = btor_bv_ones (mm, bw); /* 2^bw - 1 */
   one   = btor_bv_one (mm, bw);
 
-  res = 0;
-
   /* -----------------------------------------------------------------------
    * bve % e[1] = bvurem
    *
@@ -3100,6 +3658,7 @@ inv_urem_bv (Btor *btor,
   btor_bv_free (mm, one);
   btor_bv_free (mm, bvmax);
 
+DONE:
 #ifndef NDEBUG
   if (is_inv)
     check_result_binary_dbg (
@@ -3449,6 +4008,741 @@ inv_cond_bv (Btor *btor,
   return res;
 }
 
+/* ========================================================================== */
+/* Abstract domains (known bits and unsigned intervals)                       */
+/* ========================================================================== */
+
+static BtorPropDomain *
+new_domain (BtorMemMgr *mm,
+            BtorBitVector *lo,
+            BtorBitVector *hi,
+            BtorBitVector *umin,
+            BtorBitVector *umax)
+{
+  assert (mm);
+  assert (lo);
+  assert (hi);
+  assert (umin);
+  assert (umax);
+
+  BtorPropDomain *res;
+
+  BTOR_NEW (mm, res);
+  res->lo   = lo;
+  res->hi   = hi;
+  res->umin = umin;
+  res->umax = umax;
+  return res;
+}
+
+static BtorPropDomain *
+new_domain_full (BtorMemMgr *mm, uint32_t bw)
+{
+  return new_domain (mm,
+                     btor_bv_new (mm, bw),
+                     btor_bv_ones (mm, bw),
+                     btor_bv_new (mm, bw),
+                     btor_bv_ones (mm, bw));
+}
+
+static BtorPropDomain *
+new_domain_const (BtorMemMgr *mm, const BtorBitVector *bv)
+{
+  return new_domain (mm,
+                     btor_bv_copy (mm, bv),
+                     btor_bv_copy (mm, bv),
+                     btor_bv_copy (mm, bv),
+                     btor_bv_copy (mm, bv));
+}
+
+static void
+delete_domain (BtorMemMgr *mm, BtorPropDomain *d)
+{
+  assert (mm);
+  assert (d);
+
+  btor_bv_free (mm, d->lo);
+  btor_bv_free (mm, d->hi);
+  btor_bv_free (mm, d->umin);
+  btor_bv_free (mm, d->umax);
+  BTOR_DELETE (mm, d);
+}
+
+static bool
+is_domain_full (BtorPropDomain *d)
+{
+  assert (d);
+  return btor_bv_is_zero (d->lo) && btor_bv_is_ones (d->hi)
+         && btor_bv_is_zero (d->umin) && btor_bv_is_ones (d->umax);
+}
+
+static bool
+is_domain_fixed (BtorPropDomain *d)
+{
+  assert (d);
+  return btor_bv_compare (d->lo, d->hi) == 0;
+}
+
+static void
+domain_set_umin (BtorMemMgr *mm, BtorPropDomain *d, BtorBitVector *umin)
+{
+  btor_bv_free (mm, d->umin);
+  d->umin = umin;
+}
+
+static void
+domain_set_umax (BtorMemMgr *mm, BtorPropDomain *d, BtorBitVector *umax)
+{
+  btor_bv_free (mm, d->umax);
+  d->umax = umax;
+}
+
+/* Tighten the bounds of 'd' with its fixed bits and fix the bits of the
+ * common prefix of its bounds. */
+static void
+normalize_domain (BtorMemMgr *mm, BtorPropDomain *d)
+{
+  assert (mm);
+  assert (d);
+
+  uint32_t i, bw, n;
+  BtorBitVector *tmp;
+
+  if (btor_bv_compare (d->umin, d->lo) < 0)
+    domain_set_umin (mm, d, btor_bv_copy (mm, d->lo));
+  if (btor_bv_compare (d->umax, d->hi) > 0)
+    domain_set_umax (mm, d, btor_bv_copy (mm, d->hi));
+  assert (btor_bv_compare (d->umin, d->umax) <= 0);
+
+  bw  = btor_bv_get_width (d->lo);
+  tmp = btor_bv_xor (mm, d->umin, d->umax);
+  n   = btor_bv_get_num_leading_zeros (tmp);
+  btor_bv_free (mm, tmp);
+  for (i = 0; i < n; i++)
+  {
+    if (btor_bv_get_bit (d->umin, bw - 1 - i))
+      btor_bv_set_bit (d->lo, bw - 1 - i, 1);
+    else
+      btor_bv_set_bit (d->hi, bw - 1 - i, 0);
+  }
+}
+
+static BtorPropDomain *
+copy_domain (BtorMemMgr *mm, BtorPropDomain *d, bool inverted)
+{
+  assert (mm);
+  assert (d);
+
+  if (inverted)
+    return new_domain (mm,
+                       btor_bv_not (mm, d->hi),
+                       btor_bv_not (mm, d->lo),
+                       btor_bv_not (mm, d->umax),
+                       btor_bv_not (mm, d->umin));
+  return new_domain (mm,
+                     btor_bv_copy (mm, d->lo),
+                     btor_bv_copy (mm, d->hi),
+                     btor_bv_copy (mm, d->umin),
+                     btor_bv_copy (mm, d->umax));
+}
+
+static BtorPropDomain *
+get_domain (Btor *btor, BtorIntHashTable *domains, BtorNode *exp)
+{
+  assert (btor);
+  assert (domains);
+  assert (exp);
+
+  BtorHashTableData *d;
+
+  d = btor_hashint_map_get (domains, btor_node_real_addr (exp)->id);
+  assert (d);
+  return copy_domain (btor->mm, d->as_ptr, btor_node_is_inverted (exp));
+}
+
+static BtorPropDomain *
+compute_domain_add (BtorMemMgr *mm, BtorPropDomain *d0, BtorPropDomain *d1)
+{
+  BtorBitVector *slo, *shi, *k0, *k1, *ck0, *ck1, *known, *tmp, *tmp2;
+  BtorBitVector *lo, *hi, *umin, *umax;
+  bool omin, omax;
+
+  /* known bits: a result bit is fixed if both operand bits and the incoming
+   * carry are fixed, the carries are fixed if the sums of the minimal and
+   * maximal operand values agree */
+  slo = btor_bv_add (mm, d0->lo, d1->lo);
+  shi = btor_bv_add (mm, d0->hi, d1->hi);
+  tmp = btor_bv_xor (mm, d0->lo, d1->lo);
+  ck1 = btor_bv_xor (mm, slo, tmp);
+  btor_bv_free (mm, tmp);
+  tmp = btor_bv_xor (mm, d0->hi, d1->hi);
+  ck0 = btor_bv_xnor (mm, shi, tmp);
+  btor_bv_free (mm, tmp);
+  k0    = btor_bv_xnor (mm, d0->lo, d0->hi);
+  k1    = btor_bv_xnor (mm, d1->lo, d1->hi);
+  tmp   = btor_bv_or (mm, ck0, ck1);
+  tmp2  = btor_bv_and (mm, k0, k1);
+  known = btor_bv_and (mm, tmp, tmp2);
+  btor_bv_free (mm, tmp);
+  btor_bv_free (mm, tmp2);
+  lo  = btor_bv_and (mm, slo, known);
+  tmp = btor_bv_not (mm, known);
+  hi  = btor_bv_or (mm, shi, tmp);
+  btor_bv_free (mm, tmp);
+  btor_bv_free (mm, known);
+  btor_bv_free (mm, k0);
+  btor_bv_free (mm, k1);
+  btor_bv_free (mm, ck0);
+  btor_bv_free (mm, ck1);
+  btor_bv_free (mm, slo);
+  btor_bv_free (mm, shi);
+
+  /* interval: sound if both or none of the bounds overflow */
+  umin = btor_bv_add (mm, d0->umin, d1->umin);
+  umax = btor_bv_add (mm, d0->umax, d1->umax);
+  omin = btor_bv_compare (umin, d0->umin) < 0;
+  omax = btor_bv_compare (umax, d0->umax) < 0;
+  if (omin != omax)
+  {
+    btor_bv_free (mm, umin);
+    btor_bv_free (mm, umax);
+    umin = btor_bv_new (mm, btor_bv_get_width (lo));
+    umax = btor_bv_ones (mm, btor_bv_get_width (lo));
+  }
+  return new_domain (mm, lo, hi, umin, umax);
+}
+
+static BtorPropDomain *
+compute_domain_and (BtorMemMgr *mm, BtorPropDomain *d0, BtorPropDomain *d1)
+{
+  return new_domain (
+      mm,
+      btor_bv_and (mm, d0->lo, d1->lo),
+      btor_bv_and (mm, d0->hi, d1->hi),
+      btor_bv_new (mm, btor_bv_get_width (d0->lo)),
+      btor_bv_copy (mm,
+                    btor_bv_compare (d0->umax, d1->umax) < 0 ? d0->umax
+                                                               : d1->umax));
+}
+
+static BtorPropDomain *
+compute_domain_bool (BtorMemMgr *mm, bool is_true, bool is_false)
+{
+  BtorBitVector *bv;
+  BtorPropDomain *res;
+
+  assert (!is_true || !is_false);
+
+  if (is_true || is_false)
+  {
+    bv  = is_true ? btor_bv_one (mm, 1) : btor_bv_new (mm, 1);
+    res = new_domain_const (mm, bv);
+    btor_bv_free (mm, bv);
+    return res;
+  }
+  return new_domain_full (mm, 1);
+}
+
+static BtorPropDomain *
+compute_domain_eq (BtorMemMgr *mm, BtorPropDomain *d0, BtorPropDomain *d1)
+{
+  bool is_false;
+  BtorBitVector *tmp0, *tmp1;
+
+  /* a bit fixed to 1 in one operand is fixed to 0 in the other */
+  tmp0     = btor_bv_not (mm, d1->hi);
+  tmp1     = btor_bv_and (mm, d0->lo, tmp0);
+  is_false = !btor_bv_is_zero (tmp1);
+  btor_bv_free (mm, tmp0);
+  btor_bv_free (mm, tmp1);
+  if (!is_false)
+  {
+    tmp0     = btor_bv_not (mm, d0->hi);
+    tmp1     = btor_bv_and (mm, d1->lo, tmp0);
+    is_false = !btor_bv_is_zero (tmp1);
+    btor_bv_free (mm, tmp0);
+    btor_bv_free (mm, tmp1);
+  }
+  is_false = is_false || btor_bv_compare (d0->umax, d1->umin) < 0
+             || btor_bv_compare (d1->umax, d0->umin) < 0;
+
+  return compute_domain_bool (
+      mm,
+      !is_false && is_domain_fixed (d0) && is_domain_fixed (d1)
+          && btor_bv_compare (d0->lo, d1->lo) == 0,
+      is_false);
+}
+
+static BtorPropDomain *
+compute_domain_ult (BtorMemMgr *mm, BtorPropDomain *d0, BtorPropDomain *d1)
+{
+  return compute_domain_bool (mm,
+                              btor_bv_compare (d0->umax, d1->umin) < 0,
+                              btor_bv_compare (d0->umin, d1->umax) >= 0);
+}
+
+static BtorPropDomain *
+compute_domain_sll (BtorMemMgr *mm, BtorPropDomain *d0, BtorPropDomain *d1)
+{
+  uint32_t bw;
+  BtorBitVector *tmp, *umin, *umax;
+
+  bw = btor_bv_get_width (d0->lo);
+
+  if (is_domain_fixed (d1))
+  {
+    umin = btor_bv_sll (mm, d0->umin, d1->lo);
+    umax = btor_bv_sll (mm, d0->umax, d1->lo);
+    /* bounds are only preserved if no bits are shifted out */
+    tmp = btor_bv_srl (mm, umax, d1->lo);
+    if (btor_bv_compare (tmp, d0->umax))
+    {
+      btor_bv_free (mm, umin);
+      btor_bv_free (mm, umax);
+      umin = btor_bv_new (mm, bw);
+      umax = btor_bv_ones (mm, bw);
+    }
+    btor_bv_free (mm, tmp);
+    return new_domain (mm,
+                       btor_bv_sll (mm, d0->lo, d1->lo),
+                       btor_bv_sll (mm, d0->hi, d1->lo),
+                       umin,
+                       umax);
+  }
+
+  /* the lower bits are zero for the minimum shift */
+  tmp  = btor_bv_ones (mm, bw);
+  umax = btor_bv_sll (mm, tmp, d1->umin);
+  btor_bv_free (mm, tmp);
+  return new_domain (mm,
+                     btor_bv_new (mm, bw),
+                     umax,
+                     btor_bv_new (mm, bw),
+                     btor_bv_ones (mm, bw));
+}
+
+static BtorPropDomain *
+compute_domain_srl (BtorMemMgr *mm, BtorPropDomain *d0, BtorPropDomain *d1)
+{
+  uint32_t bw;
+
+  bw = btor_bv_get_width (d0->lo);
+
+  if (is_domain_fixed (d1))
+    return new_domain (mm,
+                       btor_bv_srl (mm, d0->lo, d1->lo),
+                       btor_bv_srl (mm, d0->hi, d1->lo),
+                       btor_bv_srl (mm, d0->umin, d1->lo),
+                       btor_bv_srl (mm, d0->umax, d1->lo));
+
+  /* monotone in the first and antitone in the second operand */
+  return new_domain (mm,
+                     btor_bv_new (mm, bw),
+                     btor_bv_ones (mm, bw),
+                     btor_bv_srl (mm, d0->umin, d1->umax),
+                     btor_bv_srl (mm, d0->umax, d1->umin));
+}
+
+static BtorPropDomain *
+compute_domain_mul (BtorMemMgr *mm, BtorPropDomain *d0, BtorPropDomain *d1)
+{
+  uint32_t bw, tz;
+  BtorBitVector *tmp, *hi, *umin, *umax;
+  BtorPropDomain *res;
+
+  bw = btor_bv_get_width (d0->lo);
+
+  if (is_domain_fixed (d0) && is_domain_fixed (d1))
+  {
+    tmp = btor_bv_mul (mm, d0->lo, d1->lo);
+    res = new_domain_const (mm, tmp);
+    btor_bv_free (mm, tmp);
+    return res;
+  }
+
+  /* the number of trailing zeros of the operands add up */
+  tz = btor_bv_get_num_trailing_zeros (d0->hi)
+       + btor_bv_get_num_trailing_zeros (d1->hi);
+  tmp = btor_bv_ones (mm, bw);
+  hi  = tz >= bw ? btor_bv_new (mm, bw) : btor_bv_sll_uint64 (mm, tmp, tz);
+  btor_bv_free (mm, tmp);
+
+  if (btor_bv_is_umulo (mm, d0->umax, d1->umax))
+  {
+    umin = btor_bv_new (mm, bw);
+    umax = btor_bv_ones (mm, bw);
+  }
+  else
+  {
+    umin = btor_bv_mul (mm, d0->umin, d1->umin);
+    umax = btor_bv_mul (mm, d0->umax, d1->umax);
+  }
+  return new_domain (mm, btor_bv_new (mm, bw), hi, umin, umax);
+}
+
+static BtorPropDomain *
+compute_domain_udiv (BtorMemMgr *mm, BtorPropDomain *d0, BtorPropDomain *d1)
+{
+  uint32_t bw;
+
+  bw = btor_bv_get_width (d0->lo);
+
+  /* division by zero yields ones */
+  if (btor_bv_is_zero (d1->umax))
+  {
+    BtorBitVector *ones = btor_bv_ones (mm, bw);
+    BtorPropDomain *res = new_domain_const (mm, ones);
+    btor_bv_free (mm, ones);
+    return res;
+  }
+  return new_domain (mm,
+                     btor_bv_new (mm, bw),
+                     btor_bv_ones (mm, bw),
+                     btor_bv_udiv (mm, d0->umin, d1->umax),
+                     btor_bv_is_zero (d1->umin)
+                         ? btor_bv_ones (mm, bw)
+                         : btor_bv_udiv (mm, d0->umax, d1->umin));
+}
+
+static BtorPropDomain *
+compute_domain_urem (BtorMemMgr *mm, BtorPropDomain *d0, BtorPropDomain *d1)
+{
+  uint32_t bw;
+  BtorBitVector *umax;
+
+  bw = btor_bv_get_width (d0->lo);
+
+  /* x % y = x if x < y (or if y = 0) */
+  if (btor_bv_compare (d0->umax, d1->umin) < 0) return copy_domain (mm, d0, 0);
+
+  /* x % y <= x and x % y < y if y > 0 */
+  if (btor_bv_is_zero (d1->umin) || btor_bv_compare (d0->umax, d1->umax) < 0)
+    umax = btor_bv_copy (mm, d0->umax);
+  else
+    umax = btor_bv_dec (mm, d1->umax);
+  return new_domain (mm,
+                     btor_bv_new (mm, bw),
+                     btor_bv_ones (mm, bw),
+                     btor_bv_new (mm, bw),
+                     umax);
+}
+
+static BtorPropDomain *
+compute_domain_concat (BtorMemMgr *mm, BtorPropDomain *d0, BtorPropDomain *d1)
+{
+  return new_domain (mm,
+                     btor_bv_concat (mm, d0->lo, d1->lo),
+                     btor_bv_concat (mm, d0->hi, d1->hi),
+                     btor_bv_concat (mm, d0->umin, d1->umin),
+                     btor_bv_concat (mm, d0->umax, d1->umax));
+}
+
+static BtorPropDomain *
+compute_domain_slice (BtorMemMgr *mm,
+                      BtorPropDomain *d0,
+                      uint32_t upper,
+                      uint32_t lower)
+{
+  uint32_t bw;
+
+  bw = upper - lower + 1;
+
+  /* bounds are only preserved when slicing off lower bits */
+  if (upper == btor_bv_get_width (d0->lo) - 1)
+    return new_domain (mm,
+                       btor_bv_slice (mm, d0->lo, upper, lower),
+                       btor_bv_slice (mm, d0->hi, upper, lower),
+                       btor_bv_slice (mm, d0->umin, upper, lower),
+                       btor_bv_slice (mm, d0->umax, upper, lower));
+  return new_domain (mm,
+                     btor_bv_slice (mm, d0->lo, upper, lower),
+                     btor_bv_slice (mm, d0->hi, upper, lower),
+                     btor_bv_new (mm, bw),
+                     btor_bv_ones (mm, bw));
+}
+
+static BtorPropDomain *
+compute_domain_cond (BtorMemMgr *mm,
+                     BtorPropDomain *d0,
+                     BtorPropDomain *d1,
+                     BtorPropDomain *d2)
+{
+  if (is_domain_fixed (d0))
+    return copy_domain (mm, btor_bv_is_true (d0->lo) ? d1 : d2, 0);
+  return new_domain (
+      mm,
+      btor_bv_and (mm, d1->lo, d2->lo),
+      btor_bv_or (mm, d1->hi, d2->hi),
+      btor_bv_copy (
+          mm, btor_bv_compare (d1->umin, d2->umin) < 0 ? d1->umin : d2->umin),
+      btor_bv_copy (
+          mm, btor_bv_compare (d1->umax, d2->umax) > 0 ? d1->umax : d2->umax));
+}
+
+static bool
+has_domain_transfer (BtorNode *exp)
+{
+  assert (exp);
+  assert (btor_node_is_regular (exp));
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_ADD_NODE:
+    case BTOR_BV_AND_NODE:
+    case BTOR_BV_EQ_NODE:
+    case BTOR_BV_ULT_NODE:
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+    case BTOR_BV_MUL_NODE:
+    case BTOR_BV_UDIV_NODE:
+    case BTOR_BV_UREM_NODE:
+    case BTOR_BV_CONCAT_NODE:
+    case BTOR_BV_SLICE_NODE: return true;
+    default: return btor_node_is_bv_cond (exp);
+  }
+}
+
+static BtorPropDomain *
+compute_domain (Btor *btor, BtorIntHashTable *domains, BtorNode *exp)
+{
+  assert (btor);
+  assert (domains);
+  assert (exp);
+  assert (btor_node_is_regular (exp));
+
+  uint32_t i;
+  BtorMemMgr *mm;
+  BtorPropDomain *res, *d[3];
+
+  mm = btor->mm;
+
+  if (btor_node_is_bv_const (exp))
+    return new_domain_const (mm, btor_node_bv_const_get_bits (exp));
+
+  if (!has_domain_transfer (exp))
+    return new_domain_full (mm, btor_node_bv_get_width (btor, exp));
+
+  for (i = 0; i < exp->arity; i++) d[i] = get_domain (btor, domains, exp->e[i]);
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_ADD_NODE: res = compute_domain_add (mm, d[0], d[1]); break;
+    case BTOR_BV_AND_NODE: res = compute_domain_and (mm, d[0], d[1]); break;
+    case BTOR_BV_EQ_NODE: res = compute_domain_eq (mm, d[0], d[1]); break;
+    case BTOR_BV_ULT_NODE: res = compute_domain_ult (mm, d[0], d[1]); break;
+    case BTOR_BV_SLL_NODE: res = compute_domain_sll (mm, d[0], d[1]); break;
+    case BTOR_BV_SRL_NODE: res = compute_domain_srl (mm, d[0], d[1]); break;
+    case BTOR_BV_MUL_NODE: res = compute_domain_mul (mm, d[0], d[1]); break;
+    case BTOR_BV_UDIV_NODE: res = compute_domain_udiv (mm, d[0], d[1]); break;
+    case BTOR_BV_UREM_NODE: res = compute_domain_urem (mm, d[0], d[1]); break;
+    case BTOR_BV_CONCAT_NODE:
+      res = compute_domain_concat (mm, d[0], d[1]);
+      break;
+    case BTOR_BV_SLICE_NODE:
+      res = compute_domain_slice (mm,
+                                  d[0],
+                                  btor_node_bv_slice_get_upper (exp),
+                                  btor_node_bv_slice_get_lower (exp));
+      break;
+    default:
+      assert (btor_node_is_bv_cond (exp));
+      res = compute_domain_cond (mm, d[0], d[1], d[2]);
+  }
+
+  for (i = 0; i < exp->arity; i++) delete_domain (mm, d[i]);
+
+  normalize_domain (mm, res);
+  return res;
+}
+
+BtorIntHashTable *
+btor_proputils_new_domains (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i;
+  BtorNode *cur, *real_cur;
+  BtorPtrHashTableIterator it;
+  BtorNodePtrStack visit, nodes;
+  BtorIntHashTable *res, *cache;
+  BtorHashTableData *d;
+  BtorMemMgr *mm;
+
+  mm    = btor->mm;
+  res   = btor_hashint_map_new (mm);
+  cache = btor_hashint_table_new (mm);
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_INIT_STACK (mm, nodes);
+
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (visit, btor_iter_hashptr_next (&it));
+
+  /* compute domains bottom-up */
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur      = BTOR_POP_STACK (visit);
+    real_cur = btor_node_real_addr (cur);
+
+    if (btor_hashint_map_contains (res, real_cur->id)) continue;
+
+    if (!btor_hashint_table_contains (cache, real_cur->id))
+    {
+      btor_hashint_table_add (cache, real_cur->id);
+      BTOR_PUSH_STACK (visit, real_cur);
+      if (has_domain_transfer (real_cur))
+        for (i = 0; i < real_cur->arity; i++)
+          BTOR_PUSH_STACK (visit, real_cur->e[i]);
+    }
+    else
+    {
+      btor_hashint_map_add (res, real_cur->id)->as_ptr =
+          compute_domain (btor, res, real_cur);
+      BTOR_PUSH_STACK (nodes, real_cur);
+    }
+  }
+
+  /* only keep domains that carry information */
+  while (!BTOR_EMPTY_STACK (nodes))
+  {
+    real_cur = BTOR_POP_STACK (nodes);
+    d        = btor_hashint_map_get (res, real_cur->id);
+    if (is_domain_full (d->as_ptr))
+    {
+      delete_domain (mm, d->as_ptr);
+      btor_hashint_map_remove (res, real_cur->id, 0);
+    }
+  }
+
+  BTOR_RELEASE_STACK (visit);
+  BTOR_RELEASE_STACK (nodes);
+  btor_hashint_table_delete (cache);
+  return res;
+}
+
+void
+btor_proputils_delete_domains (Btor *btor, BtorIntHashTable *domains)
+{
+  assert (btor);
+  assert (domains);
+
+  BtorIntHashTableIterator it;
+
+  btor_iter_hashint_init (&it, domains);
+  while (btor_iter_hashint_has_next (&it))
+    delete_domain (btor->mm, btor_iter_hashint_next_data (&it)->as_ptr);
+  btor_hashint_map_delete (domains);
+}
+
+static BtorIntHashTable *
+get_domains (Btor *btor)
+{
+  assert (btor);
+  assert (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP
+          || btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_SLS);
+
+  if (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP)
+    return BTOR_PROP_SOLVER (btor)->domains;
+  return BTOR_SLS_SOLVER (btor)->domains;
+}
+
+/* Check if 'bv' is in the domain of 'exp' (domains of regular nodes are
+ * stored, 'bv' is the value of 'exp' including its inversion). */
+static bool
+domain_contains (Btor *btor,
+                 BtorIntHashTable *domains,
+                 BtorNode *exp,
+                 BtorBitVector *bv)
+{
+  assert (btor);
+  assert (domains);
+  assert (exp);
+  assert (bv);
+
+  bool res;
+  BtorHashTableData *hd;
+  BtorPropDomain *d;
+  BtorBitVector *v, *tmp;
+
+  hd = btor_hashint_map_get (domains, btor_node_real_addr (exp)->id);
+  if (!hd) return true;
+  d = hd->as_ptr;
+
+  if (btor_bv_get_width (bv) <= 64)
+  {
+    uint32_t bw = btor_bv_get_width (bv);
+    uint64_t u  = btor_bv_to_uint64 (bv);
+    if (btor_node_is_inverted (exp))
+      u = ~u & (bw == 64 ? UINT64_MAX : ((uint64_t) 1 << bw) - 1);
+    return u >= btor_bv_to_uint64 (d->umin) && u <= btor_bv_to_uint64 (d->umax)
+           && (u & btor_bv_to_uint64 (d->hi)) == u
+           && (u | btor_bv_to_uint64 (d->lo)) == u;
+  }
+
+  v = btor_node_is_inverted (exp) ? btor_bv_not (btor->mm, bv) : bv;
+
+  res = btor_bv_compare (v, d->umin) >= 0 && btor_bv_compare (v, d->umax) <= 0;
+  if (res)
+  {
+    tmp = btor_bv_and (btor->mm, v, d->hi);
+    res = btor_bv_compare (tmp, v) == 0;
+    btor_bv_free (btor->mm, tmp);
+  }
+  if (res)
+  {
+    tmp = btor_bv_or (btor->mm, v, d->lo);
+    res = btor_bv_compare (tmp, v) == 0;
+    btor_bv_free (btor->mm, tmp);
+  }
+
+  if (v != bv) btor_bv_free (btor->mm, v);
+  return res;
+}
+
+/* Move 'bv' into the domain of 'exp' (clamp into its bounds and set its
+ * fixed bits). */
+static BtorBitVector *
+domain_project (Btor *btor,
+                BtorIntHashTable *domains,
+                BtorNode *exp,
+                BtorBitVector *bv)
+{
+  assert (btor);
+  assert (domains);
+  assert (exp);
+  assert (bv);
+
+  BtorHashTableData *hd;
+  BtorPropDomain *d;
+  BtorBitVector *v, *res, *tmp;
+
+  hd = btor_hashint_map_get (domains, btor_node_real_addr (exp)->id);
+  assert (hd);
+  d = hd->as_ptr;
+
+  v = btor_node_is_inverted (exp) ? btor_bv_not (btor->mm, bv) : bv;
+
+  if (btor_bv_compare (v, d->umin) < 0)
+    tmp = btor_bv_and (btor->mm, d->umin, d->hi);
+  else if (btor_bv_compare (v, d->umax) > 0)
+    tmp = btor_bv_and (btor->mm, d->umax, d->hi);
+  else
+    tmp = btor_bv_and (btor->mm, v, d->hi);
+  res = btor_bv_or (btor->mm, tmp, d->lo);
+  btor_bv_free (btor->mm, tmp);
+
+  if (v != bv)
+  {
+    btor_bv_free (btor->mm, v);
+    tmp = res;
+    res = btor_bv_not (btor->mm, tmp);
+    btor_bv_free (btor->mm, tmp);
+  }
+  return res;
+}
+
 /* ========================================================================== */
 /* Propagation move                                                           */
 /* ========================================================================== */
@@ -3474,6 +4768,18 @@ select_move (Btor *btor,
   assert (value);
 
   int32_t eidx, idx;
+  BtorIntHashTable *domains;
+  BtorBitVector *tmp;
+
+  domains = get_domains (btor);
+#ifndef NDEBUG
+  if (domains)
+  {
+    uint32_t i;
+    for (i = 0; i < exp->arity; i++)
+      assert (domain_contains (btor, domains, exp->e[i], bve[i]));
+  }
+#endif
 
   eidx = select_path (btor, exp, bvexp, bve);
   assert (eidx >= 0);
@@ -3482,6 +4788,40 @@ select_move (Btor *btor,
   idx = eidx ? 0
              : (btor_node_is_bv_slice (exp) || btor_node_is_cond (exp) ? 0 : 1);
   *value = compute_value (btor, exp, bvexp, bve[idx], eidx);
+
+  if (domains && *value
+      && !domain_contains (btor, domains, exp->e[eidx], *value))
+  {
+    /* the selected input can never produce the computed value, select the
+     * other input of a binary node if its value is feasible */
+    if (exp->arity == 2 && !btor_node_is_bv_const (exp->e[1 - eidx]))
+    {
+      tmp = compute_value (btor, exp, bvexp, bve[eidx], 1 - eidx);
+      if (tmp && domain_contains (btor, domains, exp->e[1 - eidx], tmp))
+      {
+        BTORLOG (2, "domain: select path e[%d]", 1 - eidx);
+        btor_bv_free (btor->mm, *value);
+        *value = tmp;
+        eidx   = 1 - eidx;
+        if (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP)
+          BTOR_PROP_SOLVER (btor)->stats.domain_paths += 1;
+        else
+          BTOR_SLS_SOLVER (btor)->stats.move_prop_domain_paths += 1;
+        return exp->e[eidx];
+      }
+      if (tmp) btor_bv_free (btor->mm, tmp);
+    }
+
+    /* else move the value into the domain of the selected input */
+    BTORLOG (2, "domain: project value of e[%d]", eidx);
+    tmp = domain_project (btor, domains, exp->e[eidx], *value);
+    btor_bv_free (btor->mm, *value);
+    *value = tmp;
+    if (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP)
+      BTOR_PROP_SOLVER (btor)->stats.domain_values += 1;
+    else
+      BTOR_SLS_SOLVER (btor)->stats.move_prop_domain_values += 1;
+  }
   return exp->e[eidx];
 }
 
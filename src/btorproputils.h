@@ -30,6 +30,30 @@ uint64_t btor_proputils_select_move_prop (Btor* btor,
                                           BtorNode** input,
                                           BtorBitVector** assignment);
 
+/**
+ * Over-approximation of the values a node can take under any assignment of
+ * its inputs. A bit i is fixed to 1 if lo[i] = 1, and fixed to 0 if
+ * hi[i] = 0.
+ */
+struct BtorPropDomain
+{
+  BtorBitVector* lo;
+  BtorBitVector* hi;
+  BtorBitVector* umin; /* unsigned lower bound */
+  BtorBitVector* umax; /* unsigned upper bound */
+};
+
+typedef struct BtorPropDomain BtorPropDomain;
+
+/**
+ * Compute the abstract domains (known bits and unsigned bounds) of all nodes
+ * in the cone of the current constraints and assumptions. Maps node ids to
+ * domains, nodes that may take any value are not contained.
+ */
+BtorIntHashTable* btor_proputils_new_domains (Btor* btor);
+
+void btor_proputils_delete_domains (Btor* btor, BtorIntHashTable* domains);
+
 /*------------------------------------------------------------------------*/
 
 #ifndef NDEBUG
@@ -112,6 +112,12 @@ melt (BtorSATMgr *smgr, int32_t lit)
   // TODO: else case warning?
 }
 
+static inline void
+phase (BtorSATMgr *smgr, int32_t lit)
+{
+  if (smgr->api.phase) smgr->api.phase (smgr, lit);
+}
+
 static inline int32_t
 repr (BtorSATMgr *smgr, int32_t lit)
 {
@@ -466,6 +472,16 @@ btor_sat_assume (BtorSATMgr *smgr, int32_t lit)
   assume (smgr, lit);
 }
 
+void
+btor_sat_phase (BtorSATMgr *smgr, int32_t lit)
+{
+  assert (smgr != NULL);
+  assert (smgr->initialized);
+  assert (lit);
+  assert (abs (lit) <= smgr->maxvar);
+  phase (smgr, lit);
+}
+
 int32_t
 btor_sat_failed (BtorSATMgr *smgr, int32_t lit)
 {
@@ -537,6 +553,13 @@ dimacs_printer_enable_verbosity (BtorSATMgr *smgr, int32_t level)
   return enable_verbosity (printer->smgr, level);
 }
 
+static void
+dimacs_printer_phase (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorCnfPrinter *printer = (BtorCnfPrinter *) smgr->solver;
+  phase (printer->smgr, lit);
+}
+
 static int32_t
 dimacs_printer_failed (BtorSATMgr *smgr, int32_t lit)
 {
@@ -728,6 +751,7 @@ enable_dimacs_printer (BtorSATMgr *smgr)
   smgr->api.inc_max_var      = dimacs_printer_inc_max_var;
   smgr->api.init             = dimacs_printer_init;
   smgr->api.melt             = dimacs_printer_melt;
+  smgr->api.phase            = dimacs_printer_phase;
   smgr->api.repr             = dimacs_printer_repr;
   smgr->api.reset            = dimacs_printer_reset;
   smgr->api.sat              = dimacs_printer_sat;
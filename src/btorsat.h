@@ -65,6 +65,7 @@ struct BtorSATMgr
     void (*melt) (BtorSATMgr *, int32_t);
     int32_t (*repr) (BtorSATMgr *, int32_t);
     void (*reset) (BtorSATMgr *);           /* required */
+    void (*phase) (BtorSATMgr *, int32_t);
     int32_t (*sat) (BtorSATMgr *, int32_t); /* required */
     void (*set_output) (BtorSATMgr *, FILE *);
     void (*set_prefix) (BtorSATMgr *, const char *);
@@ -143,6 +144,12 @@ void btor_sat_add (BtorSATMgr *smgr, int32_t lit);
  */
 void btor_sat_assume (BtorSATMgr *smgr, int32_t lit);
 
+/* Sets the preferred phase of the variable of a literal, i.e., the SAT
+ * solver first decides 'lit' on this variable.
+ * Ignored if the SAT solver does not support this.
+ */
+void btor_sat_phase (BtorSATMgr *smgr, int32_t lit);
+
 /* Checks whether an assumption failed during
  * the last SAT solver call 'btor_sat_check_sat'.
  */
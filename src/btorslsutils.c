@@ -354,79 +354,6 @@ btor_slsutils_compute_score_node (Btor *btor,
   return res;
 }
 
-static double
-recursively_compute_sls_score_node (Btor *btor,
-                                    BtorIntHashTable *bv_model,
-                                    BtorIntHashTable *fun_model,
-                                    BtorIntHashTable *score,
-                                    BtorNode *exp)
-{
-  assert (btor);
-  assert (bv_model);
-  assert (fun_model);
-  assert (score);
-  assert (exp);
-
-  uint32_t i;
-  double res;
-  BtorNode *cur, *real_cur;
-  BtorNodePtrStack stack;
-  BtorIntHashTable *mark;
-  BtorHashTableData *d;
-  BtorMemMgr *mm;
-
-  res = 0.0;
-  assert (btor_node_is_bv_eq (exp) || btor_node_is_bv_ult (exp)
-          || btor_node_bv_get_width (btor, exp) == 1);
-
-  if (btor_hashint_map_contains (score, btor_node_get_id (exp)))
-    return btor_hashint_map_get (score, btor_node_get_id (exp))->as_dbl;
-
-  mm = btor->mm;
-  BTOR_INIT_STACK (mm, stack);
-  mark = btor_hashint_map_new (mm);
-
-  BTOR_PUSH_STACK (stack, exp);
-  while (!BTOR_EMPTY_STACK (stack))
-  {
-    cur      = BTOR_POP_STACK (stack);
-    real_cur = btor_node_real_addr (cur);
-    d        = btor_hashint_map_get (mark, real_cur->id);
-
-    if ((d && d->as_int == 1)
-        || btor_hashint_map_get (score, btor_node_get_id (cur)))
-      continue;
-
-    if (!d)
-    {
-      btor_hashint_map_add (mark, real_cur->id);
-      BTOR_PUSH_STACK (stack, cur);
-      for (i = 0; i < real_cur->arity; i++)
-        BTOR_PUSH_STACK (stack, real_cur->e[i]);
-    }
-    else
-    {
-      assert (d->as_int == 0);
-      d->as_int = 1;
-
-      if (btor_node_bv_get_width (btor, real_cur) != 1) continue;
-
-      res = btor_slsutils_compute_score_node (
-          btor, bv_model, fun_model, score, cur);
-
-      assert (!btor_hashint_map_contains (score, btor_node_get_id (cur)));
-      btor_hashint_map_add (score, btor_node_get_id (cur))->as_dbl = res;
-    }
-  }
-
-  BTOR_RELEASE_STACK (stack);
-  btor_hashint_map_delete (mark);
-
-  assert (btor_hashint_map_contains (score, btor_node_get_id (exp)));
-  assert (res == btor_hashint_map_get (score, btor_node_get_id (exp))->as_dbl);
-  return res;
-}
-
 /* -------------------------------------------------------------------------- */
 
 void
@@ -486,10 +413,14 @@ btor_slsutils_compute_sls_scores (Btor *btor,
       assert (d->as_int == 0);
       d->as_int = 1;
       if (btor_node_bv_get_width (btor, real_cur) != 1) continue;
-      (void) recursively_compute_sls_score_node (
-          btor, bv_model, fun_model, score, cur);
-      (void) recursively_compute_sls_score_node (
-          btor, bv_model, fun_model, score, btor_node_invert (cur));
+      /* children are visited first, i.e., their scores (both polarities)
+       * are already computed */
+      btor_hashint_map_add (score, btor_node_get_id (cur))->as_dbl =
+          btor_slsutils_compute_score_node (
+              btor, bv_model, fun_model, score, cur);
+      btor_hashint_map_add (score, -btor_node_get_id (cur))->as_dbl =
+          btor_slsutils_compute_score_node (
+              btor, bv_model, fun_model, score, btor_node_invert (cur));
     }
   }
 
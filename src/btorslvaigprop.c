@@ -243,6 +243,7 @@ sat_aigprop_solver (BtorAIGPropSolver *slv)
   slv->aprop->seed         = btor_opt_get (btor, BTOR_OPT_SEED);
   slv->aprop->use_restarts = btor_opt_get (btor, BTOR_OPT_AIGPROP_USE_RESTARTS);
   slv->aprop->use_bandit   = btor_opt_get (btor, BTOR_OPT_AIGPROP_USE_BANDIT);
+  slv->aprop->nsim_flips   = btor_opt_get (btor, BTOR_OPT_AIGPROP_NSIM_FLIPS);
 
   /* collect roots AIGs */
   roots = btor_hashint_table_new (btor->mm);
@@ -269,6 +270,8 @@ sat_aigprop_solver (BtorAIGPropSolver *slv)
   assert (sat_result == BTOR_RESULT_SAT);
   slv->stats.moves                  = slv->aprop->stats.moves;
   slv->stats.restarts               = slv->aprop->stats.restarts;
+  slv->stats.sim_moves              = slv->aprop->stats.sim_moves;
+  slv->time.aprop_sim               = slv->aprop->time.sim;
   slv->time.aprop_sat               = slv->aprop->time.sat;
   slv->time.aprop_update_cone       = slv->aprop->time.update_cone;
   slv->time.aprop_update_cone_reset = slv->aprop->time.update_cone_reset;
@@ -305,6 +308,11 @@ print_stats_aigprop_solver (BtorAIGPropSolver *slv)
             1,
             "moves per second: %.2f",
             (double) slv->stats.moves / slv->time.aprop_sat);
+  if (btor_opt_get (btor, BTOR_OPT_AIGPROP_NSIM_FLIPS))
+    BTOR_MSG (btor->msg,
+              1,
+              "moves selected via simulation: %u",
+              slv->stats.sim_moves);
 }
 
 static void
@@ -337,6 +345,11 @@ print_time_stats_aigprop_solver (BtorAIGPropSolver *slv)
               1,
               "%.2f seconds for updating cone (compute score)",
               slv->time.aprop_update_cone_compute_score);
+  if (btor_opt_get (btor, BTOR_OPT_AIGPROP_NSIM_FLIPS))
+    BTOR_MSG (btor->msg,
+              1,
+              "%.2f seconds for simulating flips",
+              slv->time.aprop_sim);
   BTOR_MSG (btor->msg, 1, "");
 }
 
@@ -25,6 +25,7 @@ struct BtorAIGPropSolver
   {
     uint32_t moves;
     uint32_t restarts;
+    uint32_t sim_moves;
   } stats;
   struct
   {
@@ -33,6 +34,7 @@ struct BtorAIGPropSolver
     double aprop_update_cone_reset;
     double aprop_update_cone_model_gen;
     double aprop_update_cone_compute_score;
+    double aprop_sim;
   } time;
 };
 
@@ -53,6 +53,9 @@ clone_fun_solver (Btor *clone, BtorFunSolver *slv, BtorNodeMap *exp_map)
 
   btor_clone_node_ptr_stack (
       clone->mm, &slv->cur_lemmas, &res->cur_lemmas, exp_map, false);
+  /* premises of current lemmas are only used for detecting subsumed lemmas
+   * within a refinement iteration and are not cloned */
+  res->cur_lemmas_prem = 0;
 
   if (slv->score)
   {
@@ -78,6 +81,18 @@ clone_fun_solver (Btor *clone, BtorFunSolver *slv, BtorNodeMap *exp_map)
     }
   }
 
+  if (slv->score_cache)
+    res->score_cache = btor_hashint_table_clone (clone->mm, slv->score_cache);
+  if (slv->score_cache_dp)
+    res->score_cache_dp =
+        btor_hashint_table_clone (clone->mm, slv->score_cache_dp);
+
+  /* the dual propagation clone is recreated on demand */
+  res->dp_clone       = 0;
+  res->dp_exp_map     = 0;
+  res->dp_root        = 0;
+  res->dp_constraints = 0;
+
   BTOR_INIT_STACK (clone->mm, res->stats.lemmas_size);
   if (BTOR_SIZE_STACK (slv->stats.lemmas_size) > 0)
   {
@@ -97,6 +112,42 @@ clone_fun_solver (Btor *clone, BtorFunSolver *slv, BtorNodeMap *exp_map)
   return res;
 }
 
+static void
+delete_dual_prop_clone (BtorFunSolver *slv)
+{
+  assert (slv);
+
+  if (!slv->dp_clone) return;
+
+  btor_nodemap_delete (slv->dp_exp_map);
+  if (slv->dp_root) btor_node_release (slv->dp_clone, slv->dp_root);
+  btor_delete (slv->dp_clone);
+  btor_hashint_table_delete (slv->dp_constraints);
+  slv->dp_clone       = 0;
+  slv->dp_exp_map     = 0;
+  slv->dp_root        = 0;
+  slv->dp_constraints = 0;
+}
+
+static void
+reset_lemmas_premises (Btor *btor)
+{
+  BtorFunSolver *slv;
+  BtorPtrHashTableIterator it;
+
+  slv = BTOR_FUN_SOLVER (btor);
+  if (!slv->cur_lemmas_prem) return;
+
+  btor_iter_hashptr_init (&it, slv->cur_lemmas_prem);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    btor_hashint_table_delete (it.bucket->data.as_ptr);
+    btor_node_release (btor, btor_iter_hashptr_next (&it));
+  }
+  btor_hashptr_table_delete (slv->cur_lemmas_prem);
+  slv->cur_lemmas_prem = 0;
+}
+
 static void
 delete_fun_solver (BtorFunSolver *slv)
 {
@@ -143,6 +194,12 @@ delete_fun_solver (BtorFunSolver *slv)
     }
     btor_hashptr_table_delete (slv->score);
   }
+  if (slv->score_cache) btor_hashint_table_delete (slv->score_cache);
+  if (slv->score_cache_dp) btor_hashint_table_delete (slv->score_cache_dp);
+
+  delete_dual_prop_clone (slv);
+
+  reset_lemmas_premises (btor);
 
   BTOR_RELEASE_STACK (slv->cur_lemmas);
   BTOR_RELEASE_STACK (slv->stats.lemmas_size);
@@ -331,29 +388,23 @@ get_bv_assignment (Btor *btor, BtorNode *exp)
 /*------------------------------------------------------------------------*/
 
 static Btor *
-new_exp_layer_clone_for_dual_prop (Btor *btor,
-                                   BtorNodeMap **exp_map,
-                                   BtorNode **root)
+new_exp_layer_clone_for_dual_prop (Btor *btor, BtorNodeMap **exp_map)
 {
   assert (btor);
   assert (btor->slv);
   assert (btor->slv->kind == BTOR_FUN_SOLVER_KIND);
   assert (exp_map);
-  assert (root);
 
-  double start;
   Btor *clone;
-  BtorNode *cur, *and;
   BtorPtrHashTableIterator it;
 
-  /* empty formula */
-  if (btor->unsynthesized_constraints->count == 0) return 0;
-
-  start = btor_util_time_stamp ();
-  clone = btor_clone_exp_layer (btor, exp_map, true);
+  /* Note: with non-destructive substitution, simplified nodes are not
+   *       proxies and their simplified expressions must not be cloned.  The
+   *       root of the clone is built from the simplified constraints of
+   *       'btor' (see get_dual_prop_clone). */
+  clone = btor_clone_exp_layer (btor, exp_map, false);
   assert (!clone->synthesized_constraints->count);
   assert (clone->embedded_constraints->count == 0);
-  assert (clone->unsynthesized_constraints->count);
 
   btor_opt_set (clone, BTOR_OPT_MODEL_GEN, 0);
   btor_opt_set (clone, BTOR_OPT_INCREMENTAL, 1);
@@ -369,18 +420,7 @@ new_exp_layer_clone_for_dual_prop (Btor *btor,
   btor_iter_hashptr_queue (&it, clone->assumptions);
   while (btor_iter_hashptr_has_next (&it))
   {
-    cur                                   = btor_iter_hashptr_next (&it);
-    btor_node_real_addr (cur)->constraint = 0;
-    if (!*root)
-    {
-      *root = btor_node_copy (clone, cur);
-    }
-    else
-    {
-      and = btor_exp_bv_and (clone, *root, cur);
-      btor_node_release (clone, *root);
-      *root = and;
-    }
+    btor_node_real_addr (btor_iter_hashptr_next (&it))->constraint = 0;
   }
 
   btor_iter_hashptr_init (&it, clone->unsynthesized_constraints);
@@ -397,12 +437,117 @@ new_exp_layer_clone_for_dual_prop (Btor *btor,
       btor_hashptr_table_new (clone->mm,
                               (BtorHashPtr) btor_node_hash_by_id,
                               (BtorCmpPtr) btor_node_compare_by_id);
-
-  BTOR_FUN_SOLVER (btor)->time.search_init_apps_cloning +=
-      btor_util_time_stamp () - start;
   return clone;
 }
 
+static void
+add_to_dual_prop_root (Btor *clone, BtorNode **root, BtorNode *exp)
+{
+  BtorNode *and;
+
+  if (!*root)
+  {
+    *root = btor_node_copy (clone, exp);
+  }
+  else
+  {
+    and = btor_exp_bv_and (clone, *root, exp);
+    btor_node_release (clone, *root);
+    *root = and;
+  }
+}
+
+/* Returns the dual propagation clone and sets 'root' to the conjunction of
+ * all constraints, lemmas and assumptions of the current call.
+ *
+ * The clone is kept alive across incremental calls.  Constraints that were
+ * added since the last call are rebuilt in the clone and conjoined to the
+ * root of the clone, assumptions only to the root of the current call.  The
+ * clone is only recreated if constraints included in its root have been
+ * simplified (and are therefore not asserted anymore) in the meantime. */
+static Btor *
+get_dual_prop_clone (Btor *btor, BtorNode **root)
+{
+  assert (btor);
+  assert (btor->slv);
+  assert (btor->slv->kind == BTOR_FUN_SOLVER_KIND);
+  assert (root);
+
+  double start;
+  uint32_t num_constraints;
+  int32_t id;
+  BtorFunSolver *slv;
+  BtorNode *cur, *ccur;
+  BtorPtrHashTableIterator it;
+
+  slv   = BTOR_FUN_SOLVER (btor);
+  *root = 0;
+
+  /* empty formula */
+  if (btor->synthesized_constraints->count == 0
+      && btor->unsynthesized_constraints->count == 0
+      && btor->assumptions->count == 0)
+    return 0;
+
+  start = btor_util_time_stamp ();
+
+  if (slv->dp_clone)
+  {
+    num_constraints = 0;
+    btor_iter_hashptr_init (&it, btor->synthesized_constraints);
+    btor_iter_hashptr_queue (&it, btor->unsynthesized_constraints);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      id = btor_node_get_id (btor_iter_hashptr_next (&it));
+      if (btor_hashint_table_contains (slv->dp_constraints, id))
+        num_constraints += 1;
+    }
+    if (num_constraints < slv->dp_constraints->count)
+    {
+      BTOR_MSG (btor->msg, 1, "constraints simplified, recreate dual clone");
+      delete_dual_prop_clone (slv);
+    }
+  }
+
+  if (!slv->dp_clone)
+  {
+    slv->dp_clone = new_exp_layer_clone_for_dual_prop (btor, &slv->dp_exp_map);
+    slv->dp_constraints = btor_hashint_table_new (btor->mm);
+    slv->stats.dp_clones++;
+  }
+
+  /* add new constraints */
+  btor_iter_hashptr_init (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->unsynthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    id  = btor_node_get_id (cur);
+    if (btor_hashint_table_contains (slv->dp_constraints, id)) continue;
+    btor_hashint_table_add (slv->dp_constraints, id);
+    ccur = btor_clone_recursively_rebuild_exp (
+        btor, slv->dp_clone, cur, slv->dp_exp_map, 0);
+    add_to_dual_prop_root (slv->dp_clone, &slv->dp_root, ccur);
+    btor_node_release (slv->dp_clone, ccur);
+  }
+
+  /* add assumptions of current call */
+  if (slv->dp_root) *root = btor_node_copy (slv->dp_clone, slv->dp_root);
+  btor_iter_hashptr_init (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur  = btor_iter_hashptr_next (&it);
+    ccur = btor_clone_recursively_rebuild_exp (
+        btor, slv->dp_clone, cur, slv->dp_exp_map, 0);
+    add_to_dual_prop_root (slv->dp_clone, root, ccur);
+    btor_node_release (slv->dp_clone, ccur);
+  }
+  assert (*root);
+
+  slv->time.search_init_apps_cloning += btor_util_time_stamp () - start;
+  return slv->dp_clone;
+}
+
 static void
 assume_inputs (Btor *btor,
                Btor *clone,
@@ -916,16 +1061,26 @@ add_lemma_to_dual_prop_clone (Btor *btor,
   assert (clone);
   assert (lemma);
 
-  BtorNode *clemma, *and;
+  BtorNode *clemma;
+  BtorFunSolver *slv;
+
+  slv = BTOR_FUN_SOLVER (btor);
+  assert (clone == slv->dp_clone);
 
   /* clone and rebuild lemma with rewrite level 0 (as we want the exact
    * expression) */
   clemma = btor_clone_recursively_rebuild_exp (btor, clone, lemma, exp_map, 0);
   assert (clemma);
-  and = btor_exp_bv_and (clone, *root, clemma);
+  /* lemmas are valid, keep them in the clone for subsequent calls */
+  add_to_dual_prop_root (clone, &slv->dp_root, clemma);
+  /* asserted lemmas are also added to the constraints of 'btor', mark them as
+   * already added to prevent adding them again in subsequent calls */
+  if (!slv->assume_lemmas
+      && !btor_hashint_table_contains (slv->dp_constraints,
+                                       btor_node_get_id (lemma)))
+    btor_hashint_table_add (slv->dp_constraints, btor_node_get_id (lemma));
+  add_to_dual_prop_root (clone, root, clemma);
   btor_node_release (clone, clemma);
-  btor_node_release (clone, *root);
-  *root = and;
 }
 
 /*------------------------------------------------------------------------*/
@@ -1414,6 +1569,147 @@ mk_premise (Btor *btor, BtorNode *args, BtorNode *prem[], uint32_t num_prem)
   return res;
 }
 
+/*------------------------------------------------------------------------*/
+
+/* Lemma minimization.
+ *
+ * Premises are collected as individual literals rather than nested
+ * conjunctions, deduplicated, stripped of constant true literals and sorted
+ * by id, such that lemmas with the same set of premises (and in particular
+ * shared argument equalities) map to the same term.  A lemma is skipped if
+ * a lemma with the same conclusion and a subset of its premises was already
+ * generated in the current refinement iteration. */
+
+static void
+push_premise_lit (Btor *btor,
+                  BtorNode *lit,
+                  BtorNodePtrStack *lits,
+                  BtorIntHashTable *cache)
+{
+  if (lit == btor->true_exp
+      || btor_hashint_table_contains (cache, btor_node_get_id (lit)))
+  {
+    btor_node_release (btor, lit);
+    return;
+  }
+  btor_hashint_table_add (cache, btor_node_get_id (lit));
+  BTOR_PUSH_STACK (*lits, lit);
+}
+
+static void
+push_premise_lits (Btor *btor,
+                   BtorNode *args,
+                   BtorNode *prem[],
+                   uint32_t num_prem,
+                   BtorNodePtrStack *lits,
+                   BtorIntHashTable *cache)
+{
+  uint32_t i;
+  BtorNode *cur, *lit;
+
+  for (i = 0; i < num_prem; i++)
+  {
+    cur = prem[i];
+    if (btor_node_is_args (cur))
+      lit = btor_node_invert (mk_equal_args (btor, args, cur));
+    else
+      lit = btor_node_copy (btor, cur);
+    push_premise_lit (btor, lit, lits, cache);
+  }
+}
+
+/* Remove premises of 'prem2' that also occur in 'prem1'.  Used for function
+ * congruence lemmas, where the arguments of both applies are equal, hence
+ * shared premises on the propagation path of the second apply are implied
+ * by the ones of the first apply. */
+static void
+remove_shared_premises (Btor *btor,
+                        BtorNodePtrStack *prem1,
+                        BtorNodePtrStack *prem2)
+{
+  uint32_t i, j;
+  BtorNode *cur;
+  BtorIntHashTable *cache;
+
+  cache = btor_hashint_table_new (btor->mm);
+  for (i = 0; i < BTOR_COUNT_STACK (*prem1); i++)
+    btor_hashint_table_add (cache,
+                            btor_node_get_id (BTOR_PEEK_STACK (*prem1, i)));
+
+  for (i = 0, j = 0; i < BTOR_COUNT_STACK (*prem2); i++)
+  {
+    cur = BTOR_PEEK_STACK (*prem2, i);
+    if (btor_hashint_table_contains (cache, btor_node_get_id (cur)))
+      btor_node_release (btor, cur);
+    else
+      prem2->start[j++] = cur;
+  }
+  prem2->top = prem2->start + j;
+  btor_hashint_table_delete (cache);
+}
+
+static bool
+is_subsumed_lemma (Btor *btor, BtorNode *con, BtorNodePtrStack *prem)
+{
+  bool res;
+  uint32_t i;
+  BtorFunSolver *slv;
+  BtorPtrHashBucket *b;
+  BtorIntHashTable *t, *cache;
+  BtorIntHashTableIterator it;
+
+  slv = BTOR_FUN_SOLVER (btor);
+  if (!slv->cur_lemmas_prem
+      || !(b = btor_hashptr_table_get (slv->cur_lemmas_prem, con)))
+    return false;
+
+  t = b->data.as_ptr;
+  if (t->count > BTOR_COUNT_STACK (*prem)) return false;
+
+  cache = btor_hashint_table_new (btor->mm);
+  for (i = 0; i < BTOR_COUNT_STACK (*prem); i++)
+    btor_hashint_table_add (cache,
+                            btor_node_get_id (BTOR_PEEK_STACK (*prem, i)));
+
+  res = true;
+  btor_iter_hashint_init (&it, t);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    if (!btor_hashint_table_contains (cache, btor_iter_hashint_next (&it)))
+    {
+      res = false;
+      break;
+    }
+  }
+  btor_hashint_table_delete (cache);
+  return res;
+}
+
+static void
+add_lemma_premises (Btor *btor, BtorNode *con, BtorNodePtrStack *prem)
+{
+  uint32_t i;
+  BtorFunSolver *slv;
+  BtorIntHashTable *t;
+
+  slv = BTOR_FUN_SOLVER (btor);
+  if (!slv->cur_lemmas_prem)
+    slv->cur_lemmas_prem =
+        btor_hashptr_table_new (btor->mm,
+                                (BtorHashPtr) btor_node_hash_by_id,
+                                (BtorCmpPtr) btor_node_compare_by_id);
+  else if (btor_hashptr_table_get (slv->cur_lemmas_prem, con))
+    return;
+
+  t = btor_hashint_table_new (btor->mm);
+  for (i = 0; i < BTOR_COUNT_STACK (*prem); i++)
+    btor_hashint_table_add (t, btor_node_get_id (BTOR_PEEK_STACK (*prem, i)));
+  btor_hashptr_table_add (slv->cur_lemmas_prem, btor_node_copy (btor, con))
+      ->data.as_ptr = t;
+}
+
+/*------------------------------------------------------------------------*/
+
 static void
 add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
 {
@@ -1430,8 +1726,9 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
   assert (!app2 || btor_node_is_regular (app2) || btor_node_is_apply (app2));
 
   double start;
-  uint32_t i, lemma_size = 1;
-  BtorIntHashTable *cache_app1, *cache_app2;
+  bool minimize;
+  uint32_t i, lemma_size = 1, num_prem = 0;
+  BtorIntHashTable *cache_app1, *cache_app2, *cache_lits;
   BtorNodePtrStack prem_app1, prem_app2, prem;
   BtorNode *value, *tmp, *and, *con, *lemma;
   BtorMemMgr *mm;
@@ -1440,8 +1737,10 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
   start      = btor_util_time_stamp ();
   mm         = btor->mm;
   slv        = BTOR_FUN_SOLVER (btor);
+  minimize   = btor_opt_get (btor, BTOR_OPT_FUN_LEMMA_MIN) != 0;
   cache_app1 = btor_hashint_table_new (mm);
   cache_app2 = btor_hashint_table_new (mm);
+  cache_lits = btor_hashint_table_new (mm);
   BTOR_INIT_STACK (mm, prem_app1);
   BTOR_INIT_STACK (mm, prem_app2);
   BTOR_INIT_STACK (mm, prem);
@@ -1449,26 +1748,58 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
   /* collect premise and conclusion */
 
   collect_premisses (btor, app1, fun, app1->e[1], &prem_app1, cache_app1);
-  tmp = mk_premise (
-      btor, app1->e[1], prem_app1.start, BTOR_COUNT_STACK (prem_app1));
-
-  BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
+  num_prem += BTOR_COUNT_STACK (prem_app1);
+  if (minimize)
+    push_premise_lits (btor,
+                       app1->e[1],
+                       prem_app1.start,
+                       BTOR_COUNT_STACK (prem_app1),
+                       &prem,
+                       cache_lits);
+  else
+  {
+    tmp = mk_premise (
+        btor, app1->e[1], prem_app1.start, BTOR_COUNT_STACK (prem_app1));
+    BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
+  }
   lemma_size += BTOR_COUNT_STACK (prem_app1);
 
   if (app2) /* function congruence axiom conflict */
   {
     collect_premisses (btor, app2, fun, app2->e[1], &prem_app2, cache_app2);
-    tmp = mk_premise (
-        btor, app2->e[1], prem_app2.start, BTOR_COUNT_STACK (prem_app2));
-
-    BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
-    BTOR_PUSH_STACK (prem, mk_equal_args (btor, app1->e[1], app2->e[1]));
+    num_prem += BTOR_COUNT_STACK (prem_app2) + 1;
+    if (minimize)
+    {
+      remove_shared_premises (btor, &prem_app1, &prem_app2);
+      push_premise_lits (btor,
+                         app2->e[1],
+                         prem_app2.start,
+                         BTOR_COUNT_STACK (prem_app2),
+                         &prem,
+                         cache_lits);
+      push_premise_lit (btor,
+                        mk_equal_args (btor, app1->e[1], app2->e[1]),
+                        &prem,
+                        cache_lits);
+    }
+    else
+    {
+      tmp = mk_premise (
+          btor, app2->e[1], prem_app2.start, BTOR_COUNT_STACK (prem_app2));
+      BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
+      BTOR_PUSH_STACK (prem, mk_equal_args (btor, app1->e[1], app2->e[1]));
+    }
     lemma_size += BTOR_COUNT_STACK (prem_app2);
     con = btor_exp_eq (btor, app1, app2);
   }
   else if (btor_node_is_update (fun)) /* read over write conflict */
   {
-    BTOR_PUSH_STACK (prem, mk_equal_args (btor, app1->e[1], fun->e[1]));
+    num_prem += 1;
+    tmp = mk_equal_args (btor, app1->e[1], fun->e[1]);
+    if (minimize)
+      push_premise_lit (btor, tmp, &prem, cache_lits);
+    else
+      BTOR_PUSH_STACK (prem, tmp);
     lemma_size += btor_node_args_get_arity (btor, app1->e[1]);
     con = btor_exp_eq (btor, app1, fun->e[2]);
   }
@@ -1488,16 +1819,47 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
                        app1->e[1],
                        &prem_app2,
                        cache_app2);
-
-    tmp = mk_premise (
-        btor, app1->e[1], prem_app2.start, BTOR_COUNT_STACK (prem_app2));
-
-    BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
+    num_prem += BTOR_COUNT_STACK (prem_app2);
+
+    if (minimize)
+      push_premise_lits (btor,
+                         app1->e[1],
+                         prem_app2.start,
+                         BTOR_COUNT_STACK (prem_app2),
+                         &prem,
+                         cache_lits);
+    else
+    {
+      tmp = mk_premise (
+          btor, app1->e[1], prem_app2.start, BTOR_COUNT_STACK (prem_app2));
+      BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
+    }
     lemma_size += BTOR_COUNT_STACK (prem_app2);
     con = btor_exp_eq (btor, app1, value);
     btor_node_release (btor, value);
   }
 
+  if (minimize)
+  {
+    qsort (prem.start,
+           BTOR_COUNT_STACK (prem),
+           sizeof (BtorNode *),
+           btor_node_compare_by_id_qsort_asc);
+    slv->stats.lemmas_minimized++;
+    slv->stats.lemmas_prem_orig += num_prem;
+    slv->stats.lemmas_prem_min += BTOR_COUNT_STACK (prem);
+
+    if (is_subsumed_lemma (btor, con, &prem))
+    {
+      BTORLOG (1, "skip subsumed lemma");
+      slv->stats.lemmas_subsumed++;
+      btor_node_release (btor, con);
+      goto CLEANUP;
+    }
+  }
+
+  if (minimize) add_lemma_premises (btor, con, &prem);
+
   /* create lemma */
   if (BTOR_EMPTY_STACK (prem))
     lemma = con;
@@ -1523,6 +1885,7 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
   btor_node_release (btor, lemma);
 
   /* cleanup */
+CLEANUP:
   for (i = 0; i < BTOR_COUNT_STACK (prem); i++)
     btor_node_release (btor, BTOR_PEEK_STACK (prem, i));
   for (i = 0; i < BTOR_COUNT_STACK (prem_app1); i++)
@@ -1534,6 +1897,7 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
   BTOR_RELEASE_STACK (prem);
   btor_hashint_table_delete (cache_app1);
   btor_hashint_table_delete (cache_app2);
+  btor_hashint_table_delete (cache_lits);
   BTOR_FUN_SOLVER (btor)->time.lemma_gen += btor_util_time_stamp () - start;
 }
 
@@ -1901,6 +2265,291 @@ propagate (Btor *btor,
   slv->time.prop += btor_util_time_stamp () - start;
 }
 
+/*------------------------------------------------------------------------*/
+
+/* Weak equivalence checking of array reads.
+ *
+ * Under the current model, array stores (update nodes and array lambdas)
+ * and array conditionals induce a forest over array terms, where each
+ * store is connected to its base array and each conditional to its selected
+ * branch.  A read a[i] is resolved by following this forest from 'a' until a
+ * store with an index equal to the value of 'i' (or a lambda that does not
+ * reduce to a read on its base array) is reached, or the walk ends in an
+ * array variable.  Two reads resolving to the same array variable at the
+ * same index value are weakly equivalent and have to agree on their value.
+ *
+ * Reads are grouped by index value, and resolved targets are cached per
+ * group for every node on the walked path, such that reads sharing a store
+ * chain are resolved in (amortized) constant time.  All conflicts are
+ * turned into lemmas in one pass. */
+
+struct BtorWeqGroup
+{
+  BtorIntHashTable *targets; /* maps array id to resolved target */
+  BtorIntHashTable *reads;   /* maps array variable id to first read */
+};
+
+typedef struct BtorWeqGroup BtorWeqGroup;
+
+static bool
+weq_is_read (Btor *btor, BtorNode *app)
+{
+  BtorNode *fun;
+
+  if (!btor_node_is_apply (app) || app->parameterized) return false;
+  fun = btor_node_get_simplified (btor, app->e[0]);
+  return btor_node_is_array (fun)
+         && btor_node_args_get_arity (btor, app->e[1]) == 1;
+}
+
+static void
+weq_push_reads (Btor *btor,
+                BtorNode *exp,
+                BtorNodePtrStack *reads,
+                BtorIntHashTable *cache)
+{
+  uint32_t i;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+
+  BTOR_INIT_STACK (btor->mm, visit);
+  BTOR_PUSH_STACK (visit, exp);
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (
+        btor_node_get_simplified (btor, BTOR_POP_STACK (visit)));
+
+    if (!cur->apply_below || cur->parameterized || btor_node_is_fun (cur)
+        || btor_node_is_fun_eq (cur)
+        || btor_hashint_table_contains (cache, cur->id))
+      continue;
+    btor_hashint_table_add (cache, cur->id);
+
+    if (btor_node_is_apply (cur))
+    {
+      if (weq_is_read (btor, cur)) BTOR_PUSH_STACK (*reads, cur);
+      BTOR_PUSH_STACK (visit, cur->e[1]);
+      continue;
+    }
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+  BTOR_RELEASE_STACK (visit);
+}
+
+/* Resolve 'read' within 'group' and returns the store, lambda or array
+ * variable its value is determined by. */
+static BtorNode *
+weq_resolve (Btor *btor,
+             BtorWeqGroup *group,
+             BtorNode *read,
+             BtorBitVector *idx,
+             BtorNodePtrStack *reads,
+             BtorIntHashTable *cache)
+{
+  bool match;
+  BtorNode *cur, *args, *res, *target;
+  BtorNodePtrStack path;
+  BtorBitVector *bv;
+  BtorHashTableData *d;
+
+  BTOR_INIT_STACK (btor->mm, path);
+  args = btor_node_get_simplified (btor, read->e[1]);
+  cur  = btor_node_get_simplified (btor, read->e[0]);
+  for (;;)
+  {
+    assert (btor_node_is_regular (cur));
+    assert (btor_node_is_fun (cur));
+
+    if ((d = btor_hashint_map_get (group->targets, cur->id)))
+    {
+      target = d->as_ptr;
+      break;
+    }
+    BTOR_PUSH_STACK (path, cur);
+
+    if (cur->parameterized || btor_node_is_uf (cur))
+    {
+      target = cur;
+      break;
+    }
+    else if (btor_node_is_update (cur))
+    {
+      weq_push_reads (btor, cur->e[1], reads, cache);
+      weq_push_reads (btor, cur->e[2], reads, cache);
+      bv    = get_bv_assignment (btor, cur->e[1]->e[0]);
+      match = btor_bv_compare (bv, idx) == 0;
+      btor_bv_free (btor->mm, bv);
+      if (match)
+      {
+        target = cur;
+        break;
+      }
+      cur = cur->e[0];
+    }
+    else if (btor_node_is_fun_cond (cur))
+    {
+      weq_push_reads (btor, cur->e[0], reads, cache);
+      bv  = get_bv_assignment (btor, cur->e[0]);
+      cur = btor_bv_is_true (bv) ? cur->e[1] : cur->e[2];
+      btor_bv_free (btor->mm, bv);
+    }
+    else
+    {
+      assert (btor_node_is_lambda (cur));
+      btor_beta_assign_args (btor, cur, args);
+      res = btor_beta_reduce_partial (btor, cur, 0);
+      btor_beta_unassign_params (btor, cur);
+      if (btor_node_is_regular (res) && btor_node_is_apply (res)
+          && res->e[1] == args)
+      {
+        cur = res->e[0];
+        btor_node_release (btor, res);
+        continue;
+      }
+      btor_node_release (btor, res);
+      target = cur;
+      break;
+    }
+    cur = btor_node_get_simplified (btor, cur);
+  }
+
+  while (!BTOR_EMPTY_STACK (path))
+  {
+    cur = BTOR_POP_STACK (path);
+    btor_hashint_map_add (group->targets, cur->id)->as_ptr = target;
+  }
+  BTOR_RELEASE_STACK (path);
+  return target;
+}
+
+static void
+check_weak_equivalence (Btor *btor, BtorNodePtrStack *init_apps)
+{
+  assert (btor);
+  assert (btor->slv);
+  assert (btor->slv->kind == BTOR_FUN_SOLVER_KIND);
+  assert (init_apps);
+
+  double start;
+  uint32_t i;
+  bool conflict;
+  BtorMemMgr *mm;
+  BtorFunSolver *slv;
+  BtorNode *read, *target, *value, *rep;
+  BtorNodePtrStack reads;
+  BtorIntHashTable *cache;
+  BtorPtrHashTable *groups;
+  BtorPtrHashTableIterator it;
+  BtorWeqGroup *group;
+  BtorBitVector *idx;
+  BtorHashTableData *d;
+  BtorPtrHashBucket *b;
+
+  start = btor_util_time_stamp ();
+  mm    = btor->mm;
+  slv   = BTOR_FUN_SOLVER (btor);
+
+  BTORLOG (1, "");
+  BTORLOG (1, "*** %s", __FUNCTION__);
+
+  BTOR_INIT_STACK (mm, reads);
+  cache  = btor_hashint_table_new (mm);
+  groups = btor_hashptr_table_new (
+      mm, (BtorHashPtr) btor_bv_hash, (BtorCmpPtr) btor_bv_compare);
+
+  for (i = 0; i < BTOR_COUNT_STACK (*init_apps); i++)
+    weq_push_reads (btor, BTOR_PEEK_STACK (*init_apps, i), &reads, cache);
+
+  while (!BTOR_EMPTY_STACK (reads))
+  {
+    read = BTOR_POP_STACK (reads);
+    assert (weq_is_read (btor, read));
+    slv->stats.weq_reads++;
+
+    idx = get_bv_assignment (
+        btor, btor_node_get_simplified (btor, read->e[1])->e[0]);
+    if ((b = btor_hashptr_table_get (groups, idx)))
+    {
+      btor_bv_free (mm, idx);
+      idx   = b->key;
+      group = b->data.as_ptr;
+    }
+    else
+    {
+      BTOR_NEW (mm, group);
+      group->targets = btor_hashint_map_new (mm);
+      group->reads   = btor_hashint_map_new (mm);
+      btor_hashptr_table_add (groups, idx)->data.as_ptr = group;
+    }
+    target = weq_resolve (btor, group, read, idx, &reads, cache);
+
+    conflict = false;
+    if (btor_node_is_update (target))
+    {
+      /* read over write conflict */
+      if (!equal_bv_assignments (read, target->e[2]))
+      {
+        slv->stats.beta_reduction_conflicts++;
+        add_lemma (btor, target, read, 0);
+        conflict = true;
+      }
+    }
+    else if (btor_node_is_lambda (target) && !target->parameterized)
+    {
+      btor_beta_assign_args (
+          btor, target, btor_node_get_simplified (btor, read->e[1]));
+      value = btor_beta_reduce_partial (btor, target, 0);
+      btor_beta_unassign_params (btor, target);
+      weq_push_reads (btor, value, &reads, cache);
+      /* beta reduction conflict */
+      if (!equal_bv_assignments (read, value))
+      {
+        slv->stats.beta_reduction_conflicts++;
+        add_lemma (btor, target, read, 0);
+        conflict = true;
+      }
+      btor_node_release (btor, value);
+    }
+    else if ((d = btor_hashint_map_get (group->reads, target->id)))
+    {
+      /* function congruence conflict */
+      rep = d->as_ptr;
+      if (!equal_bv_assignments (rep, read))
+      {
+        slv->stats.function_congruence_conflicts++;
+        add_lemma (btor, target, rep, read);
+        conflict = true;
+      }
+    }
+    else
+      btor_hashint_map_add (group->reads, target->id)->as_ptr = read;
+
+    if (conflict)
+    {
+      slv->stats.weq_conflicts++;
+      BTORLOG (1,
+               "weak equivalence conflict: %s at %s",
+               btor_util_node2string (read),
+               btor_util_node2string (target));
+    }
+  }
+
+  btor_iter_hashptr_init (&it, groups);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    group = it.bucket->data.as_ptr;
+    idx   = btor_iter_hashptr_next (&it);
+    btor_hashint_map_delete (group->targets);
+    btor_hashint_map_delete (group->reads);
+    BTOR_DELETE (mm, group);
+    btor_bv_free (mm, idx);
+  }
+  btor_hashptr_table_delete (groups);
+  btor_hashint_table_delete (cache);
+  BTOR_RELEASE_STACK (reads);
+  slv->time.weq += btor_util_time_stamp () - start;
+}
+
 /* generate hash table for function 'fun' consisting of all rho and static_rho
  * hash tables. */
 static BtorPtrHashTable *
@@ -2004,6 +2653,62 @@ generate_table (Btor *btor, BtorNode *fun, BtorNode **base_array)
   return table;
 }
 
+/* Tables generated for extensionality checking are shared between all
+ * function equalities over the same function within one consistency check
+ * (i.e., w.r.t. the current model). */
+
+struct BtorExtTable
+{
+  BtorPtrHashTable *table;
+  BtorNode *base;
+};
+
+typedef struct BtorExtTable BtorExtTable;
+
+static BtorPtrHashTable *
+get_ext_table (Btor *btor,
+               BtorIntHashTable *tables,
+               BtorNode *fun,
+               BtorNode **base_array)
+{
+  BtorExtTable *t;
+  BtorHashTableData *d;
+  BtorFunSolver *slv;
+
+  slv = BTOR_FUN_SOLVER (btor);
+
+  if ((d = btor_hashint_map_get (tables, btor_node_get_id (fun))))
+  {
+    slv->stats.ext_tables_reused++;
+    t = d->as_ptr;
+  }
+  else
+  {
+    slv->stats.ext_tables_generated++;
+    BTOR_NEW (btor->mm, t);
+    t->table = generate_table (btor, fun, &t->base);
+    btor_hashint_map_add (tables, btor_node_get_id (fun))->as_ptr = t;
+  }
+  *base_array = t->base;
+  return t->table;
+}
+
+static void
+delete_ext_tables (Btor *btor, BtorIntHashTable *tables)
+{
+  BtorExtTable *t;
+  BtorIntHashTableIterator it;
+
+  btor_iter_hashint_init (&it, tables);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    t = btor_iter_hashint_next_data (&it)->as_ptr;
+    btor_hashptr_table_delete (t->table);
+    BTOR_DELETE (btor->mm, t);
+  }
+  btor_hashint_map_delete (tables);
+}
+
 static void
 add_extensionality_lemmas (Btor *btor)
 {
@@ -2019,6 +2724,7 @@ add_extensionality_lemmas (Btor *btor)
   BtorNode *base0, *base1;
   BtorPtrHashTableIterator it;
   BtorPtrHashTable *table0, *table1, *conflicts;
+  BtorIntHashTable *tables;
   BtorPtrHashTableIterator hit;
   BtorNodePtrStack feqs, const_arrays;
   BtorMemMgr *mm;
@@ -2043,6 +2749,7 @@ add_extensionality_lemmas (Btor *btor)
   }
 
   BtorUnionFind *ufind = btor_ufind_new (btor->mm);
+  tables               = btor_hashint_map_new (mm);
 
   while (!BTOR_EMPTY_STACK (feqs))
   {
@@ -2057,8 +2764,8 @@ add_extensionality_lemmas (Btor *btor)
     if (skip) continue;
 
     base0 = base1 = 0;
-    table0        = generate_table (btor, cur->e[0], &base0);
-    table1        = generate_table (btor, cur->e[1], &base1);
+    table0        = get_ext_table (btor, tables, cur->e[0], &base0);
+    table1        = get_ext_table (btor, tables, cur->e[1], &base1);
 
     assert (base0);
     assert (base1);
@@ -2126,10 +2833,9 @@ add_extensionality_lemmas (Btor *btor)
       btor_node_release (btor, con);
     }
     btor_hashptr_table_delete (conflicts);
-    btor_hashptr_table_delete (table0);
-    btor_hashptr_table_delete (table1);
   }
   BTOR_RELEASE_STACK (feqs);
+  delete_ext_tables (btor, tables);
 
   /* No conflicts found. Check if we have positive (chains of) equalities over
    * constant arrays. */
@@ -2309,20 +3015,31 @@ check_and_resolve_conflicts (Btor *btor,
     push_unreachable_applies (btor, init_apps);
   }
 
-  for (i = BTOR_COUNT_STACK (*init_apps) - 1; i >= 0; i--)
+  /* check all reads against the weak equivalence graph first and only fall
+   * back to propagation if no conflicts were found */
+  if (btor_opt_get (btor, BTOR_OPT_FUN_WEAK_EQ))
   {
-    app = BTOR_PEEK_STACK (*init_apps, i);
-    assert (btor_node_is_regular (app));
-    assert (btor_node_is_apply (app));
-    assert (!app->parameterized);
-    assert (!app->propagated);
-    BTOR_PUSH_STACK (prop_stack, app);
-    BTOR_PUSH_STACK (prop_stack, app->e[0]);
-    BTORLOG (2, "push apply: %s", btor_util_node2string (app));
+    check_weak_equivalence (btor, init_apps);
+    found_conflicts = BTOR_COUNT_STACK (slv->cur_lemmas) > 0;
   }
 
-  propagate (btor, &prop_stack, cleanup_table, apply_search_cache);
-  found_conflicts = BTOR_COUNT_STACK (slv->cur_lemmas) > 0;
+  if (!found_conflicts)
+  {
+    for (i = BTOR_COUNT_STACK (*init_apps) - 1; i >= 0; i--)
+    {
+      app = BTOR_PEEK_STACK (*init_apps, i);
+      assert (btor_node_is_regular (app));
+      assert (btor_node_is_apply (app));
+      assert (!app->parameterized);
+      assert (!app->propagated);
+      BTOR_PUSH_STACK (prop_stack, app);
+      BTOR_PUSH_STACK (prop_stack, app->e[0]);
+      BTORLOG (2, "push apply: %s", btor_util_node2string (app));
+    }
+
+    propagate (btor, &prop_stack, cleanup_table, apply_search_cache);
+    found_conflicts = BTOR_COUNT_STACK (slv->cur_lemmas) > 0;
+  }
 
   /* check consistency of array/uf equalities */
   if (!found_conflicts && btor->feqs->count > 0)
@@ -2405,6 +3122,45 @@ reset_lemma_cache (BtorFunSolver *slv)
                                         (BtorCmpPtr) btor_node_compare_by_id);
 }
 
+/* Use the input assignment 'bv_model' of a failed prop/sls preprocessing
+ * run as phases of the SAT solver, i.e., the SAT solver starts its search
+ * close to the assignment found by the local search engine. */
+static void
+set_pre_phases (Btor *btor, BtorIntHashTable *bv_model)
+{
+  assert (btor);
+  assert (bv_model);
+
+  uint32_t i, width;
+  int32_t lit;
+  BtorNode *var;
+  BtorAIGVec *av;
+  BtorBitVector *bv;
+  BtorHashTableData *d;
+  BtorSATMgr *smgr;
+  BtorPtrHashTableIterator it;
+
+  smgr = btor_get_sat_mgr (btor);
+
+  btor_iter_hashptr_init (&it, btor->bv_vars);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    var = btor_iter_hashptr_next (&it);
+    if (!btor_node_is_bv_var (var) || !(av = var->av)) continue;
+    if (!(d = btor_hashint_map_get (bv_model, var->id))) continue;
+    bv    = d->as_ptr;
+    width = av->width;
+    assert (btor_bv_get_width (bv) == width);
+    for (i = 0; i < width; i++)
+    {
+      if (btor_aig_is_const (av->aigs[i])) continue;
+      if (!(lit = btor_aig_get_cnf_id (av->aigs[i]))) continue;
+      btor_sat_phase (smgr, btor_bv_get_bit (bv, width - 1 - i) ? lit : -lit);
+      BTOR_FUN_SOLVER (btor)->stats.pre_phases++;
+    }
+  }
+}
+
 static BtorSolverResult
 sat_fun_solver (BtorFunSolver *slv)
 {
@@ -2419,7 +3175,7 @@ sat_fun_solver (BtorFunSolver *slv)
   Btor *btor, *clone;
   BtorNode *clone_root, *lemma;
   BtorNodeMap *exp_map;
-  BtorIntHashTable *init_apps_cache;
+  BtorIntHashTable *init_apps_cache, *pre_model;
   BtorNodePtrStack init_apps;
 
   btor = slv->btor;
@@ -2433,6 +3189,7 @@ sat_fun_solver (BtorFunSolver *slv)
   clone      = 0;
   clone_root = 0;
   exp_map    = 0;
+  pre_model  = 0;
 
   if ((btor_opt_get (btor, BTOR_OPT_FUN_PREPROP)
        || btor_opt_get (btor, BTOR_OPT_FUN_PRESLS))
@@ -2475,6 +3232,13 @@ sat_fun_solver (BtorFunSolver *slv)
                 result == BTOR_RESULT_SAT ? "'sat'" : "'unsat'");
       goto DONE;
     }
+    /* keep input assignment of prop/sls engine until bv skeleton is
+     * encoded to CNF (used as SAT solver phases) */
+    if (btor_opt_get (btor, BTOR_OPT_FUN_PREPHASE))
+    {
+      pre_model      = btor->bv_model;
+      btor->bv_model = 0;
+    }
     /* reset */
     btor_model_delete (btor);
   }
@@ -2495,7 +3259,8 @@ sat_fun_solver (BtorFunSolver *slv)
   /* initialize dual prop clone */
   if (btor_opt_get (btor, BTOR_OPT_FUN_DUAL_PROP))
   {
-    clone = new_exp_layer_clone_for_dual_prop (btor, &exp_map, &clone_root);
+    clone   = get_dual_prop_clone (btor, &clone_root);
+    exp_map = slv->dp_exp_map;
   }
 
   while (true)
@@ -2520,6 +3285,11 @@ sat_fun_solver (BtorFunSolver *slv)
 
     /* make SAT call on bv skeleton */
     btor_add_again_assumptions (btor);
+    if (pre_model)
+    {
+      set_pre_phases (btor, pre_model);
+      btor_model_delete_bv (btor, &pre_model);
+    }
     result = timed_sat_sat (btor, slv->sat_limit);
 
     if (result == BTOR_RESULT_UNSAT)
@@ -2555,6 +3325,7 @@ sat_fun_solver (BtorFunSolver *slv)
         add_lemma_to_dual_prop_clone (btor, clone, &clone_root, lemma, exp_map);
     }
     BTOR_RESET_STACK (slv->cur_lemmas);
+    reset_lemmas_premises (btor);
 
     if (btor_opt_get (btor, BTOR_OPT_VERBOSITY))
     {
@@ -2574,15 +3345,14 @@ sat_fun_solver (BtorFunSolver *slv)
   }
 
 DONE:
+  btor_model_delete_bv (btor, &pre_model);
   BTOR_RELEASE_STACK (init_apps);
   btor_hashint_table_delete (init_apps_cache);
 
   if (clone)
   {
-    assert (exp_map);
-    btor_nodemap_delete (exp_map);
+    assert (clone == slv->dp_clone);
     btor_node_release (clone, clone_root);
-    btor_delete (clone);
   }
   return result;
 }
@@ -2650,11 +3420,31 @@ print_stats_fun_solver (BtorFunSolver *slv)
                 1,
                 "  %4d extensionality lemmas",
                 slv->stats.extensionality_lemmas);
+      if (slv->stats.ext_tables_generated)
+        BTOR_MSG (btor->msg,
+                  1,
+                  "    %4d/%d extensionality tables generated/reused",
+                  slv->stats.ext_tables_generated,
+                  slv->stats.ext_tables_reused);
       BTOR_MSG (btor->msg,
                 1,
                 "  %.1f average lemma size",
                 BTOR_AVERAGE_UTIL (slv->stats.lemmas_size_sum,
                                    slv->stats.lod_refinements));
+      if (slv->stats.lemmas_minimized)
+      {
+        BTOR_MSG (btor->msg,
+                  1,
+                  "  %.1f average lemma premises (%.1f before minimization)",
+                  BTOR_AVERAGE_UTIL (slv->stats.lemmas_prem_min,
+                                     slv->stats.lemmas_minimized),
+                  BTOR_AVERAGE_UTIL (slv->stats.lemmas_prem_orig,
+                                     slv->stats.lemmas_minimized));
+        BTOR_MSG (btor->msg,
+                  1,
+                  "  %4u subsumed lemmas skipped",
+                  slv->stats.lemmas_subsumed);
+      }
       for (i = 1; i < BTOR_SIZE_STACK (slv->stats.lemmas_size); i++)
       {
         if (!slv->stats.lemmas_size.start[i]) continue;
@@ -2677,6 +3467,23 @@ print_stats_fun_solver (BtorFunSolver *slv)
   BTOR_MSG (btor->msg, 1, "%7lld propagations", slv->stats.propagations);
   BTOR_MSG (
       btor->msg, 1, "%7lld propagations down", slv->stats.propagations_down);
+  if (slv->stats.pre_phases)
+    BTOR_MSG (btor->msg,
+              1,
+              "%7lld SAT phases set by prop/sls preprocessing",
+              slv->stats.pre_phases);
+
+  if (btor_opt_get (btor, BTOR_OPT_FUN_WEAK_EQ))
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "%7lld weak equivalence reads checked",
+              slv->stats.weq_reads);
+    BTOR_MSG (btor->msg,
+              1,
+              "%7lld weak equivalence conflicts",
+              slv->stats.weq_conflicts);
+  }
 
   if (btor_opt_get (btor, BTOR_OPT_FUN_DUAL_PROP))
   {
@@ -2690,6 +3497,7 @@ print_stats_fun_solver (BtorFunSolver *slv)
               "%d/%d dual prop. applies (failed/assumed)",
               slv->stats.dp_failed_applies,
               slv->stats.dp_assumed_applies);
+    BTOR_MSG (btor->msg, 1, "%d dual prop. clones", slv->stats.dp_clones);
   }
 }
 
@@ -2752,6 +3560,11 @@ print_time_stats_fun_solver (BtorFunSolver *slv)
               slv->time.search_init_apps_collect_fa_cone);
   }
 
+  if (btor_opt_get (btor, BTOR_OPT_FUN_WEAK_EQ))
+    BTOR_MSG (btor->msg,
+              1,
+              "  %.2f seconds weak equivalence checking",
+              slv->time.weq);
   BTOR_MSG (btor->msg, 1, "  %.2f seconds propagation", slv->time.prop);
   BTOR_MSG (
       btor->msg, 1, "    %.2f seconds expression evaluation", slv->time.eval);
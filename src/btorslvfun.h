@@ -11,7 +11,9 @@
 
 #include "btornode.h"
 #include "btorslv.h"
+#include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
+#include "utils/btornodemap.h"
 
 #define BTOR_FUN_SOLVER(btor) ((BtorFunSolver *) (btor)->slv)
 
@@ -21,8 +23,20 @@ struct BtorFunSolver
 
   BtorPtrHashTable *lemmas;
   BtorNodePtrStack cur_lemmas;
+  BtorPtrHashTable *cur_lemmas_prem; /* premises of current lemmas per
+                                        conclusion (lemma minimization) */
 
-  BtorPtrHashTable *score; /* dcr score */
+  /* dual propagation clone, kept alive across incremental calls */
+  Btor *dp_clone;
+  BtorNodeMap *dp_exp_map;
+  BtorNode *dp_root;                /* root of constraints and lemmas */
+  BtorIntHashTable *dp_constraints; /* constraints included in dp_root */
+
+  BtorPtrHashTable *score;          /* dcr score */
+  BtorIntHashTable *score_cache;    /* nodes already visited when computing
+                                       dcr scores */
+  BtorIntHashTable *score_cache_dp; /* nodes already visited when computing
+                                       dcr scores for dual prop */
 
   // TODO (ma): make options for these
   int32_t lod_limit;
@@ -37,10 +51,18 @@ struct BtorFunSolver
     uint32_t function_congruence_conflicts;
     uint32_t beta_reduction_conflicts;
     uint32_t extensionality_lemmas;
+    uint32_t ext_tables_generated; /* function tables for extensionality */
+    uint32_t ext_tables_reused;
 
     BtorUIntStack lemmas_size;      /* distribution of n-size lemmas */
     uint_least64_t lemmas_size_sum; /* sum of the size of all added lemmas */
 
+    uint32_t lemmas_minimized;       /* number of minimized lemmas */
+    uint32_t lemmas_subsumed;        /* number of skipped subsumed lemmas */
+    uint_least64_t lemmas_prem_orig; /* sum of premises before minimization */
+    uint_least64_t lemmas_prem_min;  /* sum of premises after minimization */
+
+    uint32_t dp_clones; /* number of created dual propagation clones */
     uint32_t dp_failed_vars; /* number of vars in FA (dual prop) of last
                                 sat call (final bv skeleton) */
     uint32_t dp_assumed_vars;
@@ -53,6 +75,10 @@ struct BtorFunSolver
     uint_least64_t eval_exp_calls;
     uint_least64_t propagations;
     uint_least64_t propagations_down;
+    uint_least64_t pre_phases; /* SAT phases set from prop/sls assignment */
+
+    uint_least64_t weq_reads;     /* reads checked via weak equivalence */
+    uint_least64_t weq_conflicts; /* conflicts found via weak equivalence */
   } stats;
 
   struct
@@ -75,6 +101,7 @@ struct BtorFunSolver
     double find_conf_app;
     double check_extensionality;
     double prop_cleanup;
+    double weq;
   } time;
 };
 
@@ -28,6 +28,10 @@
 
 #include <math.h>
 
+#ifdef BTOR_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
 /*------------------------------------------------------------------------*/
 
 #define BTOR_PROP_MAXSTEPS_CFACT 100
@@ -172,6 +176,7 @@ move (Btor *btor, uint32_t nmoves)
       slv->roots,
       btor_opt_get (btor, BTOR_OPT_PROP_USE_BANDIT) ? slv->score : 0,
       exps,
+      slv->cone_index,
       true,
       &slv->stats.updates,
       &slv->time.update_cone,
@@ -206,6 +211,9 @@ clone_prop_solver (Btor *clone, BtorPropSolver *slv, BtorNodeMap *exp_map)
   res->roots = btor_hashint_map_clone (clone->mm, slv->roots, 0, 0);
   res->score =
       btor_hashint_map_clone (clone->mm, slv->score, btor_clone_data_as_dbl, 0);
+  res->cone_index = 0;
+  res->domains    = 0;
+  res->warm_start = btor_lsutils_clone_warm_start (clone->mm, slv->warm_start);
 
   return res;
 }
@@ -220,6 +228,9 @@ delete_prop_solver (BtorPropSolver *slv)
 
   if (slv->score) btor_hashint_map_delete (slv->score);
   if (slv->roots) btor_hashint_map_delete (slv->roots);
+  if (slv->cone_index) btor_lsutils_delete_cone_index (slv->cone_index);
+  if (slv->domains) btor_proputils_delete_domains (slv->btor, slv->domains);
+  if (slv->warm_start) btor_lsutils_delete_warm_start (slv->warm_start);
 
   BTOR_DELETE (slv->btor->mm, slv);
 }
@@ -263,6 +274,12 @@ sat_prop_solver_aux (Btor *btor)
       goto UNSAT;
   }
 
+  assert (!slv->cone_index);
+  slv->cone_index = btor_lsutils_new_cone_index (btor);
+  assert (!slv->domains);
+  if (btor_opt_get (btor, BTOR_OPT_PROP_USE_DOMAINS))
+    slv->domains = btor_proputils_new_domains (btor);
+
   for (;;)
   {
     /* collect unsatisfied roots (kept up-to-date in update_cone) */
@@ -357,8 +374,228 @@ DONE:
     btor_hashint_map_delete (slv->score);
     slv->score = 0;
   }
+  if (slv->cone_index)
+  {
+    btor_lsutils_delete_cone_index (slv->cone_index);
+    slv->cone_index = 0;
+  }
+  if (slv->domains)
+  {
+    btor_proputils_delete_domains (btor, slv->domains);
+    slv->domains = 0;
+  }
+  return sat_result;
+}
+
+/*------------------------------------------------------------------------*/
+
+#ifdef BTOR_HAVE_PTHREADS
+
+/* Parallel propagation-based local search: each walker performs an
+ * independent random walk on a clone of 'btor' (with its own model). */
+
+struct BtorPropWalkers
+{
+  Btor *btor;
+  bool found_result;
+  int32_t winner;
+  pthread_mutex_t found_result_mutex;
+};
+
+typedef struct BtorPropWalkers BtorPropWalkers;
+
+struct BtorPropWalker
+{
+  Btor *clone;
+  uint32_t id;
+  int32_t result;
+  pthread_t thread;
+  BtorPropWalkers *walkers;
+};
+
+typedef struct BtorPropWalker BtorPropWalker;
+
+static int32_t
+walker_terminate (void *state)
+{
+  BtorPropWalkers *walkers;
+  int32_t res;
+
+  walkers = state;
+  /* polled frequently, only lock if the termination callback of 'btor'
+   * has to be called (it is not required to be thread-safe) */
+  if (__atomic_load_n (&walkers->found_result, __ATOMIC_ACQUIRE)) return 1;
+  if (!walkers->btor->cbs.term.fun) return 0;
+  pthread_mutex_lock (&walkers->found_result_mutex);
+  res = walkers->found_result || btor_terminate (walkers->btor);
+  if (res) __atomic_store_n (&walkers->found_result, true, __ATOMIC_RELEASE);
+  pthread_mutex_unlock (&walkers->found_result_mutex);
+  return res;
+}
+
+static void *
+walker_work (void *state)
+{
+  BtorPropWalker *walker;
+  BtorPropWalkers *walkers;
+  int32_t res;
+
+  walker  = state;
+  walkers = walker->walkers;
+  res     = sat_prop_solver_aux (walker->clone);
+
+  pthread_mutex_lock (&walkers->found_result_mutex);
+  if (res != BTOR_RESULT_UNKNOWN && walkers->winner < 0)
+  {
+    walkers->winner = walker->id;
+    __atomic_store_n (&walkers->found_result, true, __ATOMIC_RELEASE);
+  }
+  pthread_mutex_unlock (&walkers->found_result_mutex);
+  walker->result = res;
+  return NULL;
+}
+
+/* Walker 0 uses the current configuration, all other walkers use a
+ * different seed and diversify path selection and the probability for
+ * choosing inverse values. All random choices are derived from the seed
+ * of the walker, the state of the RNG of 'btor' is not modified. */
+static void
+configure_walker (Btor *btor, Btor *clone, uint32_t id)
+{
+  uint32_t path_sel;
+
+  if (!id) return;
+
+  btor_opt_set (clone, BTOR_OPT_SEED, btor_opt_get (btor, BTOR_OPT_SEED) + id);
+
+  path_sel = btor_opt_get (btor, BTOR_OPT_PROP_PATH_SEL);
+  if (id & 1)
+    btor_opt_set (clone,
+                  BTOR_OPT_PROP_PATH_SEL,
+                  path_sel == BTOR_PROP_PATH_SEL_RANDOM
+                      ? BTOR_PROP_PATH_SEL_ESSENTIAL
+                      : BTOR_PROP_PATH_SEL_RANDOM);
+  btor_opt_set (
+      clone,
+      BTOR_OPT_PROP_PROB_USE_INV_VALUE,
+      btor_rng_pick_rand (&clone->rng, BTOR_PROB_MAX / 2, BTOR_PROB_MAX));
+}
+
+static void
+add_walker_stats (BtorPropSolver *slv, BtorPropSolver *wslv)
+{
+  slv->stats.restarts += wslv->stats.restarts;
+  slv->stats.moves += wslv->stats.moves;
+  slv->stats.rec_conf += wslv->stats.rec_conf;
+  slv->stats.non_rec_conf += wslv->stats.non_rec_conf;
+  slv->stats.domain_paths += wslv->stats.domain_paths;
+  slv->stats.domain_values += wslv->stats.domain_values;
+  slv->stats.props += wslv->stats.props;
+  slv->stats.props_cons += wslv->stats.props_cons;
+  slv->stats.props_inv += wslv->stats.props_inv;
+  slv->stats.updates += wslv->stats.updates;
+#ifndef NDEBUG
+  slv->stats.inv_add += wslv->stats.inv_add;
+  slv->stats.inv_and += wslv->stats.inv_and;
+  slv->stats.inv_eq += wslv->stats.inv_eq;
+  slv->stats.inv_ult += wslv->stats.inv_ult;
+  slv->stats.inv_sll += wslv->stats.inv_sll;
+  slv->stats.inv_srl += wslv->stats.inv_srl;
+  slv->stats.inv_mul += wslv->stats.inv_mul;
+  slv->stats.inv_udiv += wslv->stats.inv_udiv;
+  slv->stats.inv_urem += wslv->stats.inv_urem;
+  slv->stats.inv_concat += wslv->stats.inv_concat;
+  slv->stats.inv_slice += wslv->stats.inv_slice;
+  slv->stats.inv_cond += wslv->stats.inv_cond;
+  slv->stats.cons_add += wslv->stats.cons_add;
+  slv->stats.cons_and += wslv->stats.cons_and;
+  slv->stats.cons_eq += wslv->stats.cons_eq;
+  slv->stats.cons_ult += wslv->stats.cons_ult;
+  slv->stats.cons_sll += wslv->stats.cons_sll;
+  slv->stats.cons_srl += wslv->stats.cons_srl;
+  slv->stats.cons_mul += wslv->stats.cons_mul;
+  slv->stats.cons_udiv += wslv->stats.cons_udiv;
+  slv->stats.cons_urem += wslv->stats.cons_urem;
+  slv->stats.cons_concat += wslv->stats.cons_concat;
+  slv->stats.cons_slice += wslv->stats.cons_slice;
+  slv->stats.cons_cond += wslv->stats.cons_cond;
+#endif
+  slv->time.update_cone += wslv->time.update_cone;
+  slv->time.update_cone_reset += wslv->time.update_cone_reset;
+  slv->time.update_cone_model_gen += wslv->time.update_cone_model_gen;
+  slv->time.update_cone_compute_score += wslv->time.update_cone_compute_score;
+}
+
+static int32_t
+sat_prop_solver_parallel (Btor *btor, uint32_t nwalkers)
+{
+  assert (btor);
+  assert (nwalkers > 1);
+
+  uint32_t i;
+  int32_t sat_result;
+  Btor *clone;
+  BtorPropSolver *slv, *wslv;
+  BtorPropWalker *walker;
+  BtorPropWalkers walkers;
+
+  slv = BTOR_PROP_SOLVER (btor);
+
+  walkers.btor         = btor;
+  walkers.found_result = false;
+  walkers.winner       = -1;
+  pthread_mutex_init (&walkers.found_result_mutex, 0);
+
+  BTOR_CNEWN (btor->mm, walker, nwalkers);
+  for (i = 0; i < nwalkers; i++)
+  {
+    clone = btor_clone_btor (btor);
+    btor_opt_set (clone, BTOR_OPT_VERBOSITY, 0);
+    configure_walker (btor, clone, i);
+    btor_set_term (clone, walker_terminate, &walkers);
+    wslv = BTOR_PROP_SOLVER (clone);
+    BTOR_CLR (&wslv->stats);
+    BTOR_CLR (&wslv->time);
+    walker[i].clone   = clone;
+    walker[i].id      = i;
+    walker[i].result  = BTOR_RESULT_UNKNOWN;
+    walker[i].walkers = &walkers;
+  }
+
+  for (i = 0; i < nwalkers; i++)
+    pthread_create (&walker[i].thread, 0, walker_work, &walker[i]);
+  for (i = 0; i < nwalkers; i++) pthread_join (walker[i].thread, 0);
+
+  sat_result = BTOR_RESULT_UNKNOWN;
+  if (walkers.winner >= 0)
+  {
+    clone      = walker[walkers.winner].clone;
+    sat_result = walker[walkers.winner].result;
+    BTOR_MSG (btor->msg,
+              1,
+              "walker %d of %u found %s",
+              walkers.winner,
+              nwalkers,
+              sat_result == BTOR_RESULT_SAT ? "sat" : "unsat");
+    if (sat_result == BTOR_RESULT_SAT)
+    {
+      /* node ids of clones match the ids of 'btor' */
+      btor_model_delete_bv (btor, &btor->bv_model);
+      btor->bv_model = btor_model_clone_bv (btor, clone->bv_model, true);
+    }
+  }
+
+  for (i = 0; i < nwalkers; i++)
+  {
+    add_walker_stats (slv, BTOR_PROP_SOLVER (walker[i].clone));
+    btor_delete (walker[i].clone);
+  }
+  BTOR_DELETEN (btor->mm, walker, nwalkers);
+  pthread_mutex_destroy (&walkers.found_result_mutex);
+
   return sat_result;
 }
+#endif
 
 /* Note: failed assumptions handling not necessary, prop only works for SAT */
 static int32_t
@@ -386,11 +623,35 @@ sat_prop_solver (BtorPropSolver *slv)
                       && btor->lambdas->count != 0),
               "prop engine supports QF_BV only");
 
-  /* Generate intial model, all bv vars are initialized with zero. We do
-   * not have to consider model_for_all_nodes, but let this be handled by
-   * the model generation (if enabled) after SAT has been determined. */
-  slv->api.generate_model ((BtorSolver *) slv, false, true);
-  sat_result = sat_prop_solver_aux (btor);
+  /* Generate intial model, all bv vars are initialized with zero (or with
+   * their assignment of the previous call on warm start). We do not have to
+   * consider model_for_all_nodes, but let this be handled by the model
+   * generation (if enabled) after SAT has been determined. */
+  if (slv->warm_start && btor_opt_get (btor, BTOR_OPT_PROP_WARM_START)
+      && btor_lsutils_is_warm_start_valid (btor, slv->warm_start))
+  {
+    btor_lsutils_init_model (btor, slv->warm_start);
+    slv->stats.warm_starts += 1;
+  }
+  else
+    slv->api.generate_model ((BtorSolver *) slv, false, true);
+#ifdef BTOR_HAVE_PTHREADS
+  if (btor_opt_get (btor, BTOR_OPT_PROP_NWALKERS) > 1)
+    sat_result = sat_prop_solver_parallel (
+        btor, btor_opt_get (btor, BTOR_OPT_PROP_NWALKERS));
+  else
+#endif
+    sat_result = sat_prop_solver_aux (btor);
+
+  /* remember model for the next call */
+  if (slv->warm_start)
+  {
+    btor_lsutils_delete_warm_start (slv->warm_start);
+    slv->warm_start = 0;
+  }
+  if (btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+      && btor_opt_get (btor, BTOR_OPT_PROP_WARM_START))
+    slv->warm_start = btor_lsutils_new_warm_start (btor);
 DONE:
   return sat_result;
 }
@@ -425,7 +686,13 @@ print_stats_prop_solver (BtorPropSolver *slv)
   Btor *btor = slv->btor;
 
   BTOR_MSG (btor->msg, 1, "");
+  if (btor_opt_get (btor, BTOR_OPT_PROP_NWALKERS) > 1)
+    BTOR_MSG (btor->msg,
+              1,
+              "walkers: %u (statistics accumulated over all walkers)",
+              btor_opt_get (btor, BTOR_OPT_PROP_NWALKERS));
   BTOR_MSG (btor->msg, 1, "restarts: %u", slv->stats.restarts);
+  BTOR_MSG (btor->msg, 1, "warm starts: %u", slv->stats.warm_starts);
   BTOR_MSG (btor->msg, 1, "moves: %u", slv->stats.moves);
   BTOR_MSG (btor->msg,
             1,
@@ -452,6 +719,14 @@ print_stats_prop_solver (BtorPropSolver *slv)
             1,
             "propagation move conflicts (non-recoverable): %u",
             slv->stats.non_rec_conf);
+  BTOR_MSG (btor->msg,
+            1,
+            "propagation paths selected by domains: %u",
+            slv->stats.domain_paths);
+  BTOR_MSG (btor->msg,
+            1,
+            "propagation values projected into domains: %u",
+            slv->stats.domain_values);
 #ifndef NDEBUG
   BTOR_MSG (btor->msg, 1, "");
   BTOR_MSG (
@@ -10,6 +10,7 @@
 #define BTORSLVPROP_H_INCLUDED
 
 #include "btorbv.h"
+#include "btorlsutils.h"
 #include "btorslv.h"
 #include "btortypes.h"
 #include "utils/btorhashint.h"
@@ -21,6 +22,10 @@ struct BtorPropSolver
   BtorIntHashTable *roots; /* map: maintains 'selected' */
   BtorIntHashTable *score;
 
+  BtorLsConeIndex *cone_index; /* valid during sat call only */
+  BtorIntHashTable *domains;   /* valid during sat call only */
+  BtorLsWarmStart *warm_start; /* model of the previous sat call */
+
   /* current probability for selecting the cond when either the
    * 'then' or 'else' branch is const (path selection) */
   uint32_t flip_cond_const_prob;
@@ -34,9 +39,12 @@ struct BtorPropSolver
   struct
   {
     uint32_t restarts;
+    uint32_t warm_starts;
     uint32_t moves;
     uint32_t rec_conf;
     uint32_t non_rec_conf;
+    uint32_t domain_paths;
+    uint32_t domain_values;
     uint64_t props;
     uint64_t props_cons;
     uint64_t props_inv;
@@ -38,6 +38,8 @@ struct BtorQuantStats
   {
     uint32_t refinements;
     uint32_t failed_refinements;
+    uint32_t shared_refinements; /* refinements imported from other
+                                    ground solvers */
 
     /* overall synthesize statistics */
     uint32_t synthesize_const;
@@ -64,6 +66,32 @@ struct BtorQuantStats
 
 typedef struct BtorQuantStats BtorQuantStats;
 
+#ifdef BTOR_HAVE_PTHREADS
+/* Counterexample (and the values of the existential variables it refuted)
+ * published by a ground solver. Shared counterexamples are never modified
+ * after publishing and only freed after all threads have terminated. */
+struct BtorQuantSharedCE
+{
+  uint32_t producer;
+  BtorMemMgr *mm; /* memory manager of the producer */
+  BtorBitVectorTuple *ce;
+  BtorBitVectorTuple *evar_tup;
+  struct BtorQuantSharedCE *next;
+};
+
+typedef struct BtorQuantSharedCE BtorQuantSharedCE;
+
+/* Lock-free list of shared counterexamples. New counterexamples are pushed
+ * at 'head' via compare-and-swap, readers walk from 'head' to the head they
+ * have seen in their previous import. */
+struct BtorQuantSharedCEs
+{
+  BtorQuantSharedCE *head;
+};
+
+typedef struct BtorQuantSharedCEs BtorQuantSharedCEs;
+#endif
+
 struct BtorGroundSolvers
 {
   Btor *forall; /* solver for checking the model */
@@ -95,17 +123,25 @@ struct BtorGroundSolvers
 #ifdef BTOR_HAVE_PTHREADS
   bool *found_result;
   pthread_mutex_t *found_result_mutex;
+
+  uint32_t id;
+  BtorQuantSharedCEs *shared; /* 0 if counterexamples are not shared */
+  BtorQuantSharedCE *shared_last; /* head of 'shared' at last import */
 #endif
 };
 
 typedef struct BtorGroundSolvers BtorGroundSolvers;
 
+BTOR_DECLARE_STACK (BtorGroundSolversPtr, BtorGroundSolvers *);
+
 struct BtorQuantSolver
 {
   BTOR_SOLVER_STRUCT;
 
   BtorGroundSolvers *gslv;  /* two ground solver instances */
   BtorGroundSolvers *dgslv; /* two ground solver instances for dual */
+  BtorGroundSolversPtrStack xgslvs; /* additional ground solver instances
+                                       with diversified configuration */
 };
 
 typedef struct BtorQuantSolver BtorQuantSolver;
@@ -962,58 +998,36 @@ instantiate_args (Btor *btor, BtorNode *args, BtorNodeMap *map)
   return res;
 }
 
-static void
-refine_exists_solver (BtorGroundSolvers *gslv, BtorNodeMap *evar_map)
+/* Build refinement for the exists solver, i.e., the formula instantiated
+ * with counterexample 'ce' for the universal variables. */
+static BtorNode *
+mk_refinement (BtorGroundSolvers *gslv, BtorBitVectorTuple *ce)
 {
-  assert (gslv->forall_uvars->table->count > 0);
+  assert (ce);
+  assert (ce->arity == gslv->forall_uvars->table->count);
 
   uint32_t i;
   Btor *f_solver, *e_solver;
   BtorNodeMap *map;
   BtorNodeMapIterator it;
-  BtorNode *var_es, *var_fs, *c, *res, *uvar, *evar, *a;
-  const BtorBitVector *bv;
-  BtorBitVectorTuple *ce, *evar_tup;
+  BtorNode *var_es, *var_fs, *c, *res, *uvar, *a;
 
   f_solver = gslv->forall;
   e_solver = gslv->exists;
 
   map = btor_nodemap_new (f_solver);
 
-  /* generate counter example for universal vars */
-  assert (f_solver->last_sat_result == BTOR_RESULT_SAT);
-  f_solver->slv->api.generate_model (f_solver->slv, false, false);
-
   /* instantiate universal vars with counter example */
-  i  = 0;
-  ce = btor_bv_new_tuple (f_solver->mm, gslv->forall_uvars->table->count);
+  i = 0;
   btor_iter_nodemap_init (&it, gslv->forall_uvars);
   while (btor_iter_nodemap_has_next (&it))
   {
-    var_fs = it.it.bucket->data.as_ptr;
-    uvar   = btor_iter_nodemap_next (&it);
-    bv     = btor_model_get_bv (f_solver, btor_simplify_exp (f_solver, var_fs));
-    c      = btor_exp_bv_const (e_solver, (BtorBitVector *) bv);
+    uvar = btor_iter_nodemap_next (&it);
+    assert (btor_node_bv_get_width (f_solver, uvar)
+            == btor_bv_get_width (ce->bv[i]));
+    c = btor_exp_bv_const (e_solver, ce->bv[i++]);
     btor_nodemap_map (map, uvar, c);
     btor_node_release (e_solver, c);
-    btor_bv_add_to_tuple (f_solver->mm, ce, bv, i++);
-  }
-
-  i        = 0;
-  evar_tup = 0;
-  if (gslv->forall_evars->table->count)
-  {
-    evar_tup =
-        btor_bv_new_tuple (f_solver->mm, gslv->forall_evars->table->count);
-    btor_iter_nodemap_init (&it, gslv->forall_evars);
-    while (btor_iter_nodemap_has_next (&it))
-    {
-      evar   = btor_iter_nodemap_next (&it);
-      var_fs = btor_nodemap_mapped (evar_map, evar);
-      assert (var_fs);
-      bv = btor_model_get_bv (f_solver, btor_simplify_exp (f_solver, var_fs));
-      btor_bv_add_to_tuple (f_solver->mm, evar_tup, bv, i++);
-    }
   }
 
   /* map existential variables to skolem constants */
@@ -1049,6 +1063,133 @@ refine_exists_solver (BtorGroundSolvers *gslv, BtorNodeMap *evar_map)
   res = build_refinement (e_solver, gslv->forall_formula, map);
 
   btor_nodemap_delete (map);
+  return res;
+}
+
+#ifdef BTOR_HAVE_PTHREADS
+static void
+publish_ce (BtorGroundSolvers *gslv,
+            BtorBitVectorTuple *ce,
+            BtorBitVectorTuple *evar_tup)
+{
+  assert (gslv->shared);
+
+  BtorMemMgr *mm;
+  BtorQuantSharedCE *sce;
+
+  mm = gslv->forall->mm;
+  BTOR_CNEW (mm, sce);
+  sce->producer = gslv->id;
+  sce->mm       = mm;
+  sce->ce       = btor_bv_copy_tuple (mm, ce);
+  sce->evar_tup = evar_tup ? btor_bv_copy_tuple (mm, evar_tup) : 0;
+
+  sce->next = __atomic_load_n (&gslv->shared->head, __ATOMIC_RELAXED);
+  while (!__atomic_compare_exchange_n (&gslv->shared->head,
+                                       &sce->next,
+                                       sce,
+                                       true,
+                                       __ATOMIC_RELEASE,
+                                       __ATOMIC_RELAXED))
+    ;
+}
+
+/* Refine exists solver with all counterexamples that have been published by
+ * other ground solvers since the last import. */
+static void
+import_shared_ces (BtorGroundSolvers *gslv)
+{
+  assert (gslv->shared);
+
+  BtorMemMgr *mm;
+  BtorNode *res;
+  BtorQuantSharedCE *head, *sce;
+  BtorBitVectorTuple *ce, *evar_tup;
+
+  mm   = gslv->forall->mm;
+  head = __atomic_load_n (&gslv->shared->head, __ATOMIC_ACQUIRE);
+  for (sce = head; sce != gslv->shared_last; sce = sce->next)
+  {
+    if (sce->producer == gslv->id
+        || btor_hashptr_table_get (gslv->forall_ces, sce->ce))
+      continue;
+
+    ce       = btor_bv_copy_tuple (mm, sce->ce);
+    evar_tup = sce->evar_tup ? btor_bv_copy_tuple (mm, sce->evar_tup) : 0;
+
+    res = mk_refinement (gslv, ce);
+    btor_hashptr_table_add (gslv->forall_ces, ce)->data.as_ptr = evar_tup;
+    btor_assert_exp (gslv->exists, res);
+    btor_node_release (gslv->exists, res);
+    gslv->statistics.stats.shared_refinements++;
+  }
+  gslv->shared_last = head;
+}
+
+static void
+delete_shared_ces (BtorQuantSharedCEs *shared)
+{
+  BtorQuantSharedCE *sce, *next;
+
+  for (sce = shared->head; sce; sce = next)
+  {
+    next = sce->next;
+    btor_bv_free_tuple (sce->mm, sce->ce);
+    if (sce->evar_tup) btor_bv_free_tuple (sce->mm, sce->evar_tup);
+    BTOR_DELETE (sce->mm, sce);
+  }
+  shared->head = 0;
+}
+#endif
+
+static void
+refine_exists_solver (BtorGroundSolvers *gslv, BtorNodeMap *evar_map)
+{
+  assert (gslv->forall_uvars->table->count > 0);
+
+  uint32_t i;
+  Btor *f_solver, *e_solver;
+  BtorNodeMapIterator it;
+  BtorNode *var_fs, *res, *evar;
+  const BtorBitVector *bv;
+  BtorBitVectorTuple *ce, *evar_tup;
+
+  f_solver = gslv->forall;
+  e_solver = gslv->exists;
+
+  /* generate counter example for universal vars */
+  assert (f_solver->last_sat_result == BTOR_RESULT_SAT);
+  f_solver->slv->api.generate_model (f_solver->slv, false, false);
+
+  i  = 0;
+  ce = btor_bv_new_tuple (f_solver->mm, gslv->forall_uvars->table->count);
+  btor_iter_nodemap_init (&it, gslv->forall_uvars);
+  while (btor_iter_nodemap_has_next (&it))
+  {
+    var_fs = it.it.bucket->data.as_ptr;
+    btor_iter_nodemap_next (&it);
+    bv = btor_model_get_bv (f_solver, btor_simplify_exp (f_solver, var_fs));
+    btor_bv_add_to_tuple (f_solver->mm, ce, bv, i++);
+  }
+
+  i        = 0;
+  evar_tup = 0;
+  if (gslv->forall_evars->table->count)
+  {
+    evar_tup =
+        btor_bv_new_tuple (f_solver->mm, gslv->forall_evars->table->count);
+    btor_iter_nodemap_init (&it, gslv->forall_evars);
+    while (btor_iter_nodemap_has_next (&it))
+    {
+      evar   = btor_iter_nodemap_next (&it);
+      var_fs = btor_nodemap_mapped (evar_map, evar);
+      assert (var_fs);
+      bv = btor_model_get_bv (f_solver, btor_simplify_exp (f_solver, var_fs));
+      btor_bv_add_to_tuple (f_solver->mm, evar_tup, bv, i++);
+    }
+  }
+
+  res = mk_refinement (gslv, ce);
 
   assert (res != e_solver->true_exp);
   BTOR_ABORT (res == e_solver->true_exp,
@@ -1059,6 +1200,9 @@ refine_exists_solver (BtorGroundSolvers *gslv, BtorNodeMap *evar_map)
   assert (!btor_hashptr_table_get (gslv->forall_ces, ce));
   btor_hashptr_table_add (gslv->forall_ces, ce)->data.as_ptr = evar_tup;
   gslv->forall_last_ce                                       = ce;
+#ifdef BTOR_HAVE_PTHREADS
+  if (gslv->shared) publish_ce (gslv, ce, evar_tup);
+#endif
 
   btor_assert_exp (e_solver, res);
   btor_node_release (e_solver, res);
@@ -1180,6 +1324,9 @@ delete_quant_solver (BtorQuantSolver *slv)
   btor = slv->btor;
   delete_ground_solvers (slv, slv->gslv);
   if (slv->dgslv) delete_ground_solvers (slv, slv->dgslv);
+  while (!BTOR_EMPTY_STACK (slv->xgslvs))
+    delete_ground_solvers (slv, BTOR_POP_STACK (slv->xgslvs));
+  BTOR_RELEASE_STACK (slv->xgslvs);
   BTOR_DELETE (btor->mm, slv);
   btor->slv = 0;
 }
@@ -2250,6 +2397,14 @@ find_model (BtorGroundSolvers *gslv, bool skip_exists)
    * is correct. */
   if (!skip_exists)
   {
+#ifdef BTOR_HAVE_PTHREADS
+    if (gslv->shared)
+    {
+      start = time_stamp ();
+      import_shared_ces (gslv);
+      gslv->statistics.time.refine += time_stamp () - start;
+    }
+#endif
     /* query exists solver */
     start = time_stamp ();
     r     = btor_check_sat (gslv->exists, -1, -1);
@@ -2378,37 +2533,114 @@ thread_terminate (void *state)
   return found_result;
 }
 
+/* Additional ground solvers for the original formula use a different seed,
+ * alternate between lower and higher synthesis limits and toggle the
+ * synthesis of quantifier instantiations for every other pair of ids. */
+static void
+configure_ground_solvers (Btor *btor, BtorGroundSolvers *gslv, uint32_t id)
+{
+  assert (id > 0);
+
+  uint32_t seed, synth_limit, shift;
+
+  seed = btor_opt_get (btor, BTOR_OPT_SEED) + id;
+  btor_opt_set (gslv->forall, BTOR_OPT_SEED, seed);
+  btor_opt_set (gslv->exists, BTOR_OPT_SEED, seed);
+
+  synth_limit = btor_opt_get (btor, BTOR_OPT_QUANT_SYNTH_LIMIT);
+  if (id & 1)
+  {
+    shift = (id + 1) / 2;
+    synth_limit >>= shift;
+  }
+  else
+  {
+    shift       = id / 2;
+    synth_limit = synth_limit > (UINT32_MAX >> shift) ? UINT32_MAX
+                                                       : synth_limit << shift;
+  }
+  btor_opt_set (gslv->forall, BTOR_OPT_QUANT_SYNTH_LIMIT, synth_limit);
+
+  if (id & 2)
+    btor_opt_set (gslv->forall,
+                  BTOR_OPT_QUANT_SYNTH_QI,
+                  !btor_opt_get (btor, BTOR_OPT_QUANT_SYNTH_QI));
+}
+
 static BtorSolverResult
-run_parallel (BtorGroundSolvers *gslv, BtorGroundSolvers *dgslv)
+run_parallel (BtorQuantSolver *slv)
 {
   bool thread_found_result;
   pthread_mutex_t thread_result_mutex = PTHREAD_MUTEX_INITIALIZER;
+  uint32_t i, ngslvs;
   BtorSolverResult res;
-  pthread_t thread_orig, thread_dual;
+  BtorMemMgr *mm;
+  BtorGroundSolvers *gslv, *dgslv;
+  BtorGroundSolversPtrStack gslvs;
+  BtorQuantSharedCEs shared;
+  pthread_t *threads;
+
+  mm    = slv->btor->mm;
+  dgslv = slv->dgslv;
+
+  /* ground solvers for the original formula share counterexamples */
+  BTOR_INIT_STACK (mm, gslvs);
+  BTOR_PUSH_STACK (gslvs, slv->gslv);
+  for (i = 0; i < BTOR_COUNT_STACK (slv->xgslvs); i++)
+    BTOR_PUSH_STACK (gslvs, BTOR_PEEK_STACK (slv->xgslvs, i));
+  ngslvs      = BTOR_COUNT_STACK (gslvs);
+  shared.head = 0;
+  for (i = 0; ngslvs > 1 && i < ngslvs; i++)
+  {
+    gslv              = BTOR_PEEK_STACK (gslvs, i);
+    gslv->id          = i;
+    gslv->shared      = &shared;
+    gslv->shared_last = 0;
+  }
+  if (dgslv) BTOR_PUSH_STACK (gslvs, dgslv);
 
   thread_found_result   = false;
   g_measure_thread_time = true;
-  btor_set_term (gslv->forall, thread_terminate, &thread_found_result);
-  btor_set_term (gslv->exists, thread_terminate, &thread_found_result);
-  btor_set_term (dgslv->forall, thread_terminate, &thread_found_result);
-  btor_set_term (dgslv->exists, thread_terminate, &thread_found_result);
+  for (i = 0; i < BTOR_COUNT_STACK (gslvs); i++)
+  {
+    gslv = BTOR_PEEK_STACK (gslvs, i);
+    btor_set_term (gslv->forall, thread_terminate, &thread_found_result);
+    btor_set_term (gslv->exists, thread_terminate, &thread_found_result);
+    gslv->found_result       = &thread_found_result;
+    gslv->found_result_mutex = &thread_result_mutex;
+  }
 
-  gslv->found_result        = &thread_found_result;
-  gslv->found_result_mutex  = &thread_result_mutex;
-  dgslv->found_result       = &thread_found_result;
-  dgslv->found_result_mutex = &thread_result_mutex;
+  BTOR_NEWN (mm, threads, BTOR_COUNT_STACK (gslvs));
+  for (i = 0; i < BTOR_COUNT_STACK (gslvs); i++)
+    pthread_create (&threads[i], 0, thread_work, BTOR_PEEK_STACK (gslvs, i));
+  for (i = 0; i < BTOR_COUNT_STACK (gslvs); i++) pthread_join (threads[i], 0);
+  BTOR_DELETEN (mm, threads, BTOR_COUNT_STACK (gslvs));
 
-  pthread_create (&thread_orig, 0, thread_work, gslv);
-  pthread_create (&thread_dual, 0, thread_work, dgslv);
-  pthread_join (thread_orig, 0);
-  pthread_join (thread_dual, 0);
+  delete_shared_ces (&shared);
+  for (i = 0; i < ngslvs; i++) BTOR_PEEK_STACK (gslvs, i)->shared = 0;
 
-  if (gslv->result != BTOR_RESULT_UNKNOWN)
+  /* the first ground solver of the original formula that found a result
+   * becomes the main ground solver (for model printing and statistics) */
+  res = BTOR_RESULT_UNKNOWN;
+  for (i = 0; i < ngslvs; i++)
   {
+    gslv = BTOR_PEEK_STACK (gslvs, i);
+    if (gslv->result == BTOR_RESULT_UNKNOWN) continue;
     res = gslv->result;
+    if (i > 0)
+    {
+      BTOR_POKE_STACK (slv->xgslvs, i - 1, slv->gslv);
+      slv->gslv = gslv;
+      BTOR_MSG (slv->btor->msg, 1, "ground solver %u found result", i);
+    }
+    break;
   }
-  else
+  BTOR_RELEASE_STACK (gslvs);
+
+  if (res == BTOR_RESULT_UNKNOWN)
   {
+    /* the dual solver is disabled, e.g., if UFs are present */
+    if (!dgslv) return BTOR_RESULT_UNKNOWN;
     assert (dgslv->result != BTOR_RESULT_UNKNOWN);
     if (dgslv->result == BTOR_RESULT_SAT)
     {
@@ -2467,6 +2699,12 @@ sat_quant_solver (BtorQuantSolver *slv)
   bool skip_exists = true;
   BtorSolverResult res;
   BtorNode *g;
+#ifdef BTOR_HAVE_PTHREADS
+  bool opt_dual_solver;
+  uint32_t i, opt_nsolvers;
+  char prefix_forall[16], prefix_exists[16];
+  BtorGroundSolvers *gslv;
+#endif
 
   BTOR_ABORT (btor_opt_get (slv->btor, BTOR_OPT_INCREMENTAL),
               "incremental mode not supported for BV");
@@ -2476,21 +2714,32 @@ sat_quant_solver (BtorQuantSolver *slv)
   g = simplify (slv->btor, g);
 
   slv->gslv = setup_solvers (slv, g, false, "forall", "exists");
+
+#ifdef BTOR_HAVE_PTHREADS
+  opt_nsolvers = btor_opt_get (slv->btor, BTOR_OPT_QUANT_NSOLVERS);
+  for (i = 1; i < opt_nsolvers; i++)
+  {
+    sprintf (prefix_forall, "forall%u", i);
+    sprintf (prefix_exists, "exists%u", i);
+    gslv = setup_solvers (slv, g, false, prefix_forall, prefix_exists);
+    configure_ground_solvers (slv->btor, gslv, i);
+    BTOR_PUSH_STACK (slv->xgslvs, gslv);
+  }
+#endif
   btor_node_release (slv->btor, g);
 
 #ifdef BTOR_HAVE_PTHREADS
-  bool opt_dual_solver;
   opt_dual_solver = btor_opt_get (slv->btor, BTOR_OPT_QUANT_DUAL_SOLVER) == 1;
 
   /* disable dual solver if UFs are present in the formula */
   if (slv->gslv->exists_ufs->table->count > 0) opt_dual_solver = false;
 
   if (opt_dual_solver)
-  {
     slv->dgslv = setup_solvers (
         slv, slv->gslv->forall_formula, true, "dual_forall", "dual_exists");
-    res = run_parallel (slv->gslv, slv->dgslv);
-  }
+
+  if (slv->dgslv || !BTOR_EMPTY_STACK (slv->xgslvs))
+    res = run_parallel (slv);
   else
 #endif
   {
@@ -2543,6 +2792,11 @@ print_stats_quant_solver (BtorQuantSolver *slv)
             1,
             "cegqi solver failed refinements: %u",
             slv->gslv->statistics.stats.failed_refinements);
+  if (!BTOR_EMPTY_STACK (slv->xgslvs))
+    BTOR_MSG (slv->btor->msg,
+              1,
+              "cegqi solver shared refinements: %u",
+              slv->gslv->statistics.stats.shared_refinements);
   if (slv->gslv->result == BTOR_RESULT_SAT
       || slv->gslv->result == BTOR_RESULT_UNKNOWN)
   {
@@ -2711,6 +2965,7 @@ btor_new_quantifier_solver (Btor *btor)
 
   slv->kind      = BTOR_QUANT_SOLVER_KIND;
   slv->btor      = btor;
+  BTOR_INIT_STACK (btor->mm, slv->xgslvs);
   slv->api.clone = (BtorSolverClone) clone_quant_solver;
   slv->api.delet = (BtorSolverDelete) delete_quant_solver;
   slv->api.sat   = (BtorSolverSat) sat_quant_solver;
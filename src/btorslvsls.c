@@ -45,6 +45,8 @@
 #define BTOR_SLS_PROB_RANGE_MSB_VS_LSB 500
 /* start segments from MSB rather than LSB (prob=0.5) */
 #define BTOR_SLS_PROB_SEG_MSB_VS_LSB 500
+/* tolerance for comparing incrementally maintained scores (rounding) */
+#define BTOR_SLS_SCORE_EPS(sc) (1e-10 * (1.0 + fabs (sc)))
 
 /*------------------------------------------------------------------------*/
 
@@ -82,6 +84,110 @@ compute_sls_score_formula (Btor *btor, BtorIntHashTable *score, bool *done)
   return res;
 }
 
+static inline double
+compute_sls_score_root (BtorIntHashTable *score,
+                        BtorIntHashTable *src_score,
+                        BtorSLSConstrData *d,
+                        int32_t id,
+                        int32_t *nunsat)
+{
+  double sc;
+
+  assert (btor_hashint_map_contains (score, id));
+  sc = btor_hashint_map_get (score, id)->as_dbl;
+  if (sc < 1.0) *nunsat += 1;
+  if (src_score)
+  {
+    assert (btor_hashint_map_contains (src_score, id));
+    if (btor_hashint_map_get (src_score, id)->as_dbl < 1.0) *nunsat -= 1;
+    sc -= btor_hashint_map_get (src_score, id)->as_dbl;
+  }
+  return (double) d->weight * sc;
+}
+
+/* Compute the weighted score of the roots affected by a move on 'exps', i.e.,
+ * of all roots in 'exps' and their cone 'cone'. The number of unsatisfied
+ * roots among them is returned via 'nunsat'. If 'src_score' is given, the
+ * difference to 'src_score' is computed instead (for both the score and the
+ * number of unsatisfied roots).
+ *
+ * Note: If there are less roots than nodes in the cone, all roots are
+ *       considered (for roots outside of the cone, 'score' and 'src_score'
+ *       are expected to be equal). */
+static double
+compute_sls_score_cone (Btor *btor,
+                        BtorIntHashTable *score,
+                        BtorIntHashTable *src_score,
+                        BtorIntHashTable *exps,
+                        BtorNodePtrStack *cone,
+                        int32_t *nunsat)
+{
+  assert (btor);
+  assert (score);
+  assert (exps);
+  assert (cone);
+  assert (nunsat);
+
+  size_t i;
+  int32_t id;
+  double res;
+  BtorSLSSolver *slv;
+  BtorHashTableData *d;
+  BtorIntHashTableIterator it;
+
+  slv = BTOR_SLS_SOLVER (btor);
+  assert (slv->weights);
+
+  res     = 0.0;
+  *nunsat = 0;
+
+  if (src_score && slv->weights->count <= BTOR_COUNT_STACK (*cone) + exps->count)
+  {
+    btor_iter_hashint_init (&it, slv->weights);
+    while (btor_iter_hashint_has_next (&it))
+    {
+      d  = &slv->weights->data[it.cur_pos];
+      id = btor_iter_hashint_next (&it);
+      res += compute_sls_score_root (score, src_score, d->as_ptr, id, nunsat);
+    }
+    return res;
+  }
+
+  btor_iter_hashint_init (&it, exps);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    id = btor_iter_hashint_next (&it);
+    if ((d = btor_hashint_map_get (slv->weights, id)))
+      res += compute_sls_score_root (score, src_score, d->as_ptr, id, nunsat);
+    if ((d = btor_hashint_map_get (slv->weights, -id)))
+      res += compute_sls_score_root (score, src_score, d->as_ptr, -id, nunsat);
+  }
+  for (i = 0; i < BTOR_COUNT_STACK (*cone); i++)
+  {
+    id = BTOR_PEEK_STACK (*cone, i)->id;
+    if ((d = btor_hashint_map_get (slv->weights, id)))
+      res += compute_sls_score_root (score, src_score, d->as_ptr, id, nunsat);
+    if ((d = btor_hashint_map_get (slv->weights, -id)))
+      res += compute_sls_score_root (score, src_score, d->as_ptr, -id, nunsat);
+  }
+  return res;
+}
+
+#ifndef NDEBUG
+static bool
+check_formula_score_dbg (Btor *btor)
+{
+  bool done;
+  double sc;
+  BtorSLSSolver *slv;
+
+  slv = BTOR_SLS_SOLVER (btor);
+  sc  = compute_sls_score_formula (btor, slv->score, &done);
+  return fabs (sc - slv->formula_score) <= 1e-6 * (1.0 + fabs (sc))
+         && done == (slv->roots->count == 0);
+}
+#endif
+
 static BtorNode *
 select_candidate_constraint (Btor *btor, uint32_t nmoves)
 {
@@ -258,6 +364,7 @@ update_assertion_weights (Btor *btor)
   assert (btor);
 
   int32_t id;
+  double sc;
   BtorSLSConstrData *d;
   BtorIntHashTableIterator it;
   BtorSLSSolver *slv;
@@ -273,8 +380,13 @@ update_assertion_weights (Btor *btor)
       d  = (BtorSLSConstrData *) slv->weights->data[it.cur_pos].as_ptr;
       id = btor_iter_hashint_next (&it);
       assert (btor_hashint_table_contains (slv->score, id));
-      if (btor_hashint_map_get (slv->score, id)->as_dbl == 0.0) continue;
-      if (d->weight > 1) d->weight -= 1;
+      sc = btor_hashint_map_get (slv->score, id)->as_dbl;
+      if (sc == 0.0) continue;
+      if (d->weight > 1)
+      {
+        d->weight -= 1;
+        slv->formula_score -= sc;
+      }
     }
   }
   else
@@ -286,12 +398,81 @@ update_assertion_weights (Btor *btor)
       d  = (BtorSLSConstrData *) slv->weights->data[it.cur_pos].as_ptr;
       id = btor_iter_hashint_next (&it);
       assert (btor_hashint_table_contains (slv->score, id));
-      if (btor_hashint_map_get (slv->score, id)->as_dbl == 1.0) continue;
+      sc = btor_hashint_map_get (slv->score, id)->as_dbl;
+      if (sc == 1.0) continue;
       d->weight += 1;
+      slv->formula_score += sc;
     }
   }
 }
 
+/* Get the snapshot of the current model and score to try moves on. */
+static void
+get_eval_snapshot (Btor *btor,
+                   BtorIntHashTable **bv_model,
+                   BtorIntHashTable **score)
+{
+  assert (btor);
+  assert (bv_model);
+  assert (score);
+
+  BtorSLSSolver *slv;
+
+  slv = BTOR_SLS_SOLVER (btor);
+
+  if (!slv->eval_bv_model)
+  {
+    assert (!slv->eval_score);
+    slv->eval_bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
+    slv->eval_score    = btor_hashint_map_clone (
+        btor->mm, slv->score, btor_clone_data_as_dbl, 0);
+  }
+  *bv_model = slv->eval_bv_model;
+  *score    = slv->eval_score;
+}
+
+/* Reset the snapshot after a batch of moves on 'candidates' has been tried,
+ * only the cone of 'candidates' has to be restored. */
+static void
+reset_eval_snapshot (Btor *btor, BtorNodePtrStack *candidates)
+{
+  assert (btor);
+  assert (candidates);
+
+  size_t i;
+  BtorIntHashTable *exps;
+  BtorSLSSolver *slv;
+
+  slv = BTOR_SLS_SOLVER (btor);
+  assert (slv->eval_bv_model);
+
+  exps = btor_hashint_table_new (btor->mm);
+  for (i = 0; i < BTOR_COUNT_STACK (*candidates); i++)
+    btor_hashint_table_add (exps, BTOR_PEEK_STACK (*candidates, i)->id);
+  btor_lsutils_reset_cone (btor,
+                           slv->eval_bv_model,
+                           slv->eval_score,
+                           btor->bv_model,
+                           slv->score,
+                           exps,
+                           slv->cone_index);
+  btor_hashint_table_delete (exps);
+}
+
+static void
+delete_eval_snapshot (BtorSLSSolver *slv)
+{
+  assert (slv);
+
+  if (slv->eval_bv_model)
+    btor_model_delete_bv (slv->btor, &slv->eval_bv_model);
+  if (slv->eval_score)
+  {
+    btor_hashint_map_delete (slv->eval_score);
+    slv->eval_score = 0;
+  }
+}
+
 static inline double
 try_move (Btor *btor,
           BtorIntHashTable *bv_model,
@@ -306,10 +487,14 @@ try_move (Btor *btor,
   assert (cans->count);
   assert (done);
 
+  double start, res;
+  int32_t nunsat;
+  BtorNodePtrStack *cone;
   BtorSLSSolver *slv;
 
   slv = BTOR_SLS_SOLVER (btor);
   assert (slv);
+  assert (score != slv->score);
   if (slv->nflips && slv->stats.flips >= slv->nflips)
   {
     slv->terminate = true;
@@ -317,6 +502,8 @@ try_move (Btor *btor,
   }
   slv->stats.flips += 1;
 
+  start = btor_util_time_stamp ();
+
 #ifndef NBTORLOG
   char *a;
   BtorNode *can;
@@ -349,6 +536,7 @@ try_move (Btor *btor,
                             slv->roots,
                             score,
                             cans,
+                            slv->cone_index,
                             false,
                             &slv->stats.updates,
                             &slv->time.update_cone,
@@ -356,7 +544,14 @@ try_move (Btor *btor,
                             &slv->time.update_cone_model_gen,
                             &slv->time.update_cone_compute_score);
 
-  return compute_sls_score_formula (btor, score, done);
+  /* only the scores of roots in the cone of 'cans' may differ from the
+   * scores of the current model */
+  cone = btor_lsutils_get_cone (btor, slv->cone_index, cans);
+  res = slv->formula_score
+        + compute_sls_score_cone (btor, score, slv->score, cans, cone, &nunsat);
+  *done = (int32_t) slv->roots->count + nunsat == 0;
+  slv->time.try_move += btor_util_time_stamp () - start;
+  return res;
 }
 
 static int32_t
@@ -388,9 +583,10 @@ cmp_sls_moves_qsort (const void *move1, const void *move2)
   {                                                                            \
     if (done                                                                   \
         || (sls_strat != BTOR_SLS_STRAT_RAND_WALK                              \
-            && ((sc) > slv->max_score                                          \
+            && ((sc) > slv->max_score + BTOR_SLS_SCORE_EPS (slv->max_score)    \
                 || (sls_strat == BTOR_SLS_STRAT_BEST_SAME_MOVE                 \
-                    && (sc) == slv->max_score))))                              \
+                    && fabs ((sc) - slv->max_score)                            \
+                           <= BTOR_SLS_SCORE_EPS (slv->max_score)))))          \
     {                                                                          \
       slv->max_score = (sc);                                                   \
       slv->max_move  = mk;                                                     \
@@ -455,9 +651,7 @@ select_inc_dec_not_move (Btor *btor,
     mk = BTOR_SLS_MOVE_NOT;
   }
 
-  bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
-  score =
-      btor_hashint_map_clone (btor->mm, slv->score, btor_clone_data_as_dbl, 0);
+  get_eval_snapshot (btor, &bv_model, &score);
 
   cans = btor_hashint_map_new (btor->mm);
 
@@ -489,8 +683,7 @@ select_inc_dec_not_move (Btor *btor,
   BTOR_SLS_SELECT_MOVE_CHECK_SCORE (sc);
 
 DONE:
-  btor_model_delete_bv (btor, &bv_model);
-  btor_hashint_map_delete (score);
+  reset_eval_snapshot (btor, candidates);
   return done;
 }
 
@@ -514,9 +707,7 @@ select_flip_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
 
   mk = BTOR_SLS_MOVE_FLIP;
 
-  bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
-  score =
-      btor_hashint_map_clone (btor->mm, slv->score, btor_clone_data_as_dbl, 0);
+  get_eval_snapshot (btor, &bv_model, &score);
 
   for (pos = 0, n_endpos = 0; n_endpos < BTOR_COUNT_STACK (*candidates); pos++)
   {
@@ -554,8 +745,7 @@ select_flip_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   }
 
 DONE:
-  btor_model_delete_bv (btor, &bv_model);
-  btor_hashint_map_delete (score);
+  reset_eval_snapshot (btor, candidates);
   return done;
 }
 
@@ -579,9 +769,7 @@ select_flip_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
 
   mk = BTOR_SLS_MOVE_FLIP_RANGE;
 
-  bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
-  score =
-      btor_hashint_map_clone (btor->mm, slv->score, btor_clone_data_as_dbl, 0);
+  get_eval_snapshot (btor, &bv_model, &score);
 
   for (up = 1, n_endpos = 0; n_endpos < BTOR_COUNT_STACK (*candidates);
        up = 2 * up + 1)
@@ -634,8 +822,7 @@ select_flip_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   }
 
 DONE:
-  btor_model_delete_bv (btor, &bv_model);
-  btor_hashint_map_delete (score);
+  reset_eval_snapshot (btor, candidates);
   return done;
 }
 
@@ -660,9 +847,7 @@ select_flip_segment_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
 
   mk = BTOR_SLS_MOVE_FLIP_SEGMENT;
 
-  bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
-  score =
-      btor_hashint_map_clone (btor->mm, slv->score, btor_clone_data_as_dbl, 0);
+  get_eval_snapshot (btor, &bv_model, &score);
 
   for (seg = 2; seg <= 8; seg <<= 1)
   {
@@ -722,8 +907,7 @@ select_flip_segment_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   }
 
 DONE:
-  btor_model_delete_bv (btor, &bv_model);
-  btor_hashint_map_delete (score);
+  reset_eval_snapshot (btor, candidates);
   return done;
 }
 
@@ -748,9 +932,7 @@ select_rand_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
 
   mk = BTOR_SLS_MOVE_RAND;
 
-  bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
-  score =
-      btor_hashint_map_clone (btor->mm, slv->score, btor_clone_data_as_dbl, 0);
+  get_eval_snapshot (btor, &bv_model, &score);
 
   for (up = 1, n_endpos = 0; n_endpos < BTOR_COUNT_STACK (*candidates);
        up = 2 * up + 1)
@@ -801,8 +983,7 @@ select_rand_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   }
 
 DONE:
-  btor_model_delete_bv (btor, &bv_model);
-  btor_hashint_map_delete (score);
+  reset_eval_snapshot (btor, candidates);
   return done;
 }
 
@@ -1126,9 +1307,11 @@ move (Btor *btor, uint32_t nmoves)
   assert (btor);
 
   uint32_t nprops, nsls;
+  int32_t nunsat;
+  double sc;
   bool res;
   BtorNode *constr, *can;
-  BtorNodePtrStack candidates;
+  BtorNodePtrStack candidates, *cone;
   BtorIntHashTableIterator iit;
   BtorSLSSolver *slv;
   BtorBitVector *neigh;
@@ -1203,7 +1386,7 @@ move (Btor *btor, uint32_t nmoves)
       goto DONE;
     }
 
-    slv->max_score = compute_sls_score_formula (btor, slv->score, 0);
+    slv->max_score = slv->formula_score;
     slv->max_move  = BTOR_SLS_MOVE_DONE;
     slv->max_gw    = -1;
 
@@ -1254,17 +1437,34 @@ move (Btor *btor, uint32_t nmoves)
   }
 #endif
 
+  cone = btor_lsutils_get_cone (btor, slv->cone_index, slv->max_cans);
+  sc   = compute_sls_score_cone (
+      btor, slv->score, 0, slv->max_cans, cone, &nunsat);
   btor_lsutils_update_cone (btor,
                             btor->bv_model,
                             slv->roots,
                             slv->score,
                             slv->max_cans,
+                            slv->cone_index,
                             true,
                             &slv->stats.updates,
                             &slv->time.update_cone,
                             &slv->time.update_cone_reset,
                             &slv->time.update_cone_model_gen,
                             &slv->time.update_cone_compute_score);
+  slv->formula_score +=
+      compute_sls_score_cone (
+          btor, slv->score, 0, slv->max_cans, cone, &nunsat)
+      - sc;
+  /* keep snapshot for trying moves in sync */
+  if (slv->eval_bv_model)
+    btor_lsutils_reset_cone (btor,
+                             slv->eval_bv_model,
+                             slv->eval_score,
+                             btor->bv_model,
+                             slv->score,
+                             slv->max_cans,
+                             slv->cone_index);
 
   slv->stats.moves += 1;
 
@@ -1327,6 +1527,7 @@ move (Btor *btor, uint32_t nmoves)
   }
 
   if (slv->max_move == BTOR_SLS_MOVE_RAND) update_assertion_weights (btor);
+  assert (check_formula_score_dbg (btor));
 
   /** cleanup **/
 DONE:
@@ -1344,6 +1545,66 @@ DONE:
 
 /*------------------------------------------------------------------------*/
 
+static void
+delete_weights (Btor *btor, BtorIntHashTable *weights)
+{
+  assert (btor);
+
+  BtorIntHashTableIterator it;
+
+  if (!weights) return;
+
+  btor_iter_hashint_init (&it, weights);
+  while (btor_iter_hashint_has_next (&it))
+    BTOR_DELETE (
+        btor->mm,
+        (BtorSLSConstrData *) btor_iter_hashint_next_data (&it)->as_ptr);
+  btor_hashint_map_delete (weights);
+}
+
+static void
+init_assertion_weight (Btor *btor, BtorIntHashTable *old_weights, int32_t id)
+{
+  assert (btor);
+
+  BtorSLSSolver *slv;
+  BtorSLSConstrData *d;
+  BtorHashTableData dd;
+
+  slv = BTOR_SLS_SOLVER (btor);
+  if (btor_hashint_map_contains (slv->weights, id)) return;
+
+  if (old_weights && btor_hashint_map_contains (old_weights, id))
+  {
+    btor_hashint_map_remove (old_weights, id, &dd);
+    d = dd.as_ptr;
+  }
+  else
+  {
+    BTOR_CNEW (btor->mm, d);
+    d->weight = 1; /* initial assertion weight */
+  }
+  btor_hashint_map_add (slv->weights, id)->as_ptr = d;
+}
+
+static void
+clone_data_as_constr_data_ptr (BtorMemMgr *mm,
+                               const void *map,
+                               BtorHashTableData *data,
+                               BtorHashTableData *cloned_data)
+{
+  assert (mm);
+  assert (data);
+  assert (cloned_data);
+
+  BtorSLSConstrData *d;
+
+  (void) map;
+  BTOR_NEW (mm, d);
+  memcpy (d, data->as_ptr, sizeof (BtorSLSConstrData));
+  cloned_data->as_ptr = d;
+}
+
 static BtorSLSSolver *
 clone_sls_solver (Btor *clone, BtorSLSSolver *slv, BtorNodeMap *exp_map)
 {
@@ -1389,6 +1650,14 @@ clone_sls_solver (Btor *clone, BtorSLSSolver *slv, BtorNodeMap *exp_map)
 
   res->max_cans = btor_hashint_map_clone (
       clone->mm, slv->max_cans, btor_clone_data_as_bv_ptr, 0);
+  res->weights = btor_hashint_map_clone (
+      clone->mm, slv->weights, clone_data_as_constr_data_ptr, 0);
+  res->warm_start =
+      btor_lsutils_clone_warm_start (clone->mm, slv->warm_start);
+  res->cone_index    = 0;
+  res->domains       = 0;
+  res->eval_bv_model = 0;
+  res->eval_score    = 0;
 
   return res;
 }
@@ -1410,6 +1679,10 @@ delete_sls_solver (BtorSLSSolver *slv)
 
   if (slv->score) btor_hashint_map_delete (slv->score);
   if (slv->roots) btor_hashint_map_delete (slv->roots);
+  if (slv->cone_index) btor_lsutils_delete_cone_index (slv->cone_index);
+  if (slv->domains) btor_proputils_delete_domains (btor, slv->domains);
+  if (slv->warm_start) btor_lsutils_delete_warm_start (slv->warm_start);
+  delete_eval_snapshot (slv);
   if (slv->weights)
   {
     btor_iter_hashint_init (&it, slv->weights);
@@ -1452,13 +1725,12 @@ sat_sls_solver (BtorSLSSolver *slv)
   assert (slv->btor);
   assert (slv->btor->slv == (BtorSolver *) slv);
 
-  int32_t j, max_steps, id, nmoves;
+  int32_t j, max_steps, nmoves;
   uint32_t nprops;
   BtorSolverResult sat_result;
   BtorNode *root;
-  BtorSLSConstrData *d;
   BtorPtrHashTableIterator pit;
-  BtorIntHashTableIterator iit;
+  BtorIntHashTable *old_weights;
   Btor *btor;
 
   btor = slv->btor;
@@ -1478,13 +1750,26 @@ sat_sls_solver (BtorSLSSolver *slv)
                       && btor->lambdas->count != 0),
               "sls engine supports QF_BV only");
 
-  /* Generate intial model, all bv vars are initialized with zero. We do
-   * not have to consider model_for_all_nodes, but let this be handled by
-   * the model generation (if enabled) after SAT has been determined. */
-  slv->api.generate_model ((BtorSolver *) slv, false, true);
+  /* Generate intial model, all bv vars are initialized with zero (or with
+   * their assignment of the previous call on warm start). We do not have to
+   * consider model_for_all_nodes, but let this be handled by the model
+   * generation (if enabled) after SAT has been determined. */
+  old_weights = 0;
+  if (slv->warm_start && btor_opt_get (btor, BTOR_OPT_SLS_WARM_START)
+      && btor_lsutils_is_warm_start_valid (btor, slv->warm_start))
+  {
+    btor_lsutils_init_model (btor, slv->warm_start);
+    old_weights = slv->weights;
+    slv->stats.warm_starts += 1;
+  }
+  else
+  {
+    slv->api.generate_model ((BtorSolver *) slv, false, true);
+    delete_weights (btor, slv->weights);
+  }
 
-  /* init assertion weights of ALL roots */
-  assert (!slv->weights);
+  /* init assertion weights of ALL roots (roots of the previous call keep
+   * their weight on warm start) */
   slv->weights = btor_hashint_map_new (btor->mm);
   assert (btor->synthesized_constraints->count == 0);
   btor_iter_hashptr_init (&pit, btor->unsynthesized_constraints);
@@ -1493,13 +1778,7 @@ sat_sls_solver (BtorSLSSolver *slv)
     root = btor_iter_hashptr_next (&pit);
     assert (!btor_hashptr_table_get (btor->unsynthesized_constraints,
                                      btor_node_invert (root)));
-    id = btor_node_get_id (root);
-    if (!btor_hashint_map_contains (slv->weights, id))
-    {
-      BTOR_CNEW (btor->mm, d);
-      d->weight = 1; /* initial assertion weight */
-      btor_hashint_map_add (slv->weights, id)->as_ptr = d;
-    }
+    init_assertion_weight (btor, old_weights, btor_node_get_id (root));
   }
   btor_iter_hashptr_init (&pit, btor->assumptions);
   while (btor_iter_hashptr_has_next (&pit))
@@ -1507,20 +1786,28 @@ sat_sls_solver (BtorSLSSolver *slv)
     root = btor_iter_hashptr_next (&pit);
     if (btor_hashptr_table_get (btor->unsynthesized_constraints,
                                 btor_node_invert (root)))
+    {
+      delete_weights (btor, old_weights);
       goto UNSAT;
+    }
     if (btor_hashptr_table_get (btor->assumptions, btor_node_invert (root)))
-      goto UNSAT;
-    id = btor_node_get_id (root);
-    if (!btor_hashint_map_contains (slv->weights, id))
     {
-      BTOR_CNEW (btor->mm, d);
-      d->weight = 1; /* initial assertion weight */
-      btor_hashint_map_add (slv->weights, id)->as_ptr = d;
+      delete_weights (btor, old_weights);
+      goto UNSAT;
     }
+    init_assertion_weight (btor, old_weights, btor_node_get_id (root));
   }
+  delete_weights (btor, old_weights);
 
   if (!slv->score) slv->score = btor_hashint_map_new (btor->mm);
 
+  assert (!slv->cone_index);
+  slv->cone_index = btor_lsutils_new_cone_index (btor);
+  assert (!slv->domains);
+  if (btor_opt_get (btor, BTOR_OPT_SLS_MOVE_PROP)
+      && btor_opt_get (btor, BTOR_OPT_PROP_USE_DOMAINS))
+    slv->domains = btor_proputils_new_domains (btor);
+
   for (;;)
   {
     if (btor_terminate (btor))
@@ -1558,6 +1845,7 @@ sat_sls_solver (BtorSLSSolver *slv)
     /* compute initial sls score */
     btor_slsutils_compute_sls_scores (
         btor, btor->bv_model, btor->fun_model, slv->score);
+    slv->formula_score = compute_sls_score_formula (btor, slv->score, 0);
 
     if (!slv->roots->count) goto SAT;
 
@@ -1580,6 +1868,7 @@ sat_sls_solver (BtorSLSSolver *slv)
     }
 
     /* restart */
+    delete_eval_snapshot (slv);
     slv->api.generate_model ((BtorSolver *) slv, false, true);
     btor_hashint_map_delete (slv->score);
     btor_hashint_map_delete (slv->roots);
@@ -1601,21 +1890,38 @@ DONE:
     btor_hashint_map_delete (slv->roots);
     slv->roots = 0;
   }
-  if (slv->weights)
+  /* remember model and assertion weights for the next call */
+  if (slv->warm_start)
   {
-    btor_iter_hashint_init (&iit, slv->weights);
-    while (btor_iter_hashint_has_next (&iit))
-      BTOR_DELETE (
-          btor->mm,
-          (BtorSLSConstrData *) btor_iter_hashint_next_data (&iit)->as_ptr);
-    btor_hashint_map_delete (slv->weights);
+    btor_lsutils_delete_warm_start (slv->warm_start);
+    slv->warm_start = 0;
+  }
+  if (btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+      && btor_opt_get (btor, BTOR_OPT_SLS_WARM_START) && btor->bv_model)
+  {
+    slv->warm_start = btor_lsutils_new_warm_start (btor);
+  }
+  else
+  {
+    delete_weights (btor, slv->weights);
     slv->weights = 0;
   }
+  delete_eval_snapshot (slv);
   if (slv->score)
   {
     btor_hashint_map_delete (slv->score);
     slv->score = 0;
   }
+  if (slv->cone_index)
+  {
+    btor_lsutils_delete_cone_index (slv->cone_index);
+    slv->cone_index = 0;
+  }
+  if (slv->domains)
+  {
+    btor_proputils_delete_domains (btor, slv->domains);
+    slv->domains = 0;
+  }
   return sat_result;
 }
 
@@ -1654,6 +1960,7 @@ print_stats_sls_solver (BtorSLSSolver *slv)
 
   BTOR_MSG (btor->msg, 1, "");
   BTOR_MSG (btor->msg, 1, "sls restarts: %d", slv->stats.restarts);
+  BTOR_MSG (btor->msg, 1, "sls warm starts: %u", slv->stats.warm_starts);
   BTOR_MSG (btor->msg, 1, "sls moves: %d", slv->stats.moves);
   BTOR_MSG (btor->msg, 1, "sls flips: %d", slv->stats.flips);
   BTOR_MSG (btor->msg, 1, "sls propagation steps: %u", slv->stats.props);
@@ -1666,6 +1973,14 @@ print_stats_sls_solver (BtorSLSSolver *slv)
             1,
             "sls propagation move conflicts (non-recoverable): %d",
             slv->stats.move_prop_non_rec_conf);
+  BTOR_MSG (btor->msg,
+            1,
+            "sls propagation paths selected by domains: %u",
+            slv->stats.move_prop_domain_paths);
+  BTOR_MSG (btor->msg,
+            1,
+            "sls propagation values projected into domains: %u",
+            slv->stats.move_prop_domain_values);
 
   BTOR_MSG (btor->msg, 1, "");
   BTOR_MSG (btor->msg, 1, "sls flip        moves: %d", slv->stats.move_flip);
@@ -1711,6 +2026,12 @@ print_time_stats_sls_solver (BtorSLSSolver *slv)
   Btor *btor = slv->btor;
 
   BTOR_MSG (btor->msg, 1, "");
+  BTOR_MSG (btor->msg,
+            1,
+            "%.2f seconds for trying moves (%.2f flips per second)",
+            slv->time.try_move,
+            slv->time.try_move > 0 ? slv->stats.flips / slv->time.try_move
+                                   : 0.0);
   BTOR_MSG (btor->msg,
             1,
             "%.2f seconds for updating cone (total)",
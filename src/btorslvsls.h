@@ -14,6 +14,7 @@
 #include "btorbv.h"
 #endif
 
+#include "btorlsutils.h"
 #include "btorslv.h"
 #include "utils/btorhashint.h"
 #include "utils/btorstack.h"
@@ -59,8 +60,20 @@ struct BtorSLSSolver
 
   BtorIntHashTable *roots;   /* must be map (for common local search funs)
                                 but does not maintain anything */
-  BtorIntHashTable *weights; /* also maintains assertion weights */
+  BtorIntHashTable *weights; /* also maintains assertion weights (kept
+                                across calls on warm start) */
   BtorIntHashTable *score;   /* sls score */
+  double formula_score;      /* weighted sum of the scores of all roots,
+                                maintained incrementally */
+
+  BtorLsConeIndex *cone_index; /* valid during sat call only */
+  BtorIntHashTable *domains;   /* valid during sat call only (prop moves) */
+  BtorLsWarmStart *warm_start; /* model of the previous sat call */
+
+  /* snapshot of the current model and score, candidate moves are tried on
+   * the snapshot and reset after each batch (valid during sat call only) */
+  BtorIntHashTable *eval_bv_model;
+  BtorIntHashTable *eval_score;
 
   uint32_t nflips; /* limit, disabled if 0 */
   bool terminate;
@@ -87,6 +100,7 @@ struct BtorSLSSolver
   struct
   {
     uint32_t restarts;
+    uint32_t warm_starts;
     uint32_t moves;
     uint32_t flips;
     uint32_t props;
@@ -101,6 +115,8 @@ struct BtorSLSSolver
     uint32_t move_prop;
     uint32_t move_prop_rec_conf;
     uint32_t move_prop_non_rec_conf;
+    uint32_t move_prop_domain_paths;
+    uint32_t move_prop_domain_values;
     uint32_t move_gw_flip;
     uint32_t move_gw_inc;
     uint32_t move_gw_dec;
@@ -114,6 +130,7 @@ struct BtorSLSSolver
 
   struct
   {
+    double try_move;
     double update_cone;
     double update_cone_reset;
     double update_cone_model_gen;
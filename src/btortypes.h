@@ -338,6 +338,16 @@ enum BtorOption
    */
   BTOR_OPT_FUN_PRESLS,
 
+  /*!
+    * **BTOR_OPT_FUN_PREPHASE**
+
+      Enable (``value``: 1) or disable (``value``: 0) seeding the phases of
+      the SAT solver with the input assignment of the prop or sls engine if
+      it fails to determine a result as preprocessing step, see
+      BTOR_OPT_FUN_PREPROP and BTOR_OPT_FUN_PRESLS.
+   */
+  BTOR_OPT_FUN_PREPHASE,
+
   /*!
     * **BTOR_OPT_FUN_DUAL_PROP**
 
@@ -409,6 +419,33 @@ enum BtorOption
 
   BTOR_OPT_FUN_STORE_LAMBDAS,
 
+  /*!
+    * **BTOR_OPT_FUN_WEAK_EQ**
+
+      Enable (``value``: 1) or disable (``value``: 0) weak equivalence
+      checking of array reads.
+
+      When enabled, each refinement iteration first checks all array reads
+      against the weak equivalence graph induced by the current model (store
+      chains and array conditionals) and generates read-over-write and
+      congruence lemmas for all conflicts at once before falling back to
+      regular lemmas on demand.
+  */
+  BTOR_OPT_FUN_WEAK_EQ,
+
+  /*!
+    * **BTOR_OPT_FUN_LEMMA_MIN**
+
+      Enable (``value``: 1) or disable (``value``: 0) minimization of
+      lemmas generated by the function solver.
+
+      When enabled, premises implied by other premises of the same lemma are
+      dropped, premises are normalized such that lemmas sharing the same
+      argument equalities map to the same term, and lemmas subsumed by
+      another lemma generated in the same refinement iteration are skipped.
+  */
+  BTOR_OPT_FUN_LEMMA_MIN,
+
   /*!
     * **BTOR_OPT_PRINT_DIMACS**
 
@@ -590,6 +627,17 @@ enum BtorOption
   */
   BTOR_OPT_SLS_USE_BANDIT,
 
+  /*!
+    * **BTOR_OPT_SLS_WARM_START**
+
+      | Enable (``value``: 1) or disable (``value``: 0) warm starts in
+        incremental mode.
+      | If enabled, the model and the assertion weights of the previous
+        satisfiability check are used as starting point as long as
+        assertions have only been added since.
+  */
+  BTOR_OPT_SLS_WARM_START,
+
   /* --------------------------------------------------------------------- */
   /*!
     **Prop Engine Options**:
@@ -622,6 +670,18 @@ enum BtorOption
   */
   BTOR_OPT_PROP_USE_BANDIT,
 
+  /*!
+    * **BTOR_OPT_PROP_USE_DOMAINS**
+
+      | Compute known bits and unsigned bounds of all nodes at the beginning
+        of each satisfiability check and use them to guide path selection
+        and value computation during propagation.
+      | Inputs that can not produce the computed value are avoided, values
+        that can not be produced are moved into the domain of the selected
+        input.
+  */
+  BTOR_OPT_PROP_USE_DOMAINS,
+
   /*!
     * **BTOR_OPT_PROP_PATH_SEL**
 
@@ -742,6 +802,27 @@ enum BtorOption
     */
   BTOR_OPT_PROP_NO_MOVE_ON_CONFLICT,
 
+  /*!
+    * **BTOR_OPT_PROP_NWALKERS**
+
+      Set the number of independent random walks (each in its own thread)
+      of the propagation-based local search. Walkers use different seeds and
+      path selection configurations, the first walker that determines a
+      result wins. The propagation limit BTOR_OPT_PROP_NPROPS applies per
+      walker. Only supported if compiled with pthreads.
+   */
+  BTOR_OPT_PROP_NWALKERS,
+
+  /*!
+    * **BTOR_OPT_PROP_WARM_START**
+
+      | Enable (``value``: 1) or disable (``value``: 0) warm starts in
+        incremental mode.
+      | If enabled, the model of the previous satisfiability check is used as
+        starting point as long as assertions have only been added since.
+  */
+  BTOR_OPT_PROP_WARM_START,
+
   /* --------------------------------------------------------------------- */
   /*!
     **AIGProp Engine Options**:
@@ -766,6 +847,16 @@ enum BtorOption
   */
   BTOR_OPT_AIGPROP_USE_BANDIT,
 
+  /*!
+    * **BTOR_OPT_AIGPROP_NSIM_FLIPS**
+
+      Set the number of additional random input flips that are evaluated
+      (bit-parallel, via AIG simulation) together with the propagation move
+      in each step. The move that satisfies the most roots is performed.
+      Disabled if 0.
+  */
+  BTOR_OPT_AIGPROP_NSIM_FLIPS,
+
   /* QUANT engine ------------------------------------------------------- */
   /*!
     * **BTOR_OPT_QUANT_SYNTH**
@@ -835,6 +926,16 @@ enum BtorOption
    */
   BTOR_OPT_QUANT_MINISCOPE,
 
+  /*!
+    * **BTOR_OPT_QUANT_NSOLVERS**
+
+      | Set the number of ground solver instances for the original formula
+        that run in parallel (requires a build with pthreads).
+      | Each additional instance uses a different seed and synthesis
+        configuration, counterexamples are shared between all instances.
+   */
+  BTOR_OPT_QUANT_NSOLVERS,
+
   /* internal options --------------------------------------------------- */
 
   BTOR_OPT_SORT_EXP,
@@ -850,6 +951,11 @@ enum BtorOption
   BTOR_OPT_SAT_ENGINE_CADICAL_FREEZE,
   BTOR_OPT_SAT_ENGINE_N_THREADS,
   BTOR_OPT_SIMP_NORMAMLIZE_ADDERS,
+  BTOR_OPT_SIMP_FRONTIER,
+  BTOR_OPT_SIMP_LINEAR_SYSTEMS,
+  BTOR_OPT_SIMP_KNOWN_BITS,
+  BTOR_OPT_SIMP_SYMMETRY,
+  BTOR_OPT_SIMP_PIPELINE,
   BTOR_OPT_DECLSORT_BV_WIDTH,
   BTOR_OPT_QUANT_SYNTH_ITE_COMPLETE,
   BTOR_OPT_QUANT_FIXSYNTH,
@@ -733,6 +733,21 @@ NEXT:
       PARSE_ARGS0 (tok);
       boolector_print_stats (btor);
     }
+    else if (!strcmp (tok, "get_simp_pass_stats"))
+    {
+      uint32_t runs, inconsistent;
+      double seconds;
+      uint64_t nodes_before, nodes_after, substitutions;
+      PARSE_ARGS1 (tok, str);
+      boolector_get_simp_pass_stats (btor,
+                                     arg1_str,
+                                     &runs,
+                                     &seconds,
+                                     &nodes_before,
+                                     &nodes_after,
+                                     &substitutions,
+                                     &inconsistent);
+    }
     else if (!strcmp (tok, "assert"))
     {
       PARSE_ARGS1 (tok, str);
@@ -782,6 +797,11 @@ NEXT:
       PARSE_ARGS1 (tok, str);
       boolector_set_sat_solver (btor, arg1_str);
     }
+    else if (!strcmp (tok, "set_simp_pipeline"))
+    {
+      PARSE_ARGS1 (tok, str);
+      boolector_set_simp_pipeline (btor, arg1_str);
+    }
     else if (!strcmp (tok, "set_opt"))
     {
       opt = parse_opt (&arg1_str);
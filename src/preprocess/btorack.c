@@ -10,28 +10,113 @@
 
 #include "btorcore.h"
 #include "btorexp.h"
+#include "btoropt.h"
 #include "utils/btornodeiter.h"
 #include "utils/btorutil.h"
 
+static bool
+has_const_args (BtorNode *app)
+{
+  BtorNode *arg;
+  BtorArgsIterator ait;
+
+  btor_iter_args_init (&ait, app->e[1]);
+  while (btor_iter_args_has_next (&ait))
+  {
+    arg = btor_iter_args_next (&ait);
+    if (!btor_node_is_bv_const (btor_node_real_addr (arg))) return false;
+  }
+  return true;
+}
+
+/* Returns the premise of the Ackermann constraint for 'app_i' and 'app_j',
+ * or 0 if the arguments are provably distinct, i.e., if they differ in two
+ * constants at some position or if the rewriter simplifies the equality of
+ * the arguments at some position to false. */
+static BtorNode *
+mk_args_eq (Btor *btor, BtorNode *app_i, BtorNode *app_j)
+{
+  BtorNode *a_i, *a_j, *eq, *tmp, *res;
+  BtorArgsIterator ait_i, ait_j;
+
+  assert (btor_node_get_sort_id (app_i->e[1])
+          == btor_node_get_sort_id (app_j->e[1]));
+
+  btor_iter_args_init (&ait_i, app_i->e[1]);
+  btor_iter_args_init (&ait_j, app_j->e[1]);
+  while (btor_iter_args_has_next (&ait_i))
+  {
+    a_i = btor_iter_args_next (&ait_i);
+    a_j = btor_iter_args_next (&ait_j);
+    if (a_i != a_j && btor_node_is_bv_const (btor_node_real_addr (a_i))
+        && btor_node_is_bv_const (btor_node_real_addr (a_j)))
+      return 0;
+  }
+
+  res = 0;
+  btor_iter_args_init (&ait_i, app_i->e[1]);
+  btor_iter_args_init (&ait_j, app_j->e[1]);
+  while (btor_iter_args_has_next (&ait_i))
+  {
+    a_i = btor_iter_args_next (&ait_i);
+    a_j = btor_iter_args_next (&ait_j);
+    eq  = btor_exp_eq (btor, a_i, a_j);
+
+    if (btor_node_is_bv_const_zero (btor, eq))
+    {
+      btor_node_release (btor, eq);
+      if (res) btor_node_release (btor, res);
+      return 0;
+    }
+
+    if (!res)
+      res = eq;
+    else
+    {
+      tmp = res;
+      res = btor_exp_bv_and (btor, tmp, eq);
+      btor_node_release (btor, tmp);
+      btor_node_release (btor, eq);
+    }
+  }
+  return res;
+}
+
 void
 btor_add_ackermann_constraints (Btor *btor)
 {
   assert (btor);
 
-  uint32_t i, j, num_constraints = 0;
+  bool incremental;
+  uint32_t i, j, num_constraints = 0, num_const, num_const_old;
+  uint_least64_t num_skipped = 0;
   double start, delta;
-  BtorNode *uf, *app_i, *app_j, *p, *c, *imp, *a_i, *a_j, *eq, *tmp;
+  BtorNode *uf, *app_i, *app_j, *p, *c, *imp;
   BtorNode *cur;
-  BtorArgsIterator ait_i, ait_j;
   BtorNodeIterator nit;
   BtorPtrHashTableIterator it;
   BtorNodePtrStack applies, visit;
-  BtorIntHashTable *cache;
+  BtorIntHashTable *cache, *new_applies;
   BtorMemMgr *mm;
 
   start = btor_util_time_stamp ();
   mm    = btor->mm;
-  cache = btor_hashint_table_new (mm);
+
+  /* In incremental mode, nodes reached in previous calls are cached and
+   * constraints are only added for pairs of applies where at least one of
+   * them has not been reached before. Ackermann constraints are valid
+   * independently of the constraints (and assumptions) they were derived
+   * from, hence applies reached via assumptions are also cached. */
+  incremental = btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+                && btor_opt_get (btor, BTOR_OPT_SIMP_FRONTIER);
+  if (incremental)
+  {
+    if (!btor->ack_cache) btor->ack_cache = btor_hashint_table_new (mm);
+    cache = btor->ack_cache;
+  }
+  else
+    cache = btor_hashint_table_new (mm);
+  new_applies = btor_hashint_table_new (mm);
   BTOR_INIT_STACK (mm, visit);
 
   btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
@@ -47,6 +132,8 @@ btor_add_ackermann_constraints (Btor *btor)
 
     if (btor_hashint_table_contains (cache, cur->id)) continue;
     btor_hashint_table_add (cache, cur->id);
+    if (btor_node_is_apply (cur))
+      btor_hashint_table_add (new_applies, cur->id);
 
     for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
   }
@@ -66,32 +153,41 @@ btor_add_ackermann_constraints (Btor *btor)
       BTOR_PUSH_STACK (applies, app_i);
     }
 
+    /* Applies on constant arguments only are grouped at the beginning of
+     * 'applies'. Their arguments are pairwise distinct (applies are hash
+     * consed), hence no constraints are required between them. Pairs of
+     * applies that were both reached in a previous call were already
+     * counted as skipped. */
+    for (i = 0, num_const = 0, num_const_old = 0;
+         i < BTOR_COUNT_STACK (applies);
+         i++)
+    {
+      app_i = BTOR_PEEK_STACK (applies, i);
+      if (!has_const_args (app_i)) continue;
+      BTOR_POKE_STACK (applies, i, BTOR_PEEK_STACK (applies, num_const));
+      BTOR_POKE_STACK (applies, num_const, app_i);
+      num_const++;
+      if (!btor_hashint_table_contains (new_applies, app_i->id))
+        num_const_old++;
+    }
+    num_skipped += (uint_least64_t) num_const * (num_const - 1) / 2
+                   - (uint_least64_t) num_const_old * (num_const_old - 1) / 2;
+
     for (i = 0; i < BTOR_COUNT_STACK (applies); i++)
     {
       app_i = BTOR_PEEK_STACK (applies, i);
-      for (j = i + 1; j < BTOR_COUNT_STACK (applies); j++)
+      for (j = i < num_const ? num_const : i + 1;
+           j < BTOR_COUNT_STACK (applies);
+           j++)
       {
         app_j = BTOR_PEEK_STACK (applies, j);
-        p     = 0;
-        assert (btor_node_get_sort_id (app_i->e[1])
-                == btor_node_get_sort_id (app_j->e[1]));
-        btor_iter_args_init (&ait_i, app_i->e[1]);
-        btor_iter_args_init (&ait_j, app_j->e[1]);
-        while (btor_iter_args_has_next (&ait_i))
+        if (!btor_hashint_table_contains (new_applies, app_i->id)
+            && !btor_hashint_table_contains (new_applies, app_j->id))
+          continue;
+        if (!(p = mk_args_eq (btor, app_i, app_j)))
         {
-          a_i = btor_iter_args_next (&ait_i);
-          a_j = btor_iter_args_next (&ait_j);
-          eq  = btor_exp_eq (btor, a_i, a_j);
-
-          if (!p)
-            p = eq;
-          else
-          {
-            tmp = p;
-            p   = btor_exp_bv_and (btor, tmp, eq);
-            btor_node_release (btor, tmp);
-            btor_node_release (btor, eq);
-          }
+          num_skipped++;
+          continue;
         }
         c   = btor_exp_eq (btor, app_i, app_j);
         imp = btor_exp_implies (btor, p, c);
@@ -105,12 +201,16 @@ btor_add_ackermann_constraints (Btor *btor)
     }
     BTOR_RELEASE_STACK (applies);
   }
-  btor_hashint_table_delete (cache);
+  if (!incremental) btor_hashint_table_delete (cache);
+  btor_hashint_table_delete (new_applies);
   delta = btor_util_time_stamp () - start;
+  btor->stats.ackermann_pairs_skipped += num_skipped;
   BTOR_MSG (btor->msg,
             1,
-            "added %d ackermann constraints in %.3f seconds",
+            "added %d ackermann constraints (%lld pairs with distinct "
+            "arguments skipped) in %.3f seconds",
             num_constraints,
+            num_skipped,
             delta);
   btor->time.ack += delta;
 }
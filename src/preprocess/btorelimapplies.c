@@ -24,8 +24,13 @@ eliminate_update_nodes (Btor *btor)
   uint32_t i;
   BtorNode *cur, *subst;
 
+  /* update nodes created before the last call to btor_simplify have
+   * already been eliminated */
+  i = btor_simplify_get_frontier (btor);
+  if (i == 0) i = 1;
+
   btor_init_substitutions (btor);
-  for (i = 1; i < BTOR_COUNT_STACK (btor->nodes_id_table); i++)
+  for (; i < BTOR_COUNT_STACK (btor->nodes_id_table); i++)
   {
     cur = BTOR_PEEK_STACK (btor->nodes_id_table, i);
     if (!cur || !btor_node_is_update (cur) || btor_node_is_simplified (cur))
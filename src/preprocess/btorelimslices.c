@@ -11,6 +11,7 @@
 #include "btorcore.h"
 #include "btorexp.h"
 #include "btorlog.h"
+#include "preprocess/btorpreprocess.h"
 #include "utils/btornodeiter.h"
 #include "utils/btorutil.h"
 
@@ -97,6 +98,31 @@ compare_int_ptr (const void *p1, const void *p2)
   return 0;
 }
 
+/* Check if 'var' has slices that were created since the last call to
+ * btor_simplify, i.e., slices that were not considered yet. */
+static bool
+has_new_slices (BtorNode *var, uint32_t frontier)
+{
+  BtorNode *cur;
+  BtorNodeIterator it;
+
+  btor_iter_parent_init (&it, var);
+  while (btor_iter_parent_has_next (&it))
+  {
+    cur = btor_iter_parent_next (&it);
+    if (btor_node_is_simplified (cur)) continue;
+    if (btor_node_is_bv_slice (cur) && (uint32_t) cur->id >= frontier)
+      return true;
+  }
+  return false;
+}
+
+/* Note: Variables are split destructively, i.e., we add var = concat (...)
+ *       and substitute var with the concatenation of fresh variables. In
+ *       incremental mode, the substitution serves as persistent record of
+ *       the split: slices on var added later on are rewritten to slices on
+ *       the fresh variables, which are then split on demand, and model
+ *       values of var are derived from the values of the fresh variables. */
 void
 btor_eliminate_slices_on_bv_vars (Btor *btor)
 {
@@ -107,7 +133,8 @@ btor_eliminate_slices_on_bv_vars (Btor *btor)
   BtorNodeIterator it;
   BtorPtrHashTable *slices;
   int32_t i;
-  uint32_t min, max, count;
+  uint32_t min, max, count, frontier;
+  bool reconsider;
   BtorNodePtrStack vars;
   double start, delta;
   BtorMemMgr *mm;
@@ -120,12 +147,20 @@ btor_eliminate_slices_on_bv_vars (Btor *btor)
 
   BTORLOG (1, "start slice elimination");
 
+  /* In incremental mode, processed variables that were not split might get
+   * new slices with subsequently added formulas. */
+  reconsider = btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+               && !btor_opt_get (btor, BTOR_OPT_NONDESTR_SUBST);
+  frontier   = btor_simplify_get_frontier (btor);
+
   mm = btor->mm;
   BTOR_INIT_STACK (mm, vars);
   for (b_var = btor->bv_vars->first; b_var != NULL; b_var = b_var->next)
   {
-    if (b_var->data.flag) continue;
     var = (BtorNode *) b_var->key;
+    if (b_var->data.flag
+        && (!reconsider || !has_new_slices (var, frontier)))
+      continue;
     BTOR_PUSH_STACK (vars, var);
     /* mark as processed, required for non-destructive substiution */
     b_var->data.flag = true;
@@ -195,6 +195,96 @@ create_pattern_memset (Btor *btor,
   return res;
 }
 
+/*
+ * Multi-dimensional range with rows of the same shape, e.g., a memset over
+ * a field of an array of structs or over a sub-matrix of a 2-D array:
+ *
+ *   l, l + d, ..., l + span, l + stride, ..., l + stride + span, ..., u
+ *
+ *   l <= i && i <= u && r <= span && (span - r) % d == 0
+ *   with r = (i - l) % stride
+ */
+static inline BtorNode *
+create_range_2d (Btor *btor,
+                 BtorNode *lower,
+                 BtorNode *upper,
+                 BtorNode *param,
+                 BtorBitVector *offset,
+                 BtorBitVector *stride,
+                 BtorBitVector *span)
+{
+  assert (btor_node_is_bv_const (lower));
+  assert (btor_node_is_bv_const (upper));
+  assert (btor_bv_compare (stride, span) > 0);
+
+  BtorNode *res, *range, *sub, *str, *rel, *spn, *in_row, *off, *rem, *zero;
+  BtorNode *eq, *tmp;
+  BtorBitVector *one;
+
+  one   = btor_bv_one (btor->mm, btor_bv_get_width (offset));
+  range = create_range (btor, lower, upper, param, one);
+  btor_bv_free (btor->mm, one);
+
+  sub    = btor_exp_bv_sub (btor, param, lower);
+  str    = btor_exp_bv_const (btor, stride);
+  rel    = btor_exp_bv_urem (btor, sub, str);
+  spn    = btor_exp_bv_const (btor, span);
+  in_row = btor_exp_bv_ulte (btor, rel, spn);
+  res    = btor_exp_bv_and (btor, range, in_row);
+
+  if (!btor_bv_is_one (offset))
+  {
+    zero = btor_exp_bv_zero (btor, btor_node_get_sort_id (lower));
+    off  = btor_exp_bv_const (btor, offset);
+    tmp  = btor_exp_bv_sub (btor, spn, rel);
+    rem  = btor_exp_bv_urem (btor, tmp, off);
+    eq   = btor_exp_eq (btor, rem, zero);
+    btor_node_release (btor, tmp);
+    tmp = res;
+    res = btor_exp_bv_and (btor, tmp, eq);
+    btor_node_release (btor, tmp);
+    btor_node_release (btor, eq);
+    btor_node_release (btor, rem);
+    btor_node_release (btor, off);
+    btor_node_release (btor, zero);
+  }
+
+  btor_node_release (btor, range);
+  btor_node_release (btor, sub);
+  btor_node_release (btor, str);
+  btor_node_release (btor, rel);
+  btor_node_release (btor, spn);
+  btor_node_release (btor, in_row);
+  return res;
+}
+
+/* pattern: 2-D range ? value : a[j] */
+static inline BtorNode *
+create_pattern_memset_2d (Btor *btor,
+                          BtorNode *lower,
+                          BtorNode *upper,
+                          BtorNode *value,
+                          BtorNode *array,
+                          BtorBitVector *offset,
+                          BtorBitVector *stride,
+                          BtorBitVector *span)
+{
+  BtorNode *res, *param, *ite, *read, *cond;
+
+  param = btor_exp_param (btor, btor_node_get_sort_id (lower), 0);
+  read  = btor_exp_read (btor, array, param);
+  cond  = create_range_2d (btor, lower, upper, param, offset, stride, span);
+  ite   = btor_exp_cond (btor, cond, value, read);
+  res   = btor_exp_lambda (btor, param, ite);
+
+  btor_node_release (btor, param);
+  btor_node_release (btor, read);
+  btor_node_release (btor, cond);
+  btor_node_release (btor, ite);
+
+  return res;
+}
+
 /* pattern: lower <= j <= upper && range_cond ? j : a[j] */
 static inline BtorNode *
 create_pattern_itoi (Btor *btor,
@@ -302,6 +392,44 @@ create_pattern_cpy (Btor *btor,
   return res;
 }
 
+/* pattern: lower <= j <= upper && range_cond ? c1 * j + c0 : a[j] */
+static inline BtorNode *
+create_pattern_affine (Btor *btor,
+                       BtorNode *lower,
+                       BtorNode *upper,
+                       BtorNode *array,
+                       BtorBitVector *offset,
+                       BtorBitVector *c1,
+                       BtorBitVector *c0)
+{
+  assert (btor_node_is_bv_const (lower));
+  assert (btor_node_is_bv_const (upper));
+  assert (btor_sort_fun_get_codomain (btor, btor_node_get_sort_id (array))
+          == btor_node_get_sort_id (lower));
+
+  BtorNode *res, *param, *ite, *read, *cond, *n1, *n0, *mul, *add;
+
+  param = btor_exp_param (btor, btor_node_get_sort_id (lower), 0);
+  read  = btor_exp_read (btor, array, param);
+  cond  = create_range (btor, lower, upper, param, offset);
+  n1    = btor_exp_bv_const (btor, c1);
+  n0    = btor_exp_bv_const (btor, c0);
+  mul   = btor_exp_bv_mul (btor, n1, param);
+  add   = btor_exp_bv_add (btor, mul, n0);
+  ite   = btor_exp_cond (btor, cond, add, read);
+  res   = btor_exp_lambda (btor, param, ite);
+
+  btor_node_release (btor, param);
+  btor_node_release (btor, read);
+  btor_node_release (btor, cond);
+  btor_node_release (btor, n1);
+  btor_node_release (btor, n0);
+  btor_node_release (btor, mul);
+  btor_node_release (btor, add);
+  btor_node_release (btor, ite);
+  return res;
+}
+
 static bool
 is_write_exp (BtorNode *exp,
               BtorNode **array,
@@ -1034,6 +1162,223 @@ find_ranges (Btor *btor,
   if (size_pat_inc) *size_pat_inc += size_pattern_inc;
 }
 
+/* Returns c1 with c1 * d = e if it exists, and 0 otherwise. */
+static BtorBitVector *
+get_affine_coeff (BtorMemMgr *mm, BtorBitVector *d, BtorBitVector *e)
+{
+  assert (!btor_bv_is_zero (d));
+
+  uint32_t k;
+  BtorBitVector *odd, *inv, *shifted, *res;
+
+  k = btor_bv_get_num_trailing_zeros (d);
+  if (!btor_bv_is_zero (e) && btor_bv_get_num_trailing_zeros (e) < k)
+    return 0;
+
+  odd     = btor_bv_srl_uint64 (mm, d, k);
+  inv     = btor_bv_mod_inverse (mm, odd);
+  shifted = btor_bv_srl_uint64 (mm, e, k);
+  res     = btor_bv_mul (mm, shifted, inv);
+  btor_bv_free (mm, odd);
+  btor_bv_free (mm, inv);
+  btor_bv_free (mm, shifted);
+  return res;
+}
+
+/* Returns the difference of the constants at position i + 1 and i. */
+static BtorBitVector *
+get_const_diff (BtorMemMgr *mm, BtorNodePtrStack *consts, uint32_t i)
+{
+  BtorNode *c0, *c1;
+
+  c0 = BTOR_PEEK_STACK (*consts, i);
+  c1 = BTOR_PEEK_STACK (*consts, i + 1);
+  return btor_bv_sub (mm, BTOR_CONST_GET_BITS (c1), BTOR_CONST_GET_BITS (c0));
+}
+
+/* Find ranges of constant indices with constant values where the values are
+ * an affine function c1 * i + c0 of the indices i. For each range the
+ * increment, c1 and c0 are pushed onto 'coeffs'. The remaining indices are
+ * kept in 'indices'. */
+static void
+find_affine_ranges (Btor *btor,
+                    BtorNodePtrStack *indices,
+                    BtorPtrHashTable *index_value_map,
+                    BtorNodePtrStack *ranges,
+                    BtorBitVectorPtrStack *coeffs,
+                    BtorNodePtrStack *indices_ranges,
+                    uint32_t *num_pat,
+                    uint32_t *size_pat)
+{
+  uint32_t i, j, lower, upper, cnt;
+  BtorNode *index, *value;
+  BtorBitVector *d, *e, *di, *ei, *c1, *c0, *tmp;
+  BtorNodePtrStack cands, values;
+  BtorMemMgr *mm;
+
+  mm = btor->mm;
+  BTOR_INIT_STACK (mm, cands);
+  BTOR_INIT_STACK (mm, values);
+
+  for (i = 0, j = 0; i < BTOR_COUNT_STACK (*indices); i++)
+  {
+    index = BTOR_PEEK_STACK (*indices, i);
+    value = btor_hashptr_table_get (index_value_map, index)->data.as_ptr;
+    if (btor_node_is_bv_const (index) && btor_node_is_bv_const (value)
+        && btor_node_get_sort_id (index) == btor_node_get_sort_id (value))
+      BTOR_PUSH_STACK (cands, index);
+    else
+      BTOR_POKE_STACK (*indices, j++, index);
+  }
+  indices->top = indices->start + j;
+
+  cnt = BTOR_COUNT_STACK (cands);
+  qsort (cands.start, cnt, sizeof (BtorNode *), cmp_abs_rel_indices);
+  for (i = 0; i < cnt; i++)
+  {
+    index = BTOR_PEEK_STACK (cands, i);
+    BTOR_PUSH_STACK (
+        values, btor_hashptr_table_get (index_value_map, index)->data.as_ptr);
+  }
+
+  lower = 0;
+  while (lower < cnt)
+  {
+    /* find maximal range with constant index and value increments */
+    upper = lower;
+    d = e = 0;
+    if (lower + 1 < cnt)
+    {
+      d     = get_const_diff (mm, &cands, lower);
+      e     = get_const_diff (mm, &values, lower);
+      upper = lower + 1;
+      while (upper + 1 < cnt)
+      {
+        di = get_const_diff (mm, &cands, upper);
+        ei = get_const_diff (mm, &values, upper);
+        j  = btor_bv_compare (d, di) == 0 && btor_bv_compare (e, ei) == 0;
+        btor_bv_free (mm, di);
+        btor_bv_free (mm, ei);
+        if (!j) break;
+        upper++;
+      }
+    }
+
+    /* ranges with less than three indices are not worth a lambda, a
+     * constant value increment is covered by memset patterns */
+    c1 = upper - lower > 1 ? get_affine_coeff (mm, d, e) : 0;
+    if (c1 && btor_bv_is_zero (c1))
+    {
+      btor_bv_free (mm, c1);
+      c1 = 0;
+    }
+
+    if (c1)
+    {
+      /* c0 = v_lower - c1 * i_lower */
+      tmp = btor_bv_mul (
+          mm, c1, BTOR_CONST_GET_BITS (BTOR_PEEK_STACK (cands, lower)));
+      c0 = btor_bv_sub (
+          mm, BTOR_CONST_GET_BITS (BTOR_PEEK_STACK (values, lower)), tmp);
+      btor_bv_free (mm, tmp);
+
+      BTOR_PUSH_STACK (*ranges, BTOR_PEEK_STACK (cands, lower));
+      BTOR_PUSH_STACK (*ranges, BTOR_PEEK_STACK (cands, upper));
+      BTOR_PUSH_STACK (*coeffs, btor_bv_copy (mm, d));
+      BTOR_PUSH_STACK (*coeffs, c1);
+      BTOR_PUSH_STACK (*coeffs, c0);
+      for (i = lower; i <= upper; i++)
+        BTOR_PUSH_STACK (*indices_ranges, BTOR_PEEK_STACK (cands, i));
+      BTOR_PUSH_STACK (*indices_ranges, 0);
+      *num_pat += 1;
+      *size_pat += upper - lower + 1;
+      lower = upper + 1;
+    }
+    /* the last index of a range may start a new range */
+    else if (upper - lower > 1)
+    {
+      for (; lower < upper; lower++)
+        BTOR_PUSH_STACK (*indices, BTOR_PEEK_STACK (cands, lower));
+    }
+    else
+    {
+      BTOR_PUSH_STACK (*indices, BTOR_PEEK_STACK (cands, lower));
+      lower++;
+    }
+    if (d) btor_bv_free (mm, d);
+    if (e) btor_bv_free (mm, e);
+  }
+  BTOR_RELEASE_STACK (cands);
+  BTOR_RELEASE_STACK (values);
+}
+
+/* Returns the number of consecutive memset ranges starting at 'i_range' that
+ * form a multi-dimensional range, i.e., that have the same increment, the
+ * same size, and lower bounds with a constant distance 'stride' greater than
+ * the size. */
+static uint32_t
+get_num_rows_2d (Btor *btor,
+                 BtorNodePtrStack *ranges,
+                 BtorBitVectorPtrStack *increments,
+                 uint32_t i_range,
+                 uint32_t i_inc,
+                 BtorBitVector **stride)
+{
+  uint32_t n;
+  bool same;
+  BtorNode *lower, *upper, *prev_lower;
+  BtorBitVector *span, *cur_span, *cur_stride;
+  BtorMemMgr *mm;
+
+  mm          = btor->mm;
+  *stride     = 0;
+  prev_lower  = BTOR_PEEK_STACK (*ranges, i_range);
+  upper       = BTOR_PEEK_STACK (*ranges, i_range + 1);
+  if (!btor_node_is_bv_const (prev_lower)) return 1;
+  span = btor_bv_sub (
+      mm, BTOR_CONST_GET_BITS (upper), BTOR_CONST_GET_BITS (prev_lower));
+
+  for (n = 1; i_range + 2 * n < BTOR_COUNT_STACK (*ranges) - 1; n++)
+  {
+    lower = BTOR_PEEK_STACK (*ranges, i_range + 2 * n);
+    if (!lower) break;
+    upper = BTOR_PEEK_STACK (*ranges, i_range + 2 * n + 1);
+    assert (btor_node_is_bv_const (lower));
+    assert (btor_node_is_bv_const (upper));
+
+    if (btor_bv_compare (BTOR_PEEK_STACK (*increments, i_inc),
+                         BTOR_PEEK_STACK (*increments, i_inc + n)))
+      break;
+
+    cur_span = btor_bv_sub (
+        mm, BTOR_CONST_GET_BITS (upper), BTOR_CONST_GET_BITS (lower));
+    same = btor_bv_compare (span, cur_span) == 0;
+    btor_bv_free (mm, cur_span);
+    if (!same) break;
+
+    cur_stride = btor_bv_sub (
+        mm, BTOR_CONST_GET_BITS (lower), BTOR_CONST_GET_BITS (prev_lower));
+    if (!*stride)
+    {
+      if (btor_bv_compare (cur_stride, span) <= 0)
+      {
+        btor_bv_free (mm, cur_stride);
+        break;
+      }
+      *stride = cur_stride;
+    }
+    else
+    {
+      same = btor_bv_compare (*stride, cur_stride) == 0;
+      btor_bv_free (mm, cur_stride);
+      if (!same) break;
+    }
+    prev_lower = lower;
+  }
+  btor_bv_free (mm, span);
+  return n;
+}
+
 static BtorPtrHashTable *
 create_static_rho (Btor *btor,
                    BtorNode *indices[],
@@ -1084,16 +1429,17 @@ extract_lambdas (Btor *btor,
   assert (map_value_index);
   assert (map_lambda_base);
 
-  bool is_top_eq;
-  BtorBitVector *inc;
-  uint32_t i_range, i_index, i_value, i_inc, i_index_r;
+  bool is_top_eq, is_inc_one;
+  BtorBitVector *inc, *stride, *span, *c1, *c0;
+  uint32_t i, n, i_range, i_index, i_value, i_inc, i_index_r;
   BtorNode *subst, *base, *tmp, *array, *value, *lower, *upper;
   BtorNode *src_array, *src_addr, *dst_addr;
   BtorPtrHashTableIterator it, iit;
   BtorPtrHashTable *t, *index_value_map, *static_rho;
   BtorPtrHashBucket *b;
   BtorNodePtrStack ranges, indices, values, indices_itoi, indices_itoip1;
-  BtorNodePtrStack indices_cpy, indices_rem, indices_ranges, *stack;
+  BtorNodePtrStack indices_cpy, indices_rem, indices_ranges, indices_2d;
+  BtorNodePtrStack *stack;
   BtorBitVectorPtrStack increments;
   BtorMemMgr *mm;
 
@@ -1102,6 +1448,7 @@ extract_lambdas (Btor *btor,
   uint32_t num_set = 0, num_set_inc = 0, num_set_itoi = 0, num_set_itoip1 = 0;
   uint32_t num_cpy = 0, size_set = 0, size_set_inc = 0, size_set_itoi = 0;
   uint32_t size_set_itoip1 = 0, size_cpy = 0;
+  uint32_t num_set_2d = 0, size_set_2d = 0, num_affine = 0, size_affine = 0;
 
   mm = btor->mm;
   BTOR_INIT_STACK (mm, ranges);
@@ -1113,6 +1460,7 @@ extract_lambdas (Btor *btor,
   BTOR_INIT_STACK (mm, indices_itoip1);
   BTOR_INIT_STACK (mm, indices_cpy);
   BTOR_INIT_STACK (mm, indices_rem);
+  BTOR_INIT_STACK (mm, indices_2d);
   btor_iter_hashptr_init (&it, map_value_index);
   while (btor_iter_hashptr_has_next (&it))
   {
@@ -1194,6 +1542,63 @@ extract_lambdas (Btor *btor,
         upper = BTOR_PEEK_STACK (ranges, i_range + 1);
         assert (i_inc < BTOR_COUNT_STACK (increments));
         inc = BTOR_PEEK_STACK (increments, i_inc);
+
+        /* merge ranges of the same shape into a multi-dimensional range */
+        n = get_num_rows_2d (
+            btor, &ranges, &increments, i_range, i_inc, &stride);
+        if (n > 1)
+        {
+          span = btor_bv_sub (
+              mm, BTOR_CONST_GET_BITS (upper), BTOR_CONST_GET_BITS (lower));
+          upper = BTOR_PEEK_STACK (ranges, i_range + 2 * n - 1);
+          tmp   = create_pattern_memset_2d (
+              btor, lower, upper, value, subst, inc, stride, span);
+          tmp->is_array = 1;
+          btor_node_release (btor, subst);
+          subst = tmp;
+          btor_bv_free (mm, stride);
+          btor_bv_free (mm, span);
+          /* all merged rows have the same increment */
+          is_inc_one = btor_bv_is_one (inc);
+          for (i = 0; i < n; i++)
+            btor_bv_free (mm, BTOR_PEEK_STACK (increments, i_inc + i));
+          i_inc += n;
+          i_range += 2 * (n - 1);
+
+          /* collect the indices of all merged ranges */
+          BTOR_RESET_STACK (indices_2d);
+          for (i = 0; i < n; i++)
+          {
+            for (; BTOR_PEEK_STACK (indices_ranges, i_index_r); i_index_r++)
+              BTOR_PUSH_STACK (indices_2d,
+                               BTOR_PEEK_STACK (indices_ranges, i_index_r));
+            i_index_r++;
+          }
+          BTOR_PUSH_STACK (indices_2d, 0);
+          static_rho = create_static_rho (btor, indices_2d.start, value, 0);
+          /* the merged rows were counted as 1-D ranges in find_ranges */
+          if (is_inc_one)
+          {
+            assert (num_set >= n);
+            assert (size_set >= static_rho->count);
+            num_set -= n;
+            size_set -= static_rho->count;
+          }
+          else
+          {
+            assert (num_set_inc >= n);
+            assert (size_set_inc >= static_rho->count);
+            num_set_inc -= n;
+            size_set_inc -= static_rho->count;
+          }
+          num_set_2d++;
+          size_set_2d += static_rho->count;
+          if (btor_node_lambda_get_static_rho (subst))
+            btor_node_lambda_delete_static_rho (btor, subst);
+          btor_node_lambda_set_static_rho (subst, static_rho);
+          continue;
+        }
+
         tmp = create_pattern_memset (btor, lower, upper, value, subst, inc);
         tmp->is_array = 1;
         btor_node_release (btor, subst);
@@ -1368,7 +1773,52 @@ extract_lambdas (Btor *btor,
       }
     }
 
-    num_total = num_set + num_set_inc + num_set_itoi + num_set_itoip1 + num_cpy;
+    /* pattern: index -> c1 * index + c0 */
+    BTOR_RESET_STACK (ranges);
+    BTOR_RESET_STACK (indices_ranges);
+    BTOR_RESET_STACK (increments);
+    find_affine_ranges (btor,
+                        &indices_rem,
+                        index_value_map,
+                        &ranges,
+                        &increments,
+                        &indices_ranges,
+                        &num_affine,
+                        &size_affine);
+    i_index_r = 0;
+    if (!BTOR_EMPTY_STACK (ranges))
+    {
+      assert (BTOR_COUNT_STACK (ranges) % 2 == 0);
+      assert (BTOR_COUNT_STACK (increments) / 3
+              == BTOR_COUNT_STACK (ranges) / 2);
+      for (i_range = 0, i_inc = 0; i_range < BTOR_COUNT_STACK (ranges) - 1;
+           i_range += 2, i_inc += 3)
+      {
+        lower = BTOR_PEEK_STACK (ranges, i_range);
+        upper = BTOR_PEEK_STACK (ranges, i_range + 1);
+        inc   = BTOR_PEEK_STACK (increments, i_inc);
+        c1    = BTOR_PEEK_STACK (increments, i_inc + 1);
+        c0    = BTOR_PEEK_STACK (increments, i_inc + 2);
+        tmp = create_pattern_affine (btor, lower, upper, subst, inc, c1, c0);
+        tmp->is_array = 1;
+        btor_node_release (btor, subst);
+        subst = tmp;
+        btor_bv_free (mm, inc);
+        btor_bv_free (mm, c1);
+        btor_bv_free (mm, c0);
+
+        assert (i_index_r < BTOR_COUNT_STACK (indices_ranges));
+        static_rho = create_static_rho (
+            btor, indices_ranges.start + i_index_r, 0, index_value_map);
+        i_index_r += static_rho->count + 1;
+        if (btor_node_lambda_get_static_rho (subst))
+          btor_node_lambda_delete_static_rho (btor, subst);
+        btor_node_lambda_set_static_rho (subst, static_rho);
+      }
+    }
+
+    num_total = num_set + num_set_inc + num_set_itoi + num_set_itoip1 + num_cpy
+                + num_set_2d + num_affine;
 
     /* we can skip creating writes if we did not find any pattern in a write
      * chain, and thus can leave the write chain as-is.
@@ -1414,6 +1864,7 @@ extract_lambdas (Btor *btor,
     BTOR_RESET_STACK (indices_itoip1);
     BTOR_RESET_STACK (indices_cpy);
     BTOR_RESET_STACK (indices_rem);
+    BTOR_RESET_STACK (indices_2d);
   }
   BTOR_RELEASE_STACK (ranges);
   BTOR_RELEASE_STACK (indices);
@@ -1424,22 +1875,32 @@ extract_lambdas (Btor *btor,
   BTOR_RELEASE_STACK (indices_itoip1);
   BTOR_RELEASE_STACK (indices_cpy);
   BTOR_RELEASE_STACK (indices_rem);
+  BTOR_RELEASE_STACK (indices_2d);
+
+  btor->stats.extracted_set_2d += num_set_2d;
+  btor->stats.extracted_affine += num_affine;
 
   BTOR_MSG (btor->msg,
             1,
             "set: %u (%u), "
             "set_inc: %u (%u), "
+            "set_2d: %u (%u), "
             "set_itoi: %u (%u), "
             "set_itoip1: %u (%u), "
+            "affine: %u (%u), "
             "cpy: %u (%u)",
             num_set,
             size_set,
             num_set_inc,
             size_set_inc,
+            num_set_2d,
+            size_set_2d,
             num_set_itoi,
             size_set_itoi,
             num_set_itoip1,
             size_set_itoip1,
+            num_affine,
+            size_affine,
             num_cpy,
             size_cpy);
   return num_total;
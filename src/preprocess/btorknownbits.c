@@ -0,0 +1,331 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btorknownbits.h"
+
+#include "btorbv.h"
+#include "btorcore.h"
+#include "btordbg.h"
+#include "btorexp.h"
+#include "btorlog.h"
+#include "btormsg.h"
+#include "btorproputils.h"
+#include "btorsubst.h"
+#include "utils/btorhashint.h"
+#include "utils/btorutil.h"
+
+/* maximum number of domain computation and rewriting rounds */
+#define BTOR_KNOWN_BITS_MAX_ROUNDS 10
+
+/* Returns 1 (0) if bit 'pos' of 'exp' is fixed to 1 (0), and -1 otherwise. */
+static int32_t
+get_known_bit (BtorIntHashTable *domains, BtorNode *exp, uint32_t pos)
+{
+  assert (domains);
+  assert (exp);
+
+  int32_t res;
+  BtorHashTableData *d;
+  BtorPropDomain *dom;
+
+  d = btor_hashint_map_get (domains, btor_node_real_addr (exp)->id);
+  if (!d) return -1;
+  dom = d->as_ptr;
+
+  if (btor_bv_get_bit (dom->lo, pos))
+    res = 1;
+  else if (!btor_bv_get_bit (dom->hi, pos))
+    res = 0;
+  else
+    return -1;
+  return btor_node_is_inverted (exp) ? 1 - res : res;
+}
+
+static bool
+is_known_equal_bit (BtorIntHashTable *domains,
+                    BtorNode *e0,
+                    BtorNode *e1,
+                    uint32_t pos)
+{
+  int32_t b0, b1;
+
+  b0 = get_known_bit (domains, e0, pos);
+  b1 = get_known_bit (domains, e1, pos);
+  return b0 != -1 && b0 == b1;
+}
+
+/* Number of most significant bits where 'e0' and 'e1' are fixed to the same
+ * value. */
+static uint32_t
+get_known_equal_prefix (Btor *btor,
+                        BtorIntHashTable *domains,
+                        BtorNode *e0,
+                        BtorNode *e1)
+{
+  uint32_t i, bw;
+
+  bw = btor_node_bv_get_width (btor, e0);
+  for (i = 0; i < bw && is_known_equal_bit (domains, e0, e1, bw - 1 - i); i++)
+    ;
+  return i;
+}
+
+/* Number of least significant bits where 'e0' and 'e1' are fixed to the same
+ * value. */
+static uint32_t
+get_known_equal_suffix (Btor *btor,
+                        BtorIntHashTable *domains,
+                        BtorNode *e0,
+                        BtorNode *e1)
+{
+  uint32_t i, bw;
+
+  bw = btor_node_bv_get_width (btor, e0);
+  for (i = 0; i < bw && is_known_equal_bit (domains, e0, e1, i); i++)
+    ;
+  return i;
+}
+
+static bool
+has_substituted_children (Btor *btor, BtorNode *exp)
+{
+  uint32_t i;
+
+  for (i = 0; i < exp->arity; i++)
+    if (btor_hashptr_table_get (btor->substitutions,
+                                btor_node_real_addr (exp->e[i])))
+      return true;
+  return false;
+}
+
+/* a < b  ->  a[n-p-1:0] < b[n-p-1:0]  if the upper p bits of a and b are
+ * fixed to the same value. */
+static BtorNode *
+narrow_ult (Btor *btor, BtorIntHashTable *domains, BtorNode *exp)
+{
+  uint32_t bw, p;
+  BtorNode *s0, *s1, *res;
+
+  bw = btor_node_bv_get_width (btor, exp->e[0]);
+  p  = get_known_equal_prefix (btor, domains, exp->e[0], exp->e[1]);
+  if (p == 0 || p == bw) return 0;
+
+  s0  = btor_exp_bv_slice (btor, exp->e[0], bw - p - 1, 0);
+  s1  = btor_exp_bv_slice (btor, exp->e[1], bw - p - 1, 0);
+  res = btor_exp_bv_ult (btor, s0, s1);
+  btor_node_release (btor, s0);
+  btor_node_release (btor, s1);
+  return res;
+}
+
+/* a = b  ->  a[n-p-1:s] = b[n-p-1:s]  if the upper p and the lower s bits of
+ * a and b are fixed to the same value. */
+static BtorNode *
+narrow_eq (Btor *btor, BtorIntHashTable *domains, BtorNode *exp)
+{
+  uint32_t bw, p, s;
+  BtorNode *s0, *s1, *res;
+
+  bw = btor_node_bv_get_width (btor, exp->e[0]);
+  p  = get_known_equal_prefix (btor, domains, exp->e[0], exp->e[1]);
+  if (p == bw) return 0;
+  s = get_known_equal_suffix (btor, domains, exp->e[0], exp->e[1]);
+  if (p + s == 0) return 0;
+  assert (p + s < bw);
+
+  s0  = btor_exp_bv_slice (btor, exp->e[0], bw - p - 1, s);
+  s1  = btor_exp_bv_slice (btor, exp->e[1], bw - p - 1, s);
+  res = btor_exp_eq (btor, s0, s1);
+  btor_node_release (btor, s0);
+  btor_node_release (btor, s1);
+  return res;
+}
+
+/* x[u:l]  ->  c1 :: x[u-p:l+s] :: c0  if the upper p and the lower s bits of
+ * the slice are fixed to c1 and c0, respectively. */
+static BtorNode *
+narrow_slice (Btor *btor, BtorPropDomain *d, BtorNode *exp)
+{
+  uint32_t bw, u, l, p, s;
+  BtorNode *c, *tmp, *res;
+  BtorBitVector *bits;
+
+  bw = btor_node_bv_get_width (btor, exp);
+  for (p = 0; p < bw
+              && btor_bv_get_bit (d->lo, bw - 1 - p)
+                     == btor_bv_get_bit (d->hi, bw - 1 - p);
+       p++)
+    ;
+  if (p == bw) return 0;
+  for (s = 0;
+       s < bw && btor_bv_get_bit (d->lo, s) == btor_bv_get_bit (d->hi, s);
+       s++)
+    ;
+  if (p + s == 0) return 0;
+  assert (p + s < bw);
+
+  u   = btor_node_bv_slice_get_upper (exp);
+  l   = btor_node_bv_slice_get_lower (exp);
+  res = btor_exp_bv_slice (btor, exp->e[0], u - p, l + s);
+  if (p)
+  {
+    bits = btor_bv_slice (btor->mm, d->lo, bw - 1, bw - p);
+    c    = btor_exp_bv_const (btor, bits);
+    tmp  = btor_exp_bv_concat (btor, c, res);
+    btor_node_release (btor, c);
+    btor_node_release (btor, res);
+    btor_bv_free (btor->mm, bits);
+    res = tmp;
+  }
+  if (s)
+  {
+    bits = btor_bv_slice (btor->mm, d->lo, s - 1, 0);
+    c    = btor_exp_bv_const (btor, bits);
+    tmp  = btor_exp_bv_concat (btor, res, c);
+    btor_node_release (btor, c);
+    btor_node_release (btor, res);
+    btor_bv_free (btor->mm, bits);
+    res = tmp;
+  }
+  return res;
+}
+
+static int32_t
+compare_ids (const void *p1, const void *p2)
+{
+  int32_t a = *((int32_t *) p1);
+  int32_t b = *((int32_t *) p2);
+  return a < b ? -1 : a > b;
+}
+
+/* Performs one round of rewriting based on the current domains and returns
+ * the number of rewritten nodes. */
+static uint32_t
+propagate_known_bits (Btor *btor)
+{
+  uint32_t i, res;
+  int32_t bit;
+  BtorNode *cur, *subst;
+  BtorPropDomain *d;
+  BtorIntHashTable *domains;
+  BtorIntHashTableIterator it;
+  BtorIntStack ids;
+  BtorMemMgr *mm;
+
+  mm      = btor->mm;
+  res     = 0;
+  domains = btor_proputils_new_domains (btor);
+
+  /* Process nodes bottom-up such that the substitutions of the children of a
+   * node are known when the node is rewritten. */
+  BTOR_INIT_STACK (mm, ids);
+  btor_iter_hashint_init (&it, domains);
+  while (btor_iter_hashint_has_next (&it))
+    BTOR_PUSH_STACK (ids, btor_iter_hashint_next (&it));
+  qsort (ids.start, BTOR_COUNT_STACK (ids), sizeof (int32_t), compare_ids);
+
+  btor_init_substitutions (btor);
+  for (i = 0; i < BTOR_COUNT_STACK (ids); i++)
+  {
+    cur = btor_node_get_by_id (btor, BTOR_PEEK_STACK (ids, i));
+    assert (cur);
+    assert (btor_node_is_regular (cur));
+
+    if (btor_node_is_bv_const (cur) || cur->parameterized
+        || btor_node_is_simplified (cur))
+      continue;
+
+    d     = btor_hashint_map_get (domains, cur->id)->as_ptr;
+    subst = 0;
+
+    if (btor_bv_compare (d->lo, d->hi) == 0)
+    {
+      subst = btor_exp_bv_const (btor, d->lo);
+      btor->stats.known_bits_consts++;
+    }
+    else if (btor_node_is_bv_cond (cur)
+             && (bit = get_known_bit (domains, cur->e[0], 0)) != -1)
+    {
+      subst = btor_node_copy (btor, bit ? cur->e[1] : cur->e[2]);
+      btor->stats.known_bits_conds++;
+    }
+    else if (has_substituted_children (btor, cur))
+    {
+      /* rewritten in the next round */
+      continue;
+    }
+    else if (btor_node_is_bv_slice (cur))
+    {
+      if ((subst = narrow_slice (btor, d, cur)))
+        btor->stats.known_bits_slices++;
+    }
+    else if (btor_node_is_bv_ult (cur))
+    {
+      if ((subst = narrow_ult (btor, domains, cur)))
+        btor->stats.known_bits_cmps++;
+    }
+    else if (btor_node_is_bv_eq (cur))
+    {
+      if ((subst = narrow_eq (btor, domains, cur)))
+        btor->stats.known_bits_cmps++;
+    }
+
+    if (!subst) continue;
+
+    BTORLOG (2,
+             "known bits: %s -> %s",
+             btor_util_node2string (cur),
+             btor_util_node2string (subst));
+    btor_insert_substitution (btor, cur, subst, false);
+    btor_node_release (btor, subst);
+    res++;
+  }
+
+  btor_substitute_and_rebuild (btor, btor->substitutions);
+  btor_delete_substitutions (btor);
+  BTOR_RELEASE_STACK (ids);
+  btor_proputils_delete_domains (btor, domains);
+  return res;
+}
+
+void
+btor_propagate_known_bits (Btor *btor)
+{
+  assert (btor);
+  assert (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2);
+  assert (btor_dbg_check_all_hash_tables_proxy_free (btor));
+
+  uint32_t n, total, rounds;
+  double start, delta;
+
+  start  = btor_util_time_stamp ();
+  total  = 0;
+  rounds = 0;
+
+  BTORLOG (1, "start known bits propagation");
+
+  /* Rewriting may fix further bits, e.g., after a constant was propagated
+   * into the operands of a node, iterate until a fixpoint is reached. */
+  do
+  {
+    rounds++;
+    n = propagate_known_bits (btor);
+    total += n;
+  } while (n && !btor->inconsistent && rounds < BTOR_KNOWN_BITS_MAX_ROUNDS);
+
+  BTORLOG (1, "end known bits propagation");
+
+  delta = btor_util_time_stamp () - start;
+  btor->time.known_bits += delta;
+  BTOR_MSG (btor->msg,
+            1,
+            "rewrote %u nodes based on known bits in %u rounds in %.3f seconds",
+            total,
+            rounds,
+            delta);
+}
@@ -0,0 +1,19 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORKNOWNBITS_H_INCLUDED
+#define BTORKNOWNBITS_H_INCLUDED
+
+#include "btortypes.h"
+
+/* Compute the known bits and unsigned bounds of all nodes in the cone of the
+ * constraints and use them to replace fixed nodes by constants, to narrow
+ * comparisons and slices, and to drop ite branches that are never taken. */
+void btor_propagate_known_bits (Btor* btor);
+
+#endif
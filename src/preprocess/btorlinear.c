@@ -0,0 +1,603 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btorlinear.h"
+
+#include "btorbv.h"
+#include "btorcore.h"
+#include "btordbg.h"
+#include "btorexp.h"
+#include "btorlog.h"
+#include "btormsg.h"
+#include "btorsubst.h"
+#include "utils/btorhashint.h"
+#include "utils/btorutil.h"
+
+/* maximum number of nodes visited when decomposing a linear term */
+#define BTOR_LINEAR_TERM_BOUND 1000
+/* maximum number of matrix cells of a linear system */
+#define BTOR_LINEAR_MAX_CELLS 100000
+
+/* A linear equation a_1 * x_1 + ... + a_k * x_k = rhs (mod 2^width). */
+struct BtorLinearEq
+{
+  BtorNode *eq;             /* original top-level equality */
+  uint32_t width;           /* bit-width of the operands */
+  BtorIntHashTable *coeffs; /* maps var ids to coefficients */
+  BtorBitVector *rhs;
+  bool solved; /* part of a system where variables were eliminated */
+};
+
+typedef struct BtorLinearEq BtorLinearEq;
+
+BTOR_DECLARE_STACK (BtorLinearEqPtr, BtorLinearEq *);
+
+static void
+delete_linear_eq (Btor *btor, BtorLinearEq *leq)
+{
+  BtorIntHashTableIterator it;
+
+  btor_iter_hashint_init (&it, leq->coeffs);
+  while (btor_iter_hashint_has_next (&it))
+    btor_bv_free (btor->mm, btor_iter_hashint_next_data (&it)->as_ptr);
+  btor_hashint_map_delete (leq->coeffs);
+  btor_bv_free (btor->mm, leq->rhs);
+  BTOR_DELETE (btor->mm, leq);
+}
+
+static void
+add_to (BtorMemMgr *mm, BtorBitVector **bv, const BtorBitVector *val)
+{
+  BtorBitVector *tmp;
+
+  tmp = btor_bv_add (mm, *bv, val);
+  btor_bv_free (mm, *bv);
+  *bv = tmp;
+}
+
+/* Decompose 'term' multiplied by 'factor' into a linear combination of
+ * variables (added to 'coeffs') and a constant (added to 'c'). */
+static bool
+add_linear_term (Btor *btor,
+                 BtorIntHashTable *coeffs,
+                 BtorBitVector **c,
+                 BtorNode *term,
+                 const BtorBitVector *factor,
+                 uint32_t *bound)
+{
+  bool res;
+  BtorNode *real, *other;
+  BtorBitVector *f, *bits;
+  BtorHashTableData *d;
+  BtorMemMgr *mm;
+
+  if (*bound == 0) return false;
+  *bound -= 1;
+
+  mm   = btor->mm;
+  real = btor_node_real_addr (term);
+
+  /* f * ~t = -f * t - f */
+  if (btor_node_is_inverted (term) && !btor_node_is_bv_const (real))
+  {
+    f   = btor_bv_neg (mm, factor);
+    res = add_linear_term (btor, coeffs, c, real, f, bound);
+    add_to (mm, c, f);
+    btor_bv_free (mm, f);
+    return res;
+  }
+
+  if (btor_node_is_bv_const (real))
+  {
+    bits = btor_node_is_inverted (term) ? btor_node_bv_const_get_invbits (real)
+                                        : btor_node_bv_const_get_bits (real);
+    f    = btor_bv_mul (mm, factor, bits);
+    add_to (mm, c, f);
+    btor_bv_free (mm, f);
+    return true;
+  }
+
+  if (btor_node_is_bv_var (real))
+  {
+    if ((d = btor_hashint_map_get (coeffs, real->id)))
+      add_to (mm, (BtorBitVector **) &d->as_ptr, factor);
+    else
+      btor_hashint_map_add (coeffs, real->id)->as_ptr =
+          btor_bv_copy (mm, factor);
+    return true;
+  }
+
+  if (btor_node_is_bv_add (real))
+    return add_linear_term (btor, coeffs, c, real->e[0], factor, bound)
+           && add_linear_term (btor, coeffs, c, real->e[1], factor, bound);
+
+  if (btor_node_is_bv_mul (real))
+  {
+    if (btor_node_is_bv_const (real->e[0]))
+    {
+      term  = real->e[0];
+      other = real->e[1];
+    }
+    else if (btor_node_is_bv_const (real->e[1]))
+    {
+      term  = real->e[1];
+      other = real->e[0];
+    }
+    else
+      return false;
+    bits = btor_node_is_inverted (term)
+               ? btor_node_bv_const_get_invbits (btor_node_real_addr (term))
+               : btor_node_bv_const_get_bits (term);
+    f    = btor_bv_mul (mm, factor, bits);
+    res  = add_linear_term (btor, coeffs, c, other, f, bound);
+    btor_bv_free (mm, f);
+    return res;
+  }
+
+  return false;
+}
+
+/* Decompose top-level equality 'eq' into a linear equation, returns 0 if
+ * 'eq' is not linear. */
+static BtorLinearEq *
+new_linear_eq (Btor *btor, BtorNode *eq)
+{
+  assert (btor_node_is_regular (eq));
+  assert (btor_node_is_bv_eq (eq));
+
+  uint32_t width, bound;
+  bool linear;
+  BtorBitVector *one, *minus_one, *c;
+  BtorIntHashTable *coeffs;
+  BtorLinearEq *res;
+  BtorMemMgr *mm;
+
+  mm    = btor->mm;
+  width = btor_node_bv_get_width (btor, eq->e[0]);
+  bound = BTOR_LINEAR_TERM_BOUND;
+
+  coeffs    = btor_hashint_map_new (mm);
+  c         = btor_bv_new (mm, width);
+  one       = btor_bv_one (mm, width);
+  minus_one = btor_bv_ones (mm, width);
+  /* e0 - e1 + c = 0 */
+  linear = add_linear_term (btor, coeffs, &c, eq->e[0], one, &bound)
+           && add_linear_term (btor, coeffs, &c, eq->e[1], minus_one, &bound);
+  btor_bv_free (mm, one);
+  btor_bv_free (mm, minus_one);
+
+  BTOR_CNEW (mm, res);
+  res->eq     = eq;
+  res->width  = width;
+  res->coeffs = coeffs;
+  res->rhs    = btor_bv_neg (mm, c);
+  btor_bv_free (mm, c);
+
+  if (!linear || coeffs->count == 0)
+  {
+    delete_linear_eq (btor, res);
+    return 0;
+  }
+  return res;
+}
+
+static int32_t
+compare_linear_eqs_by_width (const void *p1, const void *p2)
+{
+  BtorLinearEq *a = *((BtorLinearEq **) p1);
+  BtorLinearEq *b = *((BtorLinearEq **) p2);
+  if (a->width != b->width) return a->width < b->width ? -1 : 1;
+  return btor_node_get_id (a->eq) - btor_node_get_id (b->eq);
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Dense matrix representation of a linear system with all equations of
+ * the same bit-width. */
+struct BtorLinearSystem
+{
+  BtorMemMgr *mm;
+  uint32_t nrows, ncols;
+  BtorBitVector **m; /* nrows x ncols coefficient matrix */
+  BtorBitVector **rhs;
+};
+
+typedef struct BtorLinearSystem BtorLinearSystem;
+
+#define BTOR_LINEAR_CELL(sys, r, c) ((sys)->m[(r) * (sys)->ncols + (c)])
+
+/* row[dst] = row[dst] - mult * row[src] */
+static void
+sub_row (BtorLinearSystem *sys, uint32_t dst, uint32_t src, BtorBitVector *mult)
+{
+  uint32_t k;
+  BtorBitVector *tmp, *res;
+
+  for (k = 0; k < sys->ncols; k++)
+  {
+    if (btor_bv_is_zero (BTOR_LINEAR_CELL (sys, src, k))) continue;
+    tmp = btor_bv_mul (sys->mm, mult, BTOR_LINEAR_CELL (sys, src, k));
+    res = btor_bv_sub (sys->mm, BTOR_LINEAR_CELL (sys, dst, k), tmp);
+    btor_bv_free (sys->mm, tmp);
+    btor_bv_free (sys->mm, BTOR_LINEAR_CELL (sys, dst, k));
+    BTOR_LINEAR_CELL (sys, dst, k) = res;
+  }
+  tmp = btor_bv_mul (sys->mm, mult, sys->rhs[src]);
+  res = btor_bv_sub (sys->mm, sys->rhs[dst], tmp);
+  btor_bv_free (sys->mm, tmp);
+  btor_bv_free (sys->mm, sys->rhs[dst]);
+  sys->rhs[dst] = res;
+}
+
+/* row[r] = mult * row[r] */
+static void
+scale_row (BtorLinearSystem *sys, uint32_t r, BtorBitVector *mult)
+{
+  uint32_t k;
+  BtorBitVector *res;
+
+  for (k = 0; k < sys->ncols; k++)
+  {
+    res = btor_bv_mul (sys->mm, mult, BTOR_LINEAR_CELL (sys, r, k));
+    btor_bv_free (sys->mm, BTOR_LINEAR_CELL (sys, r, k));
+    BTOR_LINEAR_CELL (sys, r, k) = res;
+  }
+  res = btor_bv_mul (sys->mm, mult, sys->rhs[r]);
+  btor_bv_free (sys->mm, sys->rhs[r]);
+  sys->rhs[r] = res;
+}
+
+/* Pivot on cell (r, c) with value 2^v * u (u odd): normalize the pivot to
+ * 2^v and eliminate column c from all other rows where the coefficient is
+ * a multiple of 2^v. */
+static void
+pivot (BtorLinearSystem *sys, uint32_t r, uint32_t c)
+{
+  uint32_t k, v;
+  BtorBitVector *u, *inv, *mult, *cell;
+
+  cell = BTOR_LINEAR_CELL (sys, r, c);
+  v    = btor_bv_get_num_trailing_zeros (cell);
+  u    = btor_bv_srl_uint64 (sys->mm, cell, v);
+  inv  = btor_bv_mod_inverse (sys->mm, u);
+  scale_row (sys, r, inv);
+  btor_bv_free (sys->mm, inv);
+  btor_bv_free (sys->mm, u);
+
+  for (k = 0; k < sys->nrows; k++)
+  {
+    cell = BTOR_LINEAR_CELL (sys, k, c);
+    if (k == r || btor_bv_is_zero (cell)) continue;
+    if (btor_bv_get_num_trailing_zeros (cell) < v) continue;
+    mult = btor_bv_srl_uint64 (sys->mm, cell, v);
+    sub_row (sys, k, r, mult);
+    btor_bv_free (sys->mm, mult);
+  }
+}
+
+/* Build a_1 * x_1 + ... + a_k * x_k for row 'r', skipping column 'skip'. */
+static BtorNode *
+mk_row_term (Btor *btor,
+             BtorLinearSystem *sys,
+             BtorNodePtrStack *vars,
+             uint32_t r,
+             int32_t skip)
+{
+  uint32_t k;
+  BtorNode *res, *coeff, *mul, *tmp;
+
+  res = 0;
+  for (k = 0; k < sys->ncols; k++)
+  {
+    if ((int32_t) k == skip || btor_bv_is_zero (BTOR_LINEAR_CELL (sys, r, k)))
+      continue;
+    coeff = btor_exp_bv_const (btor, BTOR_LINEAR_CELL (sys, r, k));
+    mul   = btor_exp_bv_mul (btor, coeff, BTOR_PEEK_STACK (*vars, k));
+    btor_node_release (btor, coeff);
+    if (res)
+    {
+      tmp = btor_exp_bv_add (btor, res, mul);
+      btor_node_release (btor, res);
+      btor_node_release (btor, mul);
+      res = tmp;
+    }
+    else
+      res = mul;
+  }
+  return res;
+}
+
+/* Solve the system of linear equations 'eqs' (all of the same bit-width)
+ * via Hermite normal form modulo 2^width. Solved variables (with odd pivot)
+ * are added to the substitution table, the remaining reduced equations are
+ * pushed onto 'reduced'. Returns the number of solved variables. */
+static uint32_t
+solve_system (Btor *btor,
+              BtorLinearEq **eqs,
+              uint32_t neqs,
+              BtorNodePtrStack *reduced)
+{
+  uint32_t i, j, r, c, width, nsolved, v, minv;
+  int32_t *pcol, pr, pc;
+  bool *cpivot;
+  BtorNode *var, *def, *term, *rhs, *eq;
+  BtorIntHashTable *cols;
+  BtorIntHashTableIterator it;
+  BtorHashTableData *d;
+  BtorNodePtrStack vars;
+  BtorLinearSystem sys;
+  BtorBitVector *cell;
+  BtorMemMgr *mm;
+
+  mm      = btor->mm;
+  width   = eqs[0]->width;
+  nsolved = 0;
+
+  /* assign columns to variables */
+  cols = btor_hashint_map_new (mm);
+  BTOR_INIT_STACK (mm, vars);
+  for (i = 0; i < neqs; i++)
+  {
+    btor_iter_hashint_init (&it, eqs[i]->coeffs);
+    while (btor_iter_hashint_has_next (&it))
+    {
+      j = btor_iter_hashint_next (&it);
+      if (btor_hashint_map_contains (cols, j)) continue;
+      btor_hashint_map_add (cols, j)->as_int = BTOR_COUNT_STACK (vars);
+      BTOR_PUSH_STACK (vars, btor_node_get_by_id (btor, j));
+    }
+  }
+
+  sys.mm    = mm;
+  sys.nrows = neqs;
+  sys.ncols = BTOR_COUNT_STACK (vars);
+
+  if ((uint64_t) sys.nrows * sys.ncols > BTOR_LINEAR_MAX_CELLS)
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "skip linear system of %u equations over %u variables "
+              "of width %u",
+              sys.nrows,
+              sys.ncols,
+              width);
+    goto DONE;
+  }
+
+  BTOR_NEWN (mm, sys.m, sys.nrows * sys.ncols);
+  BTOR_NEWN (mm, sys.rhs, sys.nrows);
+  for (r = 0; r < sys.nrows; r++)
+  {
+    for (c = 0; c < sys.ncols; c++)
+      BTOR_LINEAR_CELL (&sys, r, c) = btor_bv_new (mm, width);
+    btor_iter_hashint_init (&it, eqs[r]->coeffs);
+    while (btor_iter_hashint_has_next (&it))
+    {
+      cell = eqs[r]->coeffs->data[it.cur_pos].as_ptr;
+      d    = btor_hashint_map_get (cols, btor_iter_hashint_next (&it));
+      btor_bv_free (mm, BTOR_LINEAR_CELL (&sys, r, d->as_int));
+      BTOR_LINEAR_CELL (&sys, r, d->as_int) = btor_bv_copy (mm, cell);
+    }
+    sys.rhs[r] = btor_bv_copy (mm, eqs[r]->rhs);
+  }
+
+  BTOR_CNEWN (mm, pcol, sys.nrows);
+  BTOR_CNEWN (mm, cpivot, sys.ncols);
+  for (r = 0; r < sys.nrows; r++) pcol[r] = -1;
+
+  /* eliminate all variables with an odd coefficient, these can be solved
+   * for by multiplying with the modular inverse */
+  for (c = 0; c < sys.ncols; c++)
+  {
+    for (r = 0; r < sys.nrows; r++)
+    {
+      if (pcol[r] >= 0 || !btor_bv_get_bit (BTOR_LINEAR_CELL (&sys, r, c), 0))
+        continue;
+      pivot (&sys, r, c);
+      pcol[r]   = c;
+      cpivot[c] = true;
+      nsolved++;
+      break;
+    }
+  }
+
+  /* reduce remaining equations, in each step pivot on the coefficient with
+   * the least number of trailing zeros */
+  for (;;)
+  {
+    pr = pc = -1;
+    minv    = width;
+    for (r = 0; r < sys.nrows; r++)
+    {
+      if (pcol[r] >= 0) continue;
+      for (c = 0; c < sys.ncols; c++)
+      {
+        cell = BTOR_LINEAR_CELL (&sys, r, c);
+        if (cpivot[c] || btor_bv_is_zero (cell)) continue;
+        v = btor_bv_get_num_trailing_zeros (cell);
+        if (v < minv)
+        {
+          minv = v;
+          pr   = r;
+          pc   = c;
+        }
+      }
+    }
+    if (pr < 0) break;
+    assert (minv > 0);
+    pivot (&sys, pr, pc);
+    pcol[pr]   = pc;
+    cpivot[pc] = true;
+  }
+
+  /* all coefficients of non-pivot rows are zero */
+  for (r = 0; r < sys.nrows; r++)
+  {
+    if (pcol[r] < 0 && !btor_bv_is_zero (sys.rhs[r]))
+    {
+      BTORLOG (1, "linear system is inconsistent");
+      btor->inconsistent = true;
+    }
+  }
+
+  if (nsolved && !btor->inconsistent)
+  {
+    for (r = 0; r < sys.nrows; r++)
+    {
+      if (pcol[r] < 0) continue;
+
+      rhs = btor_exp_bv_const (btor, sys.rhs[r]);
+      if (btor_bv_is_one (BTOR_LINEAR_CELL (&sys, r, pcol[r])))
+      {
+        /* x = rhs - (a_1 * x_1 + ... + a_k * x_k) */
+        var  = BTOR_PEEK_STACK (vars, pcol[r]);
+        term = mk_row_term (btor, &sys, &vars, r, pcol[r]);
+        if (term)
+        {
+          def = btor_exp_bv_sub (btor, rhs, term);
+          btor_node_release (btor, term);
+        }
+        else
+          def = btor_node_copy (btor, rhs);
+        BTORLOG (2,
+                 "linear substitution: %s -> %s",
+                 btor_util_node2string (var),
+                 btor_util_node2string (def));
+        btor_insert_substitution (btor, var, def, false);
+        btor_node_release (btor, def);
+      }
+      else
+      {
+        term = mk_row_term (btor, &sys, &vars, r, -1);
+        eq   = btor_exp_eq (btor, term, rhs);
+        BTOR_PUSH_STACK (*reduced, eq);
+        btor_node_release (btor, term);
+      }
+      btor_node_release (btor, rhs);
+    }
+  }
+
+  BTOR_DELETEN (mm, pcol, sys.nrows);
+  BTOR_DELETEN (mm, cpivot, sys.ncols);
+  for (r = 0; r < sys.nrows; r++)
+  {
+    for (c = 0; c < sys.ncols; c++)
+      btor_bv_free (mm, BTOR_LINEAR_CELL (&sys, r, c));
+    btor_bv_free (mm, sys.rhs[r]);
+  }
+  BTOR_DELETEN (mm, sys.m, sys.nrows * sys.ncols);
+  BTOR_DELETEN (mm, sys.rhs, sys.nrows);
+DONE:
+  BTOR_RELEASE_STACK (vars);
+  btor_hashint_map_delete (cols);
+  return nsolved;
+}
+
+/*------------------------------------------------------------------------*/
+
+void
+btor_solve_linear_systems (Btor *btor)
+{
+  assert (btor);
+  assert (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2);
+  assert (btor_dbg_check_all_hash_tables_proxy_free (btor));
+
+  uint32_t i, j, k, n, nsolved, nsystems;
+  double start, delta;
+  BtorNode *cur, *tru;
+  BtorLinearEq *leq;
+  BtorLinearEqPtrStack eqs;
+  BtorNodePtrStack reduced;
+  BtorPtrHashTableIterator it;
+  BtorIntHashTable *keep;
+  BtorMemMgr *mm;
+
+  start    = btor_util_time_stamp ();
+  mm       = btor->mm;
+  nsolved  = 0;
+  nsystems = 0;
+
+  BTOR_INIT_STACK (mm, eqs);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    if (btor_node_is_inverted (cur) || !btor_node_is_bv_eq (cur)) continue;
+    if ((leq = new_linear_eq (btor, cur))) BTOR_PUSH_STACK (eqs, leq);
+  }
+
+  if (BTOR_EMPTY_STACK (eqs)) goto DONE;
+
+  BTORLOG (1, "start linear system solving");
+
+  qsort (eqs.start,
+         BTOR_COUNT_STACK (eqs),
+         sizeof (BtorLinearEq *),
+         compare_linear_eqs_by_width);
+
+  btor_init_substitutions (btor);
+  BTOR_INIT_STACK (mm, reduced);
+  keep = btor_hashint_table_new (mm);
+  tru  = btor_exp_true (btor);
+
+  for (i = 0; i < BTOR_COUNT_STACK (eqs) && !btor->inconsistent; i = j)
+  {
+    for (j = i + 1; j < BTOR_COUNT_STACK (eqs)
+                    && BTOR_PEEK_STACK (eqs, j)->width
+                           == BTOR_PEEK_STACK (eqs, i)->width;
+         j++)
+      ;
+    nsystems++;
+    n = solve_system (btor, eqs.start + i, j - i, &reduced);
+    if (!n) continue;
+    nsolved += n;
+    for (k = i; k < j; k++) BTOR_PEEK_STACK (eqs, k)->solved = true;
+  }
+
+  if (nsolved && !btor->inconsistent)
+  {
+    /* The solved variables and the reduced equations are equivalent to the
+     * original equations, which are therefore substituted with true. */
+    for (i = 0; i < BTOR_COUNT_STACK (reduced); i++)
+      btor_hashint_table_add (
+          keep, btor_node_get_id (BTOR_PEEK_STACK (reduced, i)));
+    for (i = 0; i < BTOR_COUNT_STACK (eqs); i++)
+    {
+      leq = BTOR_PEEK_STACK (eqs, i);
+      if (!leq->solved
+          || btor_hashint_table_contains (keep, btor_node_get_id (leq->eq)))
+        continue;
+      btor_insert_substitution (btor, leq->eq, tru, false);
+    }
+    for (i = 0; i < BTOR_COUNT_STACK (reduced); i++)
+      btor_assert_exp (btor, BTOR_PEEK_STACK (reduced, i));
+    btor_substitute_and_rebuild (btor, btor->substitutions);
+    btor->stats.linear_vars_eliminated += nsolved;
+  }
+
+  btor_node_release (btor, tru);
+  btor_hashint_table_delete (keep);
+  while (!BTOR_EMPTY_STACK (reduced))
+    btor_node_release (btor, BTOR_POP_STACK (reduced));
+  BTOR_RELEASE_STACK (reduced);
+  btor_delete_substitutions (btor);
+  BTORLOG (1, "end linear system solving");
+
+DONE:
+  while (!BTOR_EMPTY_STACK (eqs)) delete_linear_eq (btor, BTOR_POP_STACK (eqs));
+  BTOR_RELEASE_STACK (eqs);
+
+  delta = btor_util_time_stamp () - start;
+  btor->time.linear += delta;
+  BTOR_MSG (btor->msg,
+            1,
+            "eliminated %u variables in %u linear systems in %.3f seconds",
+            nsolved,
+            nsystems,
+            delta);
+}
@@ -0,0 +1,18 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORLINEAR_H_INCLUDED
+#define BTORLINEAR_H_INCLUDED
+
+#include "btortypes.h"
+
+/* Solve the system of linear top-level equations over bit-vectors modulo
+ * 2^n and eliminate all variables with an invertible pivot. */
+void btor_solve_linear_systems (Btor* btor);
+
+#endif
@@ -505,5 +505,6 @@ btor_normalize_adds (Btor *btor)
   btor_hashint_table_delete (cache);
 
   double delta = btor_util_time_stamp () - start;
+  btor->time.normadd += delta;
   BTOR_MSG (btor->msg, 1, "normalized adds in %.3f seconds", delta);
 }
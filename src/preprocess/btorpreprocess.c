@@ -19,31 +19,288 @@
 #include "preprocess/btorelimslices.h"
 #include "preprocess/btorembed.h"
 #include "preprocess/btorextract.h"
+#include "preprocess/btorknownbits.h"
+#include "preprocess/btorlinear.h"
 #include "preprocess/btormerge.h"
 #include "preprocess/btornormadd.h"
+#include "preprocess/btorskel.h"
+#include "preprocess/btorsymmetry.h"
 #include "preprocess/btorunconstrained.h"
 #include "preprocess/btorvarsubst.h"
-#ifndef BTOR_DO_NOT_PROCESS_SKELETON
-#include "preprocess/btorskel.h"
-#endif
 #include "utils/btorhashptr.h"
 #include "utils/btornodeiter.h"
 #include "utils/btorutil.h"
 
+#include <ctype.h>
+
+/* Corresponds to the order in which the passes were run before the pipeline
+ * was made configurable. */
+#define BTOR_SIMP_PIPELINE_DFLT                                             \
+  "elimslices,skeleton,linear,knownbits,symmetry,ucopt,extract,merge,"     \
+  "elimapplies,ackermann,normadd"
+
+const char *const g_btor_simp_pass_names[BTOR_SIMP_PASS_NUM] = {
+    "varsubst",
+    "embedded",
+    "elimslices",
+    "skeleton",
+    "linear",
+    "knownbits",
+    "symmetry",
+    "ucopt",
+    "extract",
+    "merge",
+    "elimapplies",
+    "ackermann",
+    "normadd",
+};
+
+uint32_t
+btor_simplify_get_frontier (Btor *btor)
+{
+  assert (btor);
+
+  if (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+      || !btor_opt_get (btor, BTOR_OPT_SIMP_FRONTIER))
+    return 0;
+  return btor->simp_frontier;
+}
+
+/* Check if there is nothing to preprocess since the last call, i.e., no new
+ * constraints and no lambdas or UFs that have to be processed for new
+ * assumptions. */
+static bool
+is_frontier_empty (Btor *btor)
+{
+  assert (btor);
+
+  if (!btor_simplify_get_frontier (btor)) return false;
+  if (btor->varsubst_constraints->count || btor->embedded_constraints->count
+      || btor->unsynthesized_constraints->count)
+    return false;
+  if (btor->lambdas->count) return false;
+  if (btor->ufs->count && btor_opt_get (btor, BTOR_OPT_ACKERMANN)) return false;
+  return true;
+}
+
+/* Check if 'pass' is required by the solver engines, which is the case if its
+ * option is enabled. Such passes are always run and can not be removed from
+ * the pipeline. */
+static bool
+is_pass_mandatory (BtorSimpPass pass)
+{
+  return pass == BTOR_SIMP_PASS_ELIM_APPLIES || pass == BTOR_SIMP_PASS_ACKERMANN;
+}
+
+/* Check if 'pass' can be run in the current configuration. If the pipeline
+ * was configured explicitly, optional passes are enabled by being listed in
+ * the pipeline rather than by their corresponding options. Restrictions on
+ * the formula that btor_check_sat enforces by disabling these options are
+ * checked independently. */
+static bool
+is_pass_enabled (Btor *btor, BtorSimpPass pass, bool explicit)
+{
+  bool rwl3 = btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2;
+
+  switch (pass)
+  {
+    case BTOR_SIMP_PASS_ELIM_SLICES:
+      /* not sound with UFs and not supported with quantifiers */
+      return rwl3
+             && (explicit || btor_opt_get (btor, BTOR_OPT_ELIMINATE_SLICES))
+             && btor->ufs->count == 0 && btor->quantifiers->count == 0;
+    case BTOR_SIMP_PASS_SKELETON:
+      return rwl3
+             && (explicit || btor_opt_get (btor, BTOR_OPT_SKELETON_PREPROC))
+             && (!btor_simplify_get_frontier (btor)
+                 || btor->unsynthesized_constraints->count);
+    case BTOR_SIMP_PASS_LINEAR:
+      return rwl3
+             && (explicit || btor_opt_get (btor, BTOR_OPT_SIMP_LINEAR_SYSTEMS));
+    case BTOR_SIMP_PASS_KNOWN_BITS:
+      return rwl3 && (explicit || btor_opt_get (btor, BTOR_OPT_SIMP_KNOWN_BITS));
+    case BTOR_SIMP_PASS_SYMMETRY:
+      return rwl3 && (explicit || btor_opt_get (btor, BTOR_OPT_SIMP_SYMMETRY))
+             && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL);
+    case BTOR_SIMP_PASS_UCOPT:
+      return rwl3 && (explicit || btor_opt_get (btor, BTOR_OPT_UCOPT))
+             && btor->quantifiers->count == 0
+             && ((!btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+                  && !btor_opt_get (btor, BTOR_OPT_MODEL_GEN))
+                 || !btor_opt_get (btor, BTOR_OPT_NONDESTR_SUBST));
+    case BTOR_SIMP_PASS_EXTRACT:
+      return rwl3
+             && (explicit || btor_opt_get (btor, BTOR_OPT_EXTRACT_LAMBDAS));
+    case BTOR_SIMP_PASS_MERGE:
+      return rwl3 && (explicit || btor_opt_get (btor, BTOR_OPT_MERGE_LAMBDAS));
+    case BTOR_SIMP_PASS_ELIM_APPLIES:
+      return btor_opt_get (btor, BTOR_OPT_BETA_REDUCE);
+    case BTOR_SIMP_PASS_ACKERMANN:
+      return btor_opt_get (btor, BTOR_OPT_ACKERMANN);
+    case BTOR_SIMP_PASS_NORMADD:
+      return rwl3
+             && (explicit
+                 || btor_opt_get (btor, BTOR_OPT_SIMP_NORMAMLIZE_ADDERS));
+    default:
+      assert (pass == BTOR_SIMP_PASS_VAR_SUBST
+              || pass == BTOR_SIMP_PASS_EMBEDDED);
+      return true;
+  }
+}
+
+/* Run 'pass' and record its statistics. */
+static void
+run_pass (Btor *btor, BtorSimpPass pass)
+{
+  double start;
+  uint_least64_t simplified;
+  BtorSimpPassStats *stats;
+
+  start      = btor_util_time_stamp ();
+  stats      = &btor->stats.simp_passes[pass];
+  simplified = btor->stats.simplified_exps;
+  stats->runs++;
+  stats->nodes_before += btor_number_of_ops (btor);
+
+  switch (pass)
+  {
+    case BTOR_SIMP_PASS_VAR_SUBST: btor_substitute_var_exps (btor); break;
+    case BTOR_SIMP_PASS_EMBEDDED:
+      btor_process_embedded_constraints (btor);
+      break;
+    case BTOR_SIMP_PASS_ELIM_SLICES:
+      btor_eliminate_slices_on_bv_vars (btor);
+      break;
+    case BTOR_SIMP_PASS_SKELETON: btor_process_skeleton (btor); break;
+    case BTOR_SIMP_PASS_LINEAR: btor_solve_linear_systems (btor); break;
+    case BTOR_SIMP_PASS_KNOWN_BITS: btor_propagate_known_bits (btor); break;
+    case BTOR_SIMP_PASS_SYMMETRY: btor_break_symmetries (btor); break;
+    case BTOR_SIMP_PASS_UCOPT: btor_optimize_unconstrained (btor); break;
+    case BTOR_SIMP_PASS_EXTRACT: btor_extract_lambdas (btor); break;
+    case BTOR_SIMP_PASS_MERGE: btor_merge_lambdas (btor); break;
+    case BTOR_SIMP_PASS_ELIM_APPLIES:
+      /* If no UFs or function equalities are present, we eagerly eliminate all
+       * remaining lambdas. */
+      if (btor->ufs->count == 0 && btor->feqs->count == 0
+          && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL))
+      {
+        BTOR_MSG (btor->msg,
+                  1,
+                  "no UFs or function equalities, enable beta-reduction=all");
+        btor_opt_set (btor, BTOR_OPT_BETA_REDUCE, BTOR_BETA_REDUCE_ALL);
+      }
+      btor_eliminate_applies (btor);
+      break;
+    case BTOR_SIMP_PASS_ACKERMANN: btor_add_ackermann_constraints (btor); break;
+    default:
+      assert (pass == BTOR_SIMP_PASS_NORMADD);
+      btor_normalize_adds (btor);
+  }
+
+  stats->nodes_after += btor_number_of_ops (btor);
+  stats->substitutions += btor->stats.simplified_exps - simplified;
+  if (btor->inconsistent) stats->inconsistent++;
+  btor->time.simp_passes[pass] += btor_util_time_stamp () - start;
+}
+
+bool
+btor_simplify_parse_pipeline (const char *str, BtorSimpPipeline *pipeline)
+{
+  assert (str);
+  assert (pipeline);
+
+  uint32_t i;
+  size_t len;
+  unsigned long limit;
+  const char *p, *end;
+  char *tmp;
+
+  pipeline->size = 0;
+  for (p = str;; p = end + 1)
+  {
+    for (end = p; *end && *end != ',' && *end != ':'; end++)
+      ;
+    len = end - p;
+
+    /* variable substitution and embedded constraints processing are always
+     * run at the beginning of each round and can not be configured */
+    for (i = BTOR_SIMP_PASS_ELIM_SLICES; i < BTOR_SIMP_PASS_NUM; i++)
+      if (strlen (g_btor_simp_pass_names[i]) == len
+          && !strncmp (p, g_btor_simp_pass_names[i], len))
+        break;
+    if (i == BTOR_SIMP_PASS_NUM) return false;
+    if (pipeline->size == BTOR_SIMP_PIPELINE_MAX) return false;
+
+    limit = 0;
+    if (*end == ':')
+    {
+      if (!isdigit ((unsigned char) end[1])) return false;
+      limit = strtoul (end + 1, &tmp, 10);
+      if (limit > UINT32_MAX) return false;
+      end = tmp;
+    }
+    if (*end && *end != ',') return false;
+
+    pipeline->passes[pipeline->size] = i;
+    pipeline->limits[pipeline->size] = (uint32_t) limit;
+    pipeline->size++;
+    if (!*end) break;
+  }
+  return true;
+}
+
+/* Get the pipeline configured via option simp-pipeline (or the default
+ * pipeline if not set) and return true if it was configured explicitly. */
+static bool
+get_pipeline (Btor *btor, BtorSimpPipeline *pipeline)
+{
+  bool res, found;
+  uint32_t i, j;
+  const char *str;
+  BtorSimpPass mandatory[] = {BTOR_SIMP_PASS_ELIM_APPLIES,
+                              BTOR_SIMP_PASS_ACKERMANN};
+
+  str = btor_opt_get_valstr (btor, BTOR_OPT_SIMP_PIPELINE);
+  res = str != 0;
+  if (!btor_simplify_parse_pipeline (res ? str : BTOR_SIMP_PIPELINE_DFLT,
+                                     pipeline))
+  {
+    /* the pipeline is checked when the option is set */
+    assert (false);
+    btor_simplify_parse_pipeline (BTOR_SIMP_PIPELINE_DFLT, pipeline);
+  }
+
+  for (i = 0; i < sizeof mandatory / sizeof *mandatory; i++)
+  {
+    for (j = 0, found = false; j < pipeline->size && !found; j++)
+      found = pipeline->passes[j] == mandatory[i];
+    if (found) continue;
+    assert (pipeline->size < BTOR_SIMP_PIPELINE_MAX + 2);
+    pipeline->passes[pipeline->size] = mandatory[i];
+    pipeline->limits[pipeline->size] = 0;
+    pipeline->size++;
+  }
+  return res;
+}
+
 int32_t
 btor_simplify (Btor *btor)
 {
   assert (btor);
 
   BtorSolverResult result;
-  uint32_t rounds;
+  BtorSimpPipeline pipeline;
+  BtorSimpPass pass;
+  uint32_t i, rounds, runs[BTOR_SIMP_PIPELINE_MAX + 2];
+  uint32_t skelconstraints;
+  bool explicit, skelfixed, symmetry, skipped;
   double start, delta;
-#ifndef BTOR_DO_NOT_PROCESS_SKELETON
-  uint32_t skelrounds = 0;
-#endif
 
-  rounds = 0;
-  start  = btor_util_time_stamp ();
+  rounds    = 0;
+  skelfixed = true;
+  symmetry  = false;
+  skipped   = false;
+  start     = btor_util_time_stamp ();
 
   if (btor->valid_assignments) btor_reset_incremental_usage (btor);
 
@@ -65,6 +322,18 @@ btor_simplify (Btor *btor)
     //       var_substitutions and var_rhs?
   }
 
+  btor_reinstate_unconstrained (btor);
+
+  if (is_frontier_empty (btor))
+  {
+    btor->stats.simplify_skipped++;
+    skipped = true;
+    goto DONE;
+  }
+
+  explicit = get_pipeline (btor, &pipeline);
+  BTOR_CLR (&runs);
+
   do
   {
     rounds++;
@@ -75,7 +344,7 @@ btor_simplify (Btor *btor)
     {
       if (btor_opt_get (btor, BTOR_OPT_VAR_SUBST))
       {
-        btor_substitute_var_exps (btor);
+        run_pass (btor, BTOR_SIMP_PASS_VAR_SUBST);
 
         if (btor->inconsistent)
         {
@@ -89,7 +358,7 @@ btor_simplify (Btor *btor)
 
       while (btor->embedded_constraints->count)
       {
-        btor_process_embedded_constraints (btor);
+        run_pass (btor, BTOR_SIMP_PASS_EMBEDDED);
 
         if (btor->inconsistent)
         {
@@ -102,101 +371,54 @@ btor_simplify (Btor *btor)
       if (btor->varsubst_constraints->count) continue;
     }
 
-    if (btor_opt_get (btor, BTOR_OPT_ELIMINATE_SLICES)
-        && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL))
+    for (i = 0; i < pipeline.size; i++)
     {
-      btor_eliminate_slices_on_bv_vars (btor);
-      if (btor->inconsistent)
-      {
-        BTORLOG (1, "formula inconsistent after slice elimination");
-        break;
-      }
-
-      if (btor->varsubst_constraints->count
-          || btor->embedded_constraints->count)
+      pass = pipeline.passes[i];
+      if (!is_pass_mandatory (pass) && pipeline.limits[i]
+          && runs[i] >= pipeline.limits[i])
         continue;
-    }
-
-#ifndef BTOR_DO_NOT_PROCESS_SKELETON
-    if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && btor_opt_get (btor, BTOR_OPT_SKELETON_PREPROC))
-    {
-      skelrounds++;
-      if (skelrounds <= 1)  // TODO only one?
-      {
-        btor_process_skeleton (btor);
-        if (btor->inconsistent)
-        {
-          BTORLOG (1, "formula inconsistent after skeleton preprocessing");
-          break;
-        }
-      }
+      if (!is_pass_enabled (btor, pass, explicit)) continue;
 
-      if (btor->varsubst_constraints->count
-          || btor->embedded_constraints->count)
+      /* Skeleton preprocessing is repeated as long as it produces new fixed
+       * literals, which may enable further simplifications. Symmetry
+       * breaking constraints are only added once since the added
+       * constraints break the detected symmetries. */
+      if ((pass == BTOR_SIMP_PASS_SKELETON && !skelfixed)
+          || (pass == BTOR_SIMP_PASS_SYMMETRY && symmetry))
         continue;
-    }
-#endif
 
-    if (btor->varsubst_constraints->count || btor->embedded_constraints->count)
-      continue;
+      runs[i]++;
+      skelconstraints = btor->stats.skeleton_constraints;
+      run_pass (btor, pass);
+      if (pass == BTOR_SIMP_PASS_SKELETON)
+        skelfixed = btor->stats.skeleton_constraints > skelconstraints;
+      else if (pass == BTOR_SIMP_PASS_SYMMETRY)
+        symmetry = true;
 
-    if (btor_opt_get (btor, BTOR_OPT_UCOPT)
-        && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
-        && !btor_opt_get (btor, BTOR_OPT_MODEL_GEN))
-    {
-      btor_optimize_unconstrained (btor);
       if (btor->inconsistent)
       {
-        BTORLOG (1, "formula inconsistent after skeleton preprocessing");
+        BTORLOG (1,
+                 "formula inconsistent after preprocessing pass '%s'",
+                 g_btor_simp_pass_names[pass]);
         break;
       }
-    }
-
-    if (btor->varsubst_constraints->count || btor->embedded_constraints->count)
-      continue;
 
-    if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && btor_opt_get (btor, BTOR_OPT_EXTRACT_LAMBDAS))
-      btor_extract_lambdas (btor);
-
-    if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && btor_opt_get (btor, BTOR_OPT_MERGE_LAMBDAS))
-      btor_merge_lambdas (btor);
-
-    if (btor->varsubst_constraints->count || btor->embedded_constraints->count)
-      continue;
-
-    /* rewrite/beta-reduce applies on lambdas */
-    if (btor_opt_get (btor, BTOR_OPT_BETA_REDUCE))
-    {
-      /* If no UFs or function equalities are present, we eagerly eliminate all
-       * remaining lambdas. */
-      if (btor->ufs->count == 0 && btor->feqs->count == 0
-          && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL))
-      {
-        BTOR_MSG (btor->msg,
-                  1,
-                  "no UFs or function equalities, enable beta-reduction=all");
-        btor_opt_set (btor, BTOR_OPT_BETA_REDUCE, BTOR_BETA_REDUCE_ALL);
-      }
-      btor_eliminate_applies (btor);
+      /* start a new round */
+      if (btor->varsubst_constraints->count
+          || btor->embedded_constraints->count)
+        break;
     }
 
-    /* add ackermann constraints for all uninterpreted functions */
-    if (btor_opt_get (btor, BTOR_OPT_ACKERMANN))
-      btor_add_ackermann_constraints (btor);
-
-    if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && btor_opt_get (btor, BTOR_OPT_SIMP_NORMAMLIZE_ADDERS))
-      btor_normalize_adds (btor);
-
+    if (btor->inconsistent) break;
   } while (btor->varsubst_constraints->count
            || btor->embedded_constraints->count);
 
 DONE:
+  /* Nodes created since the last call that were not considered by a skipped
+   * call (e.g., update nodes introduced via assumptions) must be processed
+   * by the next call, hence the frontier is only advanced if the
+   * preprocessing passes were run. */
+  if (!skipped) btor->simp_frontier = BTOR_COUNT_STACK (btor->nodes_id_table);
   delta = btor_util_time_stamp () - start;
   btor->time.simplify += delta;
   BTOR_MSG (btor->msg, 1, "%u rewriting rounds in %.1f seconds", rounds, delta);
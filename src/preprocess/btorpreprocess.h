@@ -9,10 +9,47 @@
 #ifndef BTORPREPROCESS_H_INCLUDED
 #define BTORPREPROCESS_H_INCLUDED
 
+#include <stdbool.h>
 #include <stdint.h>
 
+#include "btorcore.h"
 #include "btortypes.h"
 
+/* maximum number of passes in a preprocessing pipeline */
+#define BTOR_SIMP_PIPELINE_MAX 64
+
+struct BtorSimpPipeline
+{
+  uint32_t size;
+  /* two additional slots for the passes that can not be omitted */
+  BtorSimpPass passes[BTOR_SIMP_PIPELINE_MAX + 2];
+  uint32_t limits[BTOR_SIMP_PIPELINE_MAX + 2]; /* max. runs, 0: unlimited */
+};
+
+typedef struct BtorSimpPipeline BtorSimpPipeline;
+
+/* The names of the preprocessing passes as used in option simp-pipeline. */
+extern const char* const g_btor_simp_pass_names[BTOR_SIMP_PASS_NUM];
+
 int32_t btor_simplify (Btor* btor);
 
+/**
+ * Parse a preprocessing pipeline of the form <pass>[:<limit>](,<pass>[:<limit>])*
+ * into 'pipeline', where <limit> is the maximum number of runs of the pass
+ * per call to btor_simplify (0 or no limit: unlimited). Passes are run in
+ * the given order after variable substitution and embedded constraints
+ * processing. Passes elimapplies and ackermann are appended if missing.
+ * Returns false if 'str' is not a valid pipeline.
+ */
+bool btor_simplify_parse_pipeline (const char* str,
+                                   BtorSimpPipeline* pipeline);
+
+/**
+ * Get the id of the first node that has been created since the last call to
+ * btor_simplify. Preprocessing passes may restrict themselves to nodes with
+ * greater or equal id. Returns 0 if all nodes have to be considered (i.e., if
+ * incremental preprocessing is disabled).
+ */
+uint32_t btor_simplify_get_frontier (Btor* btor);
+
 #endif
@@ -6,16 +6,238 @@
  *  See COPYING for more information on using this software.
  */
 
-#ifdef BTOR_USE_LINGELING
 #include "preprocess/btorskel.h"
 
 #include "btorcore.h"
 #include "btordbg.h"
 #include "btorlog.h"
-#include "lglib.h"
+#include "preprocess/btorpreprocess.h"
 #include "utils/btorhashint.h"
 #include "utils/btorutil.h"
 
+/* maximum number of clause visits during failed literal probing */
+#define BTOR_SKEL_PROBE_LIMIT 1000000
+
+/*------------------------------------------------------------------------*/
+
+/* Small unit propagation engine used to determine the fixed literals of the
+ * propositional skeleton independently of the configured SAT solver. Top-level
+ * units are derived by propagating the unit clauses and by failed literal
+ * probing. */
+struct BtorSkelSolver
+{
+  BtorMemMgr *mm;
+  int32_t maxvar;
+  BtorIntStack lits;     /* literals of all clauses, each terminated by 0 */
+  BtorUIntStack clauses; /* start positions of clauses in 'lits' */
+  uint32_t *occs;        /* clauses by literal, see 'occs_start' */
+  uint32_t *occs_start;  /* occurrences of literal l start at index 2|l|+(l<0) */
+  int8_t *vals;          /* assignment by variable */
+  BtorIntStack trail;
+  uint32_t next; /* next literal on trail to propagate */
+  uint32_t open; /* start position of clause that is currently added */
+  bool inconsistent;
+};
+
+typedef struct BtorSkelSolver BtorSkelSolver;
+
+static uint32_t
+skel_lit2idx (int32_t lit)
+{
+  return 2 * (uint32_t) abs (lit) + (lit < 0);
+}
+
+static int32_t
+skel_val (BtorSkelSolver *s, int32_t lit)
+{
+  int32_t res;
+
+  if (!s->vals || abs (lit) > s->maxvar) return 0;
+  res = s->vals[abs (lit)];
+  return lit < 0 ? -res : res;
+}
+
+static BtorSkelSolver *
+skel_new (BtorMemMgr *mm)
+{
+  BtorSkelSolver *res;
+
+  BTOR_CNEW (mm, res);
+  res->mm = mm;
+  BTOR_INIT_STACK (mm, res->lits);
+  BTOR_INIT_STACK (mm, res->clauses);
+  BTOR_INIT_STACK (mm, res->trail);
+  return res;
+}
+
+static void
+skel_delete (BtorSkelSolver *s)
+{
+  BtorMemMgr *mm = s->mm;
+  uint32_t n     = 2 * (uint32_t) s->maxvar + 2;
+
+  if (s->vals)
+  {
+    BTOR_DELETEN (mm, s->occs, BTOR_COUNT_STACK (s->lits));
+    BTOR_DELETEN (mm, s->occs_start, n + 1);
+    BTOR_DELETEN (mm, s->vals, s->maxvar + 1);
+  }
+  BTOR_RELEASE_STACK (s->lits);
+  BTOR_RELEASE_STACK (s->clauses);
+  BTOR_RELEASE_STACK (s->trail);
+  BTOR_DELETE (mm, s);
+}
+
+/* Add literal 'lit' to the current clause, 0 terminates the clause. */
+static void
+skel_add (BtorSkelSolver *s, int32_t lit)
+{
+  assert (!s->vals);
+  if (BTOR_COUNT_STACK (s->lits) == s->open)
+    BTOR_PUSH_STACK (s->clauses, s->open);
+  BTOR_PUSH_STACK (s->lits, lit);
+  if (lit)
+  {
+    if (abs (lit) > s->maxvar) s->maxvar = abs (lit);
+  }
+  else
+    s->open = BTOR_COUNT_STACK (s->lits);
+}
+
+/* Build occurrence lists, no more clauses can be added afterwards. */
+static void
+skel_init_occs (BtorSkelSolver *s)
+{
+  assert (!s->vals);
+  assert (s->open == BTOR_COUNT_STACK (s->lits));
+
+  uint32_t i, j, c, n, *pos;
+  int32_t lit;
+
+  n = 2 * (uint32_t) s->maxvar + 2;
+  BTOR_CNEWN (s->mm, s->vals, s->maxvar + 1);
+  BTOR_CNEWN (s->mm, s->occs_start, n + 1);
+  BTOR_NEWN (s->mm, s->occs, BTOR_COUNT_STACK (s->lits));
+
+  for (i = 0; i < BTOR_COUNT_STACK (s->lits); i++)
+    if ((lit = BTOR_PEEK_STACK (s->lits, i)))
+      s->occs_start[skel_lit2idx (lit) + 1]++;
+  for (i = 0; i < n; i++) s->occs_start[i + 1] += s->occs_start[i];
+
+  BTOR_CNEWN (s->mm, pos, n);
+  for (c = 0; c < BTOR_COUNT_STACK (s->clauses); c++)
+    for (j = BTOR_PEEK_STACK (s->clauses, c);
+         (lit = BTOR_PEEK_STACK (s->lits, j));
+         j++)
+    {
+      i = skel_lit2idx (lit);
+      s->occs[s->occs_start[i] + pos[i]++] = c;
+    }
+  BTOR_DELETEN (s->mm, pos, n);
+}
+
+static void
+skel_assign (BtorSkelSolver *s, int32_t lit)
+{
+  assert (!skel_val (s, lit));
+  s->vals[abs (lit)] = lit < 0 ? -1 : 1;
+  BTOR_PUSH_STACK (s->trail, lit);
+}
+
+static void
+skel_backtrack (BtorSkelSolver *s, uint32_t level)
+{
+  while (BTOR_COUNT_STACK (s->trail) > level)
+    s->vals[abs (BTOR_POP_STACK (s->trail))] = 0;
+  s->next = level;
+}
+
+/* Propagate all literals on the trail, returns false on conflict. */
+static bool
+skel_propagate (BtorSkelSolver *s, uint32_t *visits)
+{
+  uint32_t i, j, idx;
+  int32_t lit, unit, val;
+  bool sat;
+
+  while (s->next < BTOR_COUNT_STACK (s->trail))
+  {
+    idx = skel_lit2idx (-BTOR_PEEK_STACK (s->trail, s->next));
+    s->next += 1;
+    for (i = s->occs_start[idx]; i < s->occs_start[idx + 1]; i++)
+    {
+      if (visits) *visits += 1;
+      unit = 0;
+      sat  = false;
+      for (j = BTOR_PEEK_STACK (s->clauses, s->occs[i]);
+           (lit = BTOR_PEEK_STACK (s->lits, j));
+           j++)
+      {
+        val = skel_val (s, lit);
+        if (val > 0)
+        {
+          sat = true;
+          break;
+        }
+        if (val == 0)
+        {
+          if (unit) break;
+          unit = lit;
+        }
+      }
+      if (sat || lit) continue; /* satisfied or at least two open literals */
+      if (!unit) return false;
+      skel_assign (s, unit);
+    }
+  }
+  return true;
+}
+
+/* Determine the top-level fixed literals, returns false if the clauses are
+ * unsatisfiable. */
+static bool
+skel_simplify (BtorSkelSolver *s)
+{
+  uint32_t c, level, visits;
+  int32_t v, lit, first;
+
+  if (BTOR_EMPTY_STACK (s->clauses)) return true;
+
+  skel_init_occs (s);
+
+  for (c = 0; c < BTOR_COUNT_STACK (s->clauses); c++)
+  {
+    first = BTOR_PEEK_STACK (s->lits, BTOR_PEEK_STACK (s->clauses, c));
+    if (!first || BTOR_PEEK_STACK (s->lits, BTOR_PEEK_STACK (s->clauses, c) + 1))
+      continue;
+    if (skel_val (s, first) < 0) return false;
+    if (!skel_val (s, first)) skel_assign (s, first);
+  }
+  if (!skel_propagate (s, 0)) return false;
+
+  /* failed literal probing */
+  visits = 0;
+  for (v = 1; v <= s->maxvar && visits < BTOR_SKEL_PROBE_LIMIT; v++)
+  {
+    for (lit = v; !skel_val (s, v) && lit >= -v; lit -= 2 * v)
+    {
+      level = BTOR_COUNT_STACK (s->trail);
+      skel_assign (s, lit);
+      if (skel_propagate (s, &visits))
+      {
+        skel_backtrack (s, level);
+        continue;
+      }
+      skel_backtrack (s, level);
+      skel_assign (s, -lit);
+      if (!skel_propagate (s, 0)) return false;
+    }
+  }
+  return true;
+}
+
+/*------------------------------------------------------------------------*/
+
 static int32_t
 fixed_exp (Btor *btor, BtorNode *exp)
 {
@@ -72,7 +294,7 @@ process_skeleton_tseitin_lit (BtorPtrHashTable *ids, BtorNode *exp)
 
 static void
 process_skeleton_tseitin (Btor *btor,
-                          LGL *lgl,
+                          BtorSkelSolver *solver,
                           BtorNodePtrStack *work_stack,
                           BtorIntHashTable *mark,
                           BtorPtrHashTable *ids,
@@ -125,8 +347,8 @@ process_skeleton_tseitin (Btor *btor,
       fixed = fixed_exp (btor, exp);
       if (fixed)
       {
-        lgladd (lgl, (fixed > 0) ? lhs : -lhs);
-        lgladd (lgl, 0);
+        skel_add (solver, (fixed > 0) ? lhs : -lhs);
+        skel_add (solver, 0);
       }
 
       switch (exp->kind)
@@ -135,18 +357,18 @@ process_skeleton_tseitin (Btor *btor,
           rhs[0] = process_skeleton_tseitin_lit (ids, exp->e[0]);
           rhs[1] = process_skeleton_tseitin_lit (ids, exp->e[1]);
 
-          lgladd (lgl, -lhs);
-          lgladd (lgl, rhs[0]);
-          lgladd (lgl, 0);
+          skel_add (solver, -lhs);
+          skel_add (solver, rhs[0]);
+          skel_add (solver, 0);
 
-          lgladd (lgl, -lhs);
-          lgladd (lgl, rhs[1]);
-          lgladd (lgl, 0);
+          skel_add (solver, -lhs);
+          skel_add (solver, rhs[1]);
+          skel_add (solver, 0);
 
-          lgladd (lgl, lhs);
-          lgladd (lgl, -rhs[0]);
-          lgladd (lgl, -rhs[1]);
-          lgladd (lgl, 0);
+          skel_add (solver, lhs);
+          skel_add (solver, -rhs[0]);
+          skel_add (solver, -rhs[1]);
+          skel_add (solver, 0);
           break;
 
         case BTOR_BV_EQ_NODE:
@@ -155,25 +377,25 @@ process_skeleton_tseitin (Btor *btor,
           rhs[0] = process_skeleton_tseitin_lit (ids, exp->e[0]);
           rhs[1] = process_skeleton_tseitin_lit (ids, exp->e[1]);
 
-          lgladd (lgl, -lhs);
-          lgladd (lgl, -rhs[0]);
-          lgladd (lgl, rhs[1]);
-          lgladd (lgl, 0);
+          skel_add (solver, -lhs);
+          skel_add (solver, -rhs[0]);
+          skel_add (solver, rhs[1]);
+          skel_add (solver, 0);
 
-          lgladd (lgl, -lhs);
-          lgladd (lgl, rhs[0]);
-          lgladd (lgl, -rhs[1]);
-          lgladd (lgl, 0);
+          skel_add (solver, -lhs);
+          skel_add (solver, rhs[0]);
+          skel_add (solver, -rhs[1]);
+          skel_add (solver, 0);
 
-          lgladd (lgl, lhs);
-          lgladd (lgl, rhs[0]);
-          lgladd (lgl, rhs[1]);
-          lgladd (lgl, 0);
+          skel_add (solver, lhs);
+          skel_add (solver, rhs[0]);
+          skel_add (solver, rhs[1]);
+          skel_add (solver, 0);
 
-          lgladd (lgl, lhs);
-          lgladd (lgl, -rhs[0]);
-          lgladd (lgl, -rhs[1]);
-          lgladd (lgl, 0);
+          skel_add (solver, lhs);
+          skel_add (solver, -rhs[0]);
+          skel_add (solver, -rhs[1]);
+          skel_add (solver, 0);
 
           break;
 
@@ -190,25 +412,25 @@ process_skeleton_tseitin (Btor *btor,
 	      rhs[1] = process_skeleton_tseitin_lit (ids, exp->e[1]);
 	      rhs[2] = process_skeleton_tseitin_lit (ids, exp->e[2]);
 
-	      lgladd (lgl, -lhs);
-	      lgladd (lgl, -rhs[0]);
-	      lgladd (lgl, rhs[1]);
-	      lgladd (lgl, 0);
-
-	      lgladd (lgl, -lhs);
-	      lgladd (lgl, rhs[0]);
-	      lgladd (lgl, rhs[2]);
-	      lgladd (lgl, 0);
-
-	      lgladd (lgl, lhs);
-	      lgladd (lgl, -rhs[0]);
-	      lgladd (lgl, -rhs[1]);
-	      lgladd (lgl, 0);
-
-	      lgladd (lgl, lhs);
-	      lgladd (lgl, rhs[0]);
-	      lgladd (lgl, -rhs[2]);
-	      lgladd (lgl, 0);
+	      skel_add (solver, -lhs);
+	      skel_add (solver, -rhs[0]);
+	      skel_add (solver, rhs[1]);
+	      skel_add (solver, 0);
+
+	      skel_add (solver, -lhs);
+	      skel_add (solver, rhs[0]);
+	      skel_add (solver, rhs[2]);
+	      skel_add (solver, 0);
+
+	      skel_add (solver, lhs);
+	      skel_add (solver, -rhs[0]);
+	      skel_add (solver, -rhs[1]);
+	      skel_add (solver, 0);
+
+	      skel_add (solver, lhs);
+	      skel_add (solver, rhs[0]);
+	      skel_add (solver, -rhs[2]);
+	      skel_add (solver, 0);
 	      break;
 #endif
 
@@ -230,10 +452,11 @@ btor_process_skeleton (Btor *btor)
   BtorMemMgr *mm = btor->mm;
   BtorPtrHashTableIterator it;
   double start, delta;
-  int32_t res, lit, val;
+  int32_t lit, val;
   size_t i;
+  bool res;
   BtorNode *exp;
-  LGL *lgl;
+  BtorSkelSolver *solver;
   BtorIntHashTable *mark;
 
   start = btor_util_time_stamp ();
@@ -242,34 +465,31 @@ btor_process_skeleton (Btor *btor)
                                 (BtorHashPtr) btor_node_hash_by_id,
                                 (BtorCmpPtr) btor_node_compare_by_id);
 
-  lgl = lglinit ();
-  lglsetprefix (lgl, "[lglskel] ");
-
-  if (btor_opt_get (btor, BTOR_OPT_VERBOSITY) >= 2)
-  {
-    lglsetopt (lgl, "verbose", btor_opt_get (btor, BTOR_OPT_VERBOSITY) - 1);
-    lglbnr ("Lingeling", "[lglskel] ", stdout);
-    fflush (stdout);
-  }
-  else
-    lglsetopt (lgl, "verbose", -1);
-
-  count = 0;
+  solver = skel_new (mm);
+  count  = 0;
 
   BTOR_INIT_STACK (mm, work_stack);
   BTOR_INIT_STACK (mm, new_assertions);
   mark = btor_hashint_map_new (mm);
 
-  btor_iter_hashptr_init (&it, btor->synthesized_constraints);
-  btor_iter_hashptr_queue (&it, btor->unsynthesized_constraints);
+  /* With incremental preprocessing, only new constraints are considered.
+   * The skeleton literals fixed by a subset of the constraints are implied
+   * by the whole formula. */
+  if (btor_simplify_get_frontier (btor))
+    btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  else
+  {
+    btor_iter_hashptr_init (&it, btor->synthesized_constraints);
+    btor_iter_hashptr_queue (&it, btor->unsynthesized_constraints);
+  }
   while (btor_iter_hashptr_has_next (&it))
   {
     count++;
     exp = btor_iter_hashptr_next (&it);
     assert (btor_node_bv_get_width (btor, exp) == 1);
-    process_skeleton_tseitin (btor, lgl, &work_stack, mark, ids, exp);
-    lgladd (lgl, process_skeleton_tseitin_lit (ids, exp));
-    lgladd (lgl, 0);
+    process_skeleton_tseitin (btor, solver, &work_stack, mark, ids, exp);
+    skel_add (solver, process_skeleton_tseitin_lit (ids, exp));
+    skel_add (solver, 0);
   }
 
   BTOR_RELEASE_STACK (work_stack);
@@ -281,31 +501,23 @@ btor_process_skeleton (Btor *btor)
             ids->count,
             count);
 
-  res = lglsimp (lgl, 0);
-
-  if (btor_opt_get (btor, BTOR_OPT_VERBOSITY))
-  {
-    BTOR_MSG (btor->msg, 1, "skeleton preprocessing result %d", res);
-    lglstats (lgl);
-  }
-
+  res   = skel_simplify (solver);
   fixed = 0;
 
-  if (res == 20)
+  if (!res)
   {
     BTOR_MSG (btor->msg, 1, "skeleton inconsistent");
     btor->inconsistent = true;
   }
   else
   {
-    assert (res == 0 || res == 10);
     btor_iter_hashptr_init (&it, ids);
     while (btor_iter_hashptr_has_next (&it))
     {
       exp = btor_iter_hashptr_next (&it);
       assert (!btor_node_is_inverted (exp));
       lit = process_skeleton_tseitin_lit (ids, exp);
-      val = lglfixed (lgl, lit);
+      val = skel_val (solver, lit);
       if (val)
       {
         if (val < 0) exp = btor_node_invert (exp);
@@ -329,7 +541,7 @@ btor_process_skeleton (Btor *btor)
   }
 
   btor_hashptr_table_delete (ids);
-  lglrelease (lgl);
+  skel_delete (solver);
 
   for (i = 0; i < BTOR_COUNT_STACK (new_assertions); i++)
   {
@@ -350,4 +562,3 @@ btor_process_skeleton (Btor *btor)
   assert (btor_dbg_check_all_hash_tables_simp_free (btor));
   assert (btor_dbg_check_unique_table_children_proxy_free (btor));
 }
-#endif
@@ -9,10 +9,10 @@
 #ifndef BTORSKEL_H_INCLUDED
 #define BTORSKEL_H_INCLUDED
 
-#ifdef BTOR_USE_LINGELING
-
 #include "btortypes.h"
+
+/* Determine the fixed literals of the propositional skeleton of the
+ * constraints and add them as new constraints. */
 void btor_process_skeleton (Btor* btor);
 
 #endif
-#endif
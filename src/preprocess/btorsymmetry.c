@@ -0,0 +1,395 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btorsymmetry.h"
+
+#include "btorbv.h"
+#include "btorcore.h"
+#include "btordbg.h"
+#include "btorexp.h"
+#include "btorlog.h"
+#include "btormsg.h"
+#include "utils/btorhashint.h"
+#include "utils/btorhashptr.h"
+#include "utils/btorstack.h"
+#include "utils/btorutil.h"
+
+/* number of color refinement rounds */
+#define BTOR_SYMMETRY_REFINE_ROUNDS 3
+
+/* maximum number of candidate transpositions that are checked */
+#define BTOR_SYMMETRY_MAX_CHECKS 1000
+
+struct BtorSymVar
+{
+  uint32_t color;
+  BtorNode *var;
+};
+
+typedef struct BtorSymVar BtorSymVar;
+
+static uint32_t
+hash_combine (uint32_t h, uint32_t v)
+{
+  return h ^ (v + 0x9e3779b9u + (h << 6) + (h >> 2));
+}
+
+static void
+init_constraints_iterator (Btor *btor, BtorPtrHashTableIterator *it)
+{
+  btor_iter_hashptr_init (it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (it, btor->embedded_constraints);
+}
+
+static bool
+is_constraint (Btor *btor, BtorNode *exp)
+{
+  return btor_hashptr_table_get (btor->unsynthesized_constraints, exp)
+         || btor_hashptr_table_get (btor->synthesized_constraints, exp)
+         || btor_hashptr_table_get (btor->embedded_constraints, exp);
+}
+
+/* Collect all nodes and bit-vector variables in the cone of the constraints.
+ * Returns false if the cone contains functions, parameters or quantifiers,
+ * which are not supported. */
+static bool
+collect_cone (Btor *btor, BtorNodePtrStack *nodes, BtorNodePtrStack *vars)
+{
+  bool res;
+  uint32_t i;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorIntHashTable *mark;
+  BtorPtrHashTableIterator it;
+  BtorMemMgr *mm;
+
+  mm   = btor->mm;
+  res  = true;
+  mark = btor_hashint_table_new (mm);
+  BTOR_INIT_STACK (mm, visit);
+
+  init_constraints_iterator (btor, &it);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (visit,
+                     btor_node_real_addr (btor_iter_hashptr_next (&it)));
+
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = BTOR_POP_STACK (visit);
+    if (btor_hashint_table_contains (mark, cur->id)) continue;
+    btor_hashint_table_add (mark, cur->id);
+
+    if (btor_node_is_fun (cur) || btor_node_is_args (cur)
+        || btor_node_is_apply (cur) || btor_node_is_param (cur)
+        || btor_node_is_quantifier (cur))
+    {
+      res = false;
+      break;
+    }
+
+    BTOR_PUSH_STACK (*nodes, cur);
+    if (btor_node_is_bv_var (cur)) BTOR_PUSH_STACK (*vars, cur);
+    for (i = 0; i < cur->arity; i++)
+      BTOR_PUSH_STACK (visit, btor_node_real_addr (cur->e[i]));
+  }
+
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_table_delete (mark);
+  return res;
+}
+
+static uint32_t
+get_color (BtorIntHashTable *colors, BtorNode *exp)
+{
+  return (uint32_t) btor_hashint_map_get (colors, btor_node_real_addr (exp)->id)
+      ->as_int;
+}
+
+/* Color refinement on the DAG of the constraints. Variables are colored by
+ * their sort only, all other nodes by their kind, sort and (for constants and
+ * slices) their payload. In each round, the color of a node is refined by
+ * the colors of its children and the multiset of colors of its parents.
+ * Variables with different colors are never symmetric. */
+static BtorIntHashTable *
+compute_colors (Btor *btor, BtorNodePtrStack *nodes)
+{
+  uint32_t i, j, r, h, c, down, pos;
+  BtorNode *cur, *child;
+  BtorIntHashTable *colors, *up, *tmp;
+  BtorHashTableData *d;
+  BtorMemMgr *mm;
+
+  mm     = btor->mm;
+  colors = btor_hashint_map_new (mm);
+
+  for (i = 0; i < BTOR_COUNT_STACK (*nodes); i++)
+  {
+    cur = BTOR_PEEK_STACK (*nodes, i);
+    h   = hash_combine (cur->kind, cur->sort_id);
+    if (btor_node_is_bv_const (cur))
+      h = hash_combine (h, btor_bv_hash (btor_node_bv_const_get_bits (cur)));
+    else if (btor_node_is_bv_slice (cur))
+    {
+      h = hash_combine (h, btor_node_bv_slice_get_upper (cur));
+      h = hash_combine (h, btor_node_bv_slice_get_lower (cur));
+    }
+    btor_hashint_map_add (colors, cur->id)->as_int = (int32_t) h;
+  }
+
+  for (r = 0; r < BTOR_SYMMETRY_REFINE_ROUNDS; r++)
+  {
+    /* multiset of parent colors, combined by summation */
+    up = btor_hashint_map_new (mm);
+    for (i = 0; i < BTOR_COUNT_STACK (*nodes); i++)
+    {
+      cur = BTOR_PEEK_STACK (*nodes, i);
+      for (j = 0; j < cur->arity; j++)
+      {
+        child = cur->e[j];
+        pos   = btor_node_is_binary_commutative (cur) ? 0 : j + 1;
+        h     = hash_combine (get_color (colors, cur), pos);
+        h     = hash_combine (h, btor_node_is_inverted (child));
+        d     = btor_hashint_map_get (up, btor_node_real_addr (child)->id);
+        if (!d) d = btor_hashint_map_add (up, btor_node_real_addr (child)->id);
+        d->as_int = (int32_t) ((uint32_t) d->as_int + h);
+      }
+    }
+
+    tmp = btor_hashint_map_new (mm);
+    for (i = 0; i < BTOR_COUNT_STACK (*nodes); i++)
+    {
+      cur  = BTOR_PEEK_STACK (*nodes, i);
+      down = 0;
+      for (j = 0; j < cur->arity; j++)
+      {
+        child = cur->e[j];
+        c     = hash_combine (get_color (colors, child),
+                          btor_node_is_inverted (child));
+        /* the order of the operands of commutative nodes is irrelevant */
+        if (btor_node_is_binary_commutative (cur))
+          down += c;
+        else
+          down = hash_combine (down, c);
+      }
+      h = hash_combine (get_color (colors, cur), down);
+      d = btor_hashint_map_get (up, cur->id);
+      if (d) h = hash_combine (h, (uint32_t) d->as_int);
+      btor_hashint_map_add (tmp, cur->id)->as_int = (int32_t) h;
+    }
+
+    btor_hashint_map_delete (up);
+    btor_hashint_map_delete (colors);
+    colors = tmp;
+  }
+
+  return colors;
+}
+
+/* Rebuild 'root' with variables mapped according to 'cache'. Nodes that do
+ * not depend on the mapped variables are not rebuilt. */
+static BtorNode *
+swap_vars (Btor *btor, BtorNode *root, BtorIntHashTable *cache)
+{
+  bool changed;
+  uint32_t i;
+  BtorNode *cur, *result, *e[3];
+  BtorNodePtrStack visit;
+  BtorHashTableData *d;
+
+  BTOR_INIT_STACK (btor->mm, visit);
+  BTOR_PUSH_STACK (visit, btor_node_real_addr (root));
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = BTOR_POP_STACK (visit);
+    d   = btor_hashint_map_get (cache, cur->id);
+    if (!d)
+    {
+      btor_hashint_map_add (cache, cur->id);
+      BTOR_PUSH_STACK (visit, cur);
+      for (i = 0; i < cur->arity; i++)
+        BTOR_PUSH_STACK (visit, btor_node_real_addr (cur->e[i]));
+    }
+    else if (!d->as_ptr)
+    {
+      changed = false;
+      for (i = 0; i < cur->arity; i++)
+      {
+        e[i] = btor_node_cond_invert (
+            cur->e[i],
+            btor_hashint_map_get (cache, btor_node_real_addr (cur->e[i])->id)
+                ->as_ptr);
+        if (e[i] != cur->e[i]) changed = true;
+      }
+
+      if (!changed)
+        result = btor_node_copy (btor, cur);
+      else if (btor_node_is_bv_slice (cur))
+        result = btor_exp_bv_slice (btor,
+                                    e[0],
+                                    btor_node_bv_slice_get_upper (cur),
+                                    btor_node_bv_slice_get_lower (cur));
+      else
+        result = btor_exp_create (btor, cur->kind, e, cur->arity);
+      d->as_ptr = result;
+    }
+  }
+  BTOR_RELEASE_STACK (visit);
+
+  d = btor_hashint_map_get (cache, btor_node_real_addr (root)->id);
+  return btor_node_copy (btor, btor_node_cond_invert (root, d->as_ptr));
+}
+
+/* Check if swapping 'x' and 'y' maps the set of constraints into itself.
+ * Since swapping is an involution, the formula is then invariant under the
+ * transposition (x y). */
+static bool
+is_symmetric (Btor *btor, BtorNode *x, BtorNode *y)
+{
+  bool res;
+  BtorNode *cur, *swapped;
+  BtorIntHashTable *cache;
+  BtorIntHashTableIterator iit;
+  BtorPtrHashTableIterator it;
+
+  res   = true;
+  cache = btor_hashint_map_new (btor->mm);
+  btor_hashint_map_add (cache, x->id)->as_ptr = btor_node_copy (btor, y);
+  btor_hashint_map_add (cache, y->id)->as_ptr = btor_node_copy (btor, x);
+
+  init_constraints_iterator (btor, &it);
+  while (res && btor_iter_hashptr_has_next (&it))
+  {
+    cur     = btor_iter_hashptr_next (&it);
+    swapped = swap_vars (btor, cur, cache);
+    res     = is_constraint (btor, swapped);
+    btor_node_release (btor, swapped);
+  }
+
+  btor_iter_hashint_init (&iit, cache);
+  while (btor_iter_hashint_has_next (&iit))
+    btor_node_release (btor, btor_iter_hashint_next_data (&iit)->as_ptr);
+  btor_hashint_map_delete (cache);
+  return res;
+}
+
+static int32_t
+compare_sym_vars (const void *p1, const void *p2)
+{
+  const BtorSymVar *a = p1;
+  const BtorSymVar *b = p2;
+  if (a->color != b->color) return a->color < b->color ? -1 : 1;
+  return a->var->id < b->var->id ? -1 : a->var->id > b->var->id;
+}
+
+void
+btor_break_symmetries (Btor *btor)
+{
+  assert (btor);
+  assert (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL));
+  assert (btor_dbg_check_all_hash_tables_proxy_free (btor));
+
+  bool chained;
+  uint32_t i, n, checks, num_classes, num_constraints;
+  double start, delta;
+  BtorNode *x, *y, *lte;
+  BtorNodePtrStack nodes, vars, pairs;
+  BtorIntHashTable *colors;
+  BtorSymVar *sym;
+  BtorMemMgr *mm;
+
+  start           = btor_util_time_stamp ();
+  mm              = btor->mm;
+  num_classes     = 0;
+  num_constraints = 0;
+  BTOR_INIT_STACK (mm, nodes);
+  BTOR_INIT_STACK (mm, vars);
+  BTOR_INIT_STACK (mm, pairs);
+
+  BTORLOG (1, "start symmetry breaking");
+
+  if (!collect_cone (btor, &nodes, &vars) || BTOR_COUNT_STACK (vars) < 2)
+    goto DONE;
+
+  colors = compute_colors (btor, &nodes);
+  n      = BTOR_COUNT_STACK (vars);
+  BTOR_NEWN (mm, sym, n);
+  for (i = 0; i < n; i++)
+  {
+    sym[i].var   = BTOR_PEEK_STACK (vars, i);
+    sym[i].color = get_color (colors, sym[i].var);
+  }
+  btor_hashint_map_delete (colors);
+  qsort (sym, n, sizeof (BtorSymVar), compare_sym_vars);
+
+  /* Variables x_1 < ... < x_k of the same color such that all adjacent
+   * transpositions (x_i x_i+1) are symmetries generate the full symmetric
+   * group on {x_1, ..., x_k}. The lex-leader constraints for this group are
+   * x_1 <= ... <= x_k. Chains of different classes are disjoint, hence the
+   * constraints of all chains can be combined. */
+  chained = false;
+  checks  = 0;
+  for (i = 0; i + 1 < n && checks < BTOR_SYMMETRY_MAX_CHECKS; i++)
+  {
+    x = sym[i].var;
+    y = sym[i + 1].var;
+    if (sym[i].color != sym[i + 1].color)
+    {
+      chained = false;
+      continue;
+    }
+
+    checks++;
+    if (!is_symmetric (btor, x, y))
+    {
+      chained = false;
+      continue;
+    }
+
+    BTORLOG (2,
+             "symmetry: %s <-> %s",
+             btor_util_node2string (x),
+             btor_util_node2string (y));
+    if (!chained) num_classes++;
+    chained = true;
+    BTOR_PUSH_STACK (pairs, x);
+    BTOR_PUSH_STACK (pairs, y);
+  }
+  BTOR_DELETEN (mm, sym, n);
+
+  /* symmetry breaking constraints are added after all checks since the
+   * checks are performed against the original set of constraints */
+  for (i = 0; i < BTOR_COUNT_STACK (pairs); i += 2)
+  {
+    lte = btor_exp_bv_ulte (
+        btor, BTOR_PEEK_STACK (pairs, i), BTOR_PEEK_STACK (pairs, i + 1));
+    btor_assert_exp (btor, lte);
+    btor_node_release (btor, lte);
+    num_constraints++;
+  }
+
+DONE:
+  BTOR_RELEASE_STACK (pairs);
+  BTOR_RELEASE_STACK (vars);
+  BTOR_RELEASE_STACK (nodes);
+
+  btor->stats.symmetry_classes += num_classes;
+  btor->stats.symmetry_constraints += num_constraints;
+
+  BTORLOG (1, "end symmetry breaking");
+
+  delta = btor_util_time_stamp () - start;
+  btor->time.symmetry += delta;
+  BTOR_MSG (btor->msg,
+            1,
+            "added %u symmetry breaking constraints for %u classes in %.3f "
+            "seconds",
+            num_constraints,
+            num_classes,
+            delta);
+}
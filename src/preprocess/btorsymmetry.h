@@ -0,0 +1,18 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORSYMMETRY_H_INCLUDED
+#define BTORSYMMETRY_H_INCLUDED
+
+#include "btortypes.h"
+
+/* Detect variables that can be permuted without changing the set of
+ * constraints and add lex-leader symmetry breaking constraints for them. */
+void btor_break_symmetries (Btor* btor);
+
+#endif
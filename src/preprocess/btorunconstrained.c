@@ -8,16 +8,75 @@
 
 #include "preprocess/btorunconstrained.h"
 
+#include "btorbv.h"
 #include "btorcore.h"
 #include "btordbg.h"
 #include "btorexp.h"
 #include "btorlog.h"
+#include "btormodel.h"
 #include "btormsg.h"
 #include "btorsubst.h"
 #include "utils/btorhashint.h"
 #include "utils/btornodeiter.h"
 #include "utils/btorutil.h"
 
+/* In incremental mode and with model generation enabled, every eliminated
+ * term is recorded as fresh variable 'v' (the substitution) followed by its
+ * original children on btor->uc_terms, and BTOR_UC_INFO_SIZE entries on
+ * btor->uc_info (see below). This allows to reinstate the definition
+ * v = t if an unconstrained input gets constrained by subsequently added
+ * formulas, and to compute values for the unconstrained inputs from the
+ * value of 'v' in a model. */
+#define BTOR_UC_INFO_KIND 0
+#define BTOR_UC_INFO_ARITY 1
+#define BTOR_UC_INFO_MASK 2 /* bit i set if child i is unconstrained */
+#define BTOR_UC_INFO_UPPER 3
+#define BTOR_UC_INFO_LOWER 4
+#define BTOR_UC_INFO_SIZE 5
+
+static bool
+is_restricted (Btor *btor)
+{
+  return btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+         || btor_opt_get (btor, BTOR_OPT_MODEL_GEN);
+}
+
+static void
+record_uc (Btor *btor, BtorIntHashTable *uc, BtorNode *exp, BtorNode *subst)
+{
+  assert (btor_node_is_regular (exp));
+  assert (!exp->parameterized);
+  assert (btor_node_is_bv_var (subst));
+
+  uint32_t i, mask;
+
+  mask = 0;
+  for (i = 0; i < exp->arity; i++)
+  {
+    if (btor_hashint_table_contains (uc, btor_node_real_addr (exp->e[i])->id))
+      mask |= 1u << i;
+  }
+  assert (mask);
+
+  BTOR_PUSH_STACK (btor->uc_terms, btor_node_copy (btor, subst));
+  for (i = 0; i < exp->arity; i++)
+    BTOR_PUSH_STACK (btor->uc_terms, btor_node_copy (btor, exp->e[i]));
+
+  BTOR_PUSH_STACK (btor->uc_info, exp->kind);
+  BTOR_PUSH_STACK (btor->uc_info, exp->arity);
+  BTOR_PUSH_STACK (btor->uc_info, mask);
+  if (btor_node_is_bv_slice (exp))
+  {
+    BTOR_PUSH_STACK (btor->uc_info, btor_node_bv_slice_get_upper (exp));
+    BTOR_PUSH_STACK (btor->uc_info, btor_node_bv_slice_get_lower (exp));
+  }
+  else
+  {
+    BTOR_PUSH_STACK (btor->uc_info, 0);
+    BTOR_PUSH_STACK (btor->uc_info, 0);
+  }
+}
+
 static bool
 is_uc_write (BtorNode *cond)
 {
@@ -73,6 +132,8 @@ mark_uc (Btor *btor, BtorIntHashTable *uc, BtorNode *exp)
   else
     subst = btor_exp_var (btor, btor_node_get_sort_id (exp), 0);
 
+  if (is_restricted (btor)) record_uc (btor, uc, exp, subst);
+
   btor_insert_substitution (btor, exp, subst, false);
   btor_node_release (btor, subst);
 }
@@ -82,12 +143,12 @@ btor_optimize_unconstrained (Btor *btor)
 {
   assert (btor);
   assert (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2);
-  assert (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL));
-  assert (!btor_opt_get (btor, BTOR_OPT_MODEL_GEN));
+  assert (!is_restricted (btor)
+          || !btor_opt_get (btor, BTOR_OPT_NONDESTR_SUBST));
 
   double start, delta;
   uint32_t i, num_ucs;
-  bool uc[3], ucp[3];
+  bool uc[3], ucp[3], restricted;
   BtorNode *cur, *cur_parent;
   BtorNodePtrStack stack, roots;
   BtorPtrHashTableIterator it;
@@ -98,7 +159,14 @@ btor_optimize_unconstrained (Btor *btor)
   BtorIntHashTable *mark;
   BtorHashTableData *d;
 
-  if (btor->bv_vars->count == 0 && btor->ufs->count == 0) return;
+  /* In incremental mode and with model generation enabled, we only consider
+   * bit-vector variables as unconstrained inputs since we have to be able to
+   * reinstate eliminated terms and to reconstruct the values of the
+   * eliminated inputs. */
+  restricted = is_restricted (btor);
+
+  if (btor->bv_vars->count == 0 && (restricted || btor->ufs->count == 0))
+    return;
 
   BTORLOG (1, "start unconstrained optimization");
 
@@ -116,7 +184,7 @@ btor_optimize_unconstrained (Btor *btor)
   /* collect nodes that might contribute to a unconstrained candidate
    * propagation */
   btor_iter_hashptr_init (&it, btor->bv_vars);
-  btor_iter_hashptr_queue (&it, btor->ufs);
+  if (!restricted) btor_iter_hashptr_queue (&it, btor->ufs);
   while (btor_iter_hashptr_has_next (&it))
   {
     cur = btor_iter_hashptr_next (&it);
@@ -188,7 +256,9 @@ btor_optimize_unconstrained (Btor *btor)
       btor_hashint_map_remove (mark, cur->id, 0);
 
       /* propagate unconstrained candidates */
-      if (cur->parents == 0 || (cur->parents == 1 && !cur->constraint))
+      if ((cur->parents == 0 || (cur->parents == 1 && !cur->constraint))
+          && (!restricted
+              || (!cur->parameterized && !btor_node_is_fun (cur))))
       {
         for (i = 0; i < cur->arity; i++)
         {
@@ -284,3 +354,270 @@ btor_optimize_unconstrained (Btor *btor)
   assert (btor_dbg_check_all_hash_tables_simp_free (btor));
   assert (btor_dbg_check_unique_table_children_proxy_free (btor));
 }
+
+/*------------------------------------------------------------------------*/
+
+/* Check if 'exp' has parents other than the eliminated unconstrained terms,
+ * which are simplified but still alive if referenced, e.g., by the user. */
+static bool
+has_unsimplified_parents (BtorNode *exp)
+{
+  BtorNodeIterator it;
+
+  btor_iter_parent_init (&it, exp);
+  while (btor_iter_parent_has_next (&it))
+    if (!btor_node_is_simplified (btor_iter_parent_next (&it))) return true;
+  return false;
+}
+
+/* Check if unconstrained input 'exp' got constrained since it was
+ * eliminated, i.e., if it was used in a subsequently added formula. */
+static bool
+is_constrained (Btor *btor, BtorNode *exp)
+{
+  exp = btor_node_real_addr (btor_node_get_simplified (btor, exp));
+
+  if (!btor_node_is_bv_var (exp)) return true;
+  return has_unsimplified_parents (exp) || exp->constraint
+         || btor_hashptr_table_get (btor->varsubst_constraints, exp)
+         || btor_hashptr_table_get (btor->assumptions, exp)
+         || btor_hashptr_table_get (btor->assumptions, btor_node_invert (exp));
+}
+
+void
+btor_reinstate_unconstrained (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, j, k, kind, arity, mask, num_reinst;
+  bool changed, reinst;
+  BtorNode *v, *e[3], *def, *eq;
+  BtorNodePtrStack terms;
+  BtorUIntStack info;
+
+  if (BTOR_EMPTY_STACK (btor->uc_info)) return;
+
+  num_reinst = 0;
+  do
+  {
+    changed = false;
+    BTOR_INIT_STACK (btor->mm, terms);
+    BTOR_INIT_STACK (btor->mm, info);
+    for (i = 0, j = 0; i < BTOR_COUNT_STACK (btor->uc_info);
+         i += BTOR_UC_INFO_SIZE)
+    {
+      kind  = BTOR_PEEK_STACK (btor->uc_info, i + BTOR_UC_INFO_KIND);
+      arity = BTOR_PEEK_STACK (btor->uc_info, i + BTOR_UC_INFO_ARITY);
+      mask  = BTOR_PEEK_STACK (btor->uc_info, i + BTOR_UC_INFO_MASK);
+      v     = BTOR_PEEK_STACK (btor->uc_terms, j);
+      for (k = 0; k < arity; k++)
+        e[k] = BTOR_PEEK_STACK (btor->uc_terms, j + 1 + k);
+      j += 1 + arity;
+
+      reinst = false;
+      for (k = 0; k < arity && !reinst; k++)
+        reinst = (mask & (1u << k)) && is_constrained (btor, e[k]);
+
+      if (!reinst)
+      {
+        for (k = 0; k < BTOR_UC_INFO_SIZE; k++)
+          BTOR_PUSH_STACK (info, BTOR_PEEK_STACK (btor->uc_info, i + k));
+        BTOR_PUSH_STACK (terms, v);
+        for (k = 0; k < arity; k++) BTOR_PUSH_STACK (terms, e[k]);
+        continue;
+      }
+
+      if (kind == BTOR_BV_SLICE_NODE)
+        def = btor_exp_bv_slice (
+            btor,
+            e[0],
+            BTOR_PEEK_STACK (btor->uc_info, i + BTOR_UC_INFO_UPPER),
+            BTOR_PEEK_STACK (btor->uc_info, i + BTOR_UC_INFO_LOWER));
+      else
+        def = btor_exp_create (btor, kind, e, arity);
+      eq = btor_exp_eq (btor, v, def);
+      BTORLOG (2, "reinstate uc term %s", btor_util_node2string (eq));
+      btor_assert_exp (btor, eq);
+      btor_node_release (btor, eq);
+      btor_node_release (btor, def);
+      btor_node_release (btor, v);
+      for (k = 0; k < arity; k++) btor_node_release (btor, e[k]);
+      num_reinst++;
+      changed = true;
+    }
+    BTOR_RELEASE_STACK (btor->uc_terms);
+    BTOR_RELEASE_STACK (btor->uc_info);
+    btor->uc_terms = terms;
+    btor->uc_info  = info;
+  } while (changed);
+
+  btor->stats.uc_reinstated += num_reinst;
+  BTOR_MSG (btor->msg,
+            1,
+            "reinstated %u unconstrained terms, %u remaining",
+            num_reinst,
+            BTOR_COUNT_STACK (btor->uc_info) / BTOR_UC_INFO_SIZE);
+}
+
+/* Set model value of unconstrained input 'exp' to 'bv'. */
+static void
+set_uc_value (Btor *btor,
+              BtorIntHashTable *bv_model,
+              BtorNode *exp,
+              const BtorBitVector *bv)
+{
+  BtorNode *real;
+  BtorBitVector *val;
+  BtorHashTableData *d, dd;
+
+  exp  = btor_node_get_simplified (btor, exp);
+  real = btor_node_real_addr (exp);
+  if (!btor_node_is_bv_var (real)) return;
+
+  val = btor_node_is_inverted (exp) ? btor_bv_not (btor->mm, bv)
+                                    : btor_bv_copy (btor->mm, bv);
+  if ((d = btor_hashint_map_get (bv_model, real->id)))
+  {
+    btor_bv_free (btor->mm, d->as_ptr);
+    d->as_ptr = val;
+  }
+  else
+  {
+    btor_node_copy (btor, real);
+    btor_hashint_map_add (bv_model, real->id)->as_ptr = val;
+  }
+  /* invalidate cached assignment of inverted input */
+  if (btor_hashint_map_contains (bv_model, -real->id))
+  {
+    btor_hashint_map_remove (bv_model, -real->id, &dd);
+    btor_bv_free (btor->mm, dd.as_ptr);
+    btor_node_release (btor, real);
+  }
+}
+
+void
+btor_reconstruct_unconstrained_model (Btor *btor,
+                                      BtorIntHashTable *bv_model,
+                                      BtorIntHashTable *fun_model)
+{
+  assert (btor);
+  assert (bv_model);
+  assert (fun_model);
+
+  uint32_t i, j, k, kind, arity, mask, upper, lower, bw, bw1;
+  BtorNode *v, *e[3];
+  BtorBitVector *tv, *cv, *tmp;
+  BtorMemMgr *mm;
+
+  if (BTOR_EMPTY_STACK (btor->uc_info)) return;
+
+  mm = btor->mm;
+  j  = BTOR_COUNT_STACK (btor->uc_terms);
+  i  = BTOR_COUNT_STACK (btor->uc_info);
+  /* terms are recorded bottom-up, reconstruct top-down */
+  while (i > 0)
+  {
+    i -= BTOR_UC_INFO_SIZE;
+    kind  = BTOR_PEEK_STACK (btor->uc_info, i + BTOR_UC_INFO_KIND);
+    arity = BTOR_PEEK_STACK (btor->uc_info, i + BTOR_UC_INFO_ARITY);
+    mask  = BTOR_PEEK_STACK (btor->uc_info, i + BTOR_UC_INFO_MASK);
+    upper = BTOR_PEEK_STACK (btor->uc_info, i + BTOR_UC_INFO_UPPER);
+    lower = BTOR_PEEK_STACK (btor->uc_info, i + BTOR_UC_INFO_LOWER);
+    j -= 1 + arity;
+    v = BTOR_PEEK_STACK (btor->uc_terms, j);
+    for (k = 0; k < arity; k++)
+      e[k] = BTOR_PEEK_STACK (btor->uc_terms, j + 1 + k);
+
+    tv = btor_bv_copy (mm, btor_model_get_bv_aux (btor, bv_model, fun_model, v));
+    bw = btor_bv_get_width (tv);
+
+    switch (kind)
+    {
+      case BTOR_BV_SLICE_NODE:
+        cv = btor_bv_copy (
+            mm, btor_model_get_bv_aux (btor, bv_model, fun_model, e[0]));
+        for (k = lower; k <= upper; k++)
+          btor_bv_set_bit (cv, k, btor_bv_get_bit (tv, k - lower));
+        set_uc_value (btor, bv_model, e[0], cv);
+        btor_bv_free (mm, cv);
+        break;
+
+      case BTOR_BV_ADD_NODE:
+        k  = mask & 1 ? 0 : 1;
+        cv = btor_bv_sub (
+            mm, tv, btor_model_get_bv_aux (btor, bv_model, fun_model, e[1 - k]));
+        set_uc_value (btor, bv_model, e[k], cv);
+        btor_bv_free (mm, cv);
+        break;
+
+      case BTOR_BV_EQ_NODE:
+        k  = mask & 1 ? 0 : 1;
+        cv = btor_bv_copy (
+            mm, btor_model_get_bv_aux (btor, bv_model, fun_model, e[1 - k]));
+        if (!btor_bv_is_true (tv))
+        {
+          tmp = btor_bv_not (mm, cv);
+          btor_bv_free (mm, cv);
+          cv = tmp;
+        }
+        set_uc_value (btor, bv_model, e[k], cv);
+        btor_bv_free (mm, cv);
+        break;
+
+      case BTOR_BV_ULT_NODE:
+        bw1 = btor_node_bv_get_width (btor, e[0]);
+        cv  = btor_bv_new (mm, bw1);
+        set_uc_value (btor, bv_model, e[0], cv);
+        if (btor_bv_is_true (tv)) btor_bv_set_bit (cv, 0, 1);
+        set_uc_value (btor, bv_model, e[1], cv);
+        btor_bv_free (mm, cv);
+        break;
+
+      case BTOR_BV_CONCAT_NODE:
+        bw1 = btor_node_bv_get_width (btor, e[1]);
+        cv  = btor_bv_slice (mm, tv, bw - 1, bw1);
+        set_uc_value (btor, bv_model, e[0], cv);
+        btor_bv_free (mm, cv);
+        cv = btor_bv_slice (mm, tv, bw1 - 1, 0);
+        set_uc_value (btor, bv_model, e[1], cv);
+        btor_bv_free (mm, cv);
+        break;
+
+      case BTOR_BV_AND_NODE:
+      case BTOR_BV_MUL_NODE:
+      case BTOR_BV_SLL_NODE:
+      case BTOR_BV_SRL_NODE:
+      case BTOR_BV_UDIV_NODE:
+      case BTOR_BV_UREM_NODE:
+        /* t & ~0 = t * 1 = t << 0 = t >> 0 = t / 1 = t % 0 = t */
+        set_uc_value (btor, bv_model, e[0], tv);
+        bw1 = btor_node_bv_get_width (btor, e[1]);
+        if (kind == BTOR_BV_AND_NODE)
+          cv = btor_bv_ones (mm, bw1);
+        else if (kind == BTOR_BV_MUL_NODE || kind == BTOR_BV_UDIV_NODE)
+          cv = btor_bv_one (mm, bw1);
+        else
+          cv = btor_bv_new (mm, bw1);
+        set_uc_value (btor, bv_model, e[1], cv);
+        btor_bv_free (mm, cv);
+        break;
+
+      default:
+        assert (kind == BTOR_COND_NODE);
+        if ((mask & 6) == 6)
+        {
+          set_uc_value (btor, bv_model, e[1], tv);
+          set_uc_value (btor, bv_model, e[2], tv);
+        }
+        else
+        {
+          assert (mask & 1);
+          cv = mask & 2 ? btor_bv_one (mm, 1) : btor_bv_new (mm, 1);
+          set_uc_value (btor, bv_model, e[0], cv);
+          set_uc_value (btor, bv_model, mask & 2 ? e[1] : e[2], tv);
+          btor_bv_free (mm, cv);
+        }
+    }
+    btor_bv_free (mm, tv);
+  }
+}
@@ -10,7 +10,18 @@
 #define BTORUNCONSTRAINED_H_INCLUDED
 
 #include "btortypes.h"
+#include "utils/btorhashint.h"
 
 void btor_optimize_unconstrained (Btor* btor);
 
+/* Reinstate eliminated unconstrained terms whose unconstrained inputs got
+ * constrained by formulas added after the last call to
+ * btor_optimize_unconstrained (incremental mode). */
+void btor_reinstate_unconstrained (Btor* btor);
+
+/* Compute model values for eliminated unconstrained inputs. */
+void btor_reconstruct_unconstrained_model (Btor* btor,
+                                           BtorIntHashTable* bv_model,
+                                           BtorIntHashTable* fun_model);
+
 #endif
@@ -88,6 +88,12 @@ stats (BtorSATMgr *smgr)
   picosat_stats (smgr->solver);
 }
 
+static void
+phase (BtorSATMgr *smgr, int32_t lit)
+{
+  picosat_set_default_phase_lit (smgr->solver, abs (lit), lit > 0 ? 1 : -1);
+}
+
 static int32_t
 fixed (BtorSATMgr *smgr, int32_t lit)
 {
@@ -130,6 +136,7 @@ btor_sat_enable_picosat (BtorSATMgr *smgr)
   smgr->api.inc_max_var      = inc_max_var;
   smgr->api.init             = init;
   smgr->api.melt             = 0;
+  smgr->api.phase            = phase;
   smgr->api.repr             = 0;
   smgr->api.reset            = reset;
   smgr->api.sat              = sat;
@@ -0,0 +1,11 @@
+(set-logic QF_UFBV)
+(declare-fun f ((_ BitVec 8)) (_ BitVec 8))
+(declare-fun x () (_ BitVec 8))
+(assert (= (f #x01) #x00))
+(assert (= (f #x02) #x01))
+(assert (= (f #x03) #x01))
+(assert (bvult x #x02))
+(assert (bvugt x #x00))
+(assert (= (f x) #x02))
+(check-sat)
+(exit)
@@ -0,0 +1,13 @@
+(set-logic QF_BV)
+(set-option :produce-models true)
+(declare-fun x () (_ BitVec 16))
+(assert (= ((_ extract 7 0) x) #x12))
+(check-sat)
+(assert (= ((_ extract 11 4) x) #x31))
+(check-sat)
+(assert (= ((_ extract 15 12) x) #xa))
+(check-sat)
+(get-value (x))
+(assert (= ((_ extract 5 2) x) #x0))
+(check-sat)
+(exit)
@@ -0,0 +1,13 @@
+(set-logic QF_ABV)
+(declare-fun a () (Array (_ BitVec 8) (_ BitVec 8)))
+(declare-fun x () (_ BitVec 8))
+(define-fun b () (Array (_ BitVec 8) (_ BitVec 8))
+  (store (store (store (store (store (store (store (store (store a
+    #x00 #xff) #x01 #xff) #x02 #xff)
+    #x08 #xff) #x09 #xff) #x0a #xff)
+    #x10 #xff) #x11 #xff) #x12 #xff))
+(assert (bvult x #x13))
+(assert (= ((_ extract 2 0) x) #b001))
+(assert (not (= (select b x) #xff)))
+(check-sat)
+(exit)
@@ -0,0 +1,11 @@
+(set-logic QF_ABV)
+(declare-fun a () (Array (_ BitVec 8) (_ BitVec 8)))
+(declare-fun x () (_ BitVec 8))
+(define-fun b () (Array (_ BitVec 8) (_ BitVec 8))
+  (store (store (store (store (store (store a
+    #x00 #x01) #x01 #x03) #x02 #x05) #x03 #x07) #x04 #x09) #x05 #x0b))
+(assert (bvult x #x06))
+(assert (= (select b x) #x07))
+(assert (not (= x #x03)))
+(check-sat)
+(exit)
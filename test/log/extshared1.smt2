@@ -0,0 +1,15 @@
+(set-logic QF_ABV)
+(declare-fun a () (Array (_ BitVec 4) (_ BitVec 4)))
+(declare-fun b () (Array (_ BitVec 4) (_ BitVec 4)))
+(declare-fun c () (Array (_ BitVec 4) (_ BitVec 4)))
+(declare-fun d () (Array (_ BitVec 4) (_ BitVec 4)))
+(declare-fun i () (_ BitVec 4))
+(declare-fun j () (_ BitVec 4))
+(assert (= a b))
+(assert (= a c))
+(assert (= b d))
+(assert (= c d))
+(assert (= (select (store a i #x1) j) (select d j)))
+(assert (not (= (select b i) (select c j))))
+(check-sat)
+(exit)
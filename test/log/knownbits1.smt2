@@ -0,0 +1,10 @@
+(set-logic QF_BV)
+(set-option :produce-models true)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(declare-fun z () (_ BitVec 8))
+(assert (= (ite (bvult (bvor x #x80) #x10) y z) #x2a))
+(assert (bvult (bvor x #xf0) (bvor y #xf0)))
+(check-sat)
+(get-value (z))
+(exit)
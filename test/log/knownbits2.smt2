@@ -0,0 +1,7 @@
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (bvult (bvor x #xf0) (concat #xf ((_ extract 7 4) y))))
+(assert (= (bvor ((_ extract 7 4) y) ((_ extract 3 0) (bvand x #xf0))) #x0))
+(check-sat)
+(exit)
@@ -0,0 +1,11 @@
+(set-logic QF_BV)
+(set-option :produce-models true)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(declare-fun z () (_ BitVec 8))
+(assert (= (bvadd (bvmul #x03 x) (bvmul #x02 y)) #x07))
+(assert (= (bvadd x (bvmul #x04 y) z) #x01))
+(assert (= (bvmul #x02 (bvadd y z)) #x06))
+(check-sat)
+(get-value (x z))
+(exit)
@@ -0,0 +1,7 @@
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 16))
+(declare-fun y () (_ BitVec 16))
+(assert (= (bvadd x y) #x0001))
+(assert (= (bvsub x y) #x0000))
+(check-sat)
+(exit)
@@ -0,0 +1,9 @@
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(declare-fun z () (_ BitVec 8))
+(assert (= (bvadd x (bvmul #x03 y)) #x07))
+(assert (= (bvsub x y) #x03))
+(assert (= (bvor z #x0f) (bvadd y #x0d)))
+(check-sat)
+(exit)
@@ -0,0 +1,7 @@
+(set-logic QF_UFBV)
+(declare-fun f ((_ BitVec 8)) (_ BitVec 8))
+(declare-fun x () (_ BitVec 8))
+(assert (= ((_ extract 3 0) x) #x1))
+(assert (not (= (f x) (f (concat ((_ extract 7 4) x) #x1)))))
+(check-sat)
+(exit)
@@ -0,0 +1,11 @@
+(set-logic QF_BV)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (or a (bvult x y)))
+(assert (or a (not (bvult x y))))
+(assert (=> a (= x (bvadd y #x01))))
+(assert (or b (= x y)))
+(check-sat)
+(exit)
@@ -0,0 +1,10 @@
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 4))
+(declare-fun y () (_ BitVec 4))
+(declare-fun z () (_ BitVec 4))
+(assert (distinct x y z))
+(assert (bvult x #x2))
+(assert (bvult y #x2))
+(assert (bvult z #x2))
+(check-sat)
+(exit)
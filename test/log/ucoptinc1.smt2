@@ -0,0 +1,21 @@
+(set-logic QF_BV)
+(set-option :produce-models true)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (= (bvadd x y) #x05))
+(check-sat)
+(assert (= x #x03))
+(check-sat)
+(get-value (x y))
+(declare-fun z () (_ BitVec 8))
+(declare-fun w () (_ BitVec 8))
+(define-fun zw () (_ BitVec 8) (bvadd z w))
+(assert (= zw #x07))
+(check-sat)
+(assert (bvult x #x04))
+(check-sat)
+(assert (= z w))
+(check-sat)
+(assert (= y #x03))
+(check-sat)
+(exit)
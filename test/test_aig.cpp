@@ -9,6 +9,7 @@
 
 extern "C" {
 #include "btoraig.h"
+#include "btoraigsim.h"
 #include "dumper/btordumpaig.h"
 }
 
@@ -143,3 +144,40 @@ TEST_F (TestAig, aig_to_sat)
   btor_aig_release (amgr, and3);
   btor_aig_mgr_delete (amgr);
 }
+
+TEST_F (TestAig, sim)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorAIGSim *sim  = btor_aigsim_new (amgr);
+  BtorAIG *var1    = btor_aig_var (amgr);
+  BtorAIG *var2    = btor_aig_var (amgr);
+  BtorAIG *var3    = btor_aig_var (amgr);
+  BtorAIG *cond    = btor_aig_cond (amgr, var1, var2, var3);
+  BtorAIG *eq      = btor_aig_eq (amgr, var1, var2);
+  uint64_t v1      = 0xf0f0f0f0f0f0f0f0ull;
+  uint64_t v2      = 0xccccccccccccccccull;
+  uint64_t v3      = 0xaaaaaaaaaaaaaaaaull;
+  btor_aigsim_add_root (sim, cond);
+  btor_aigsim_add_root (sim, eq);
+  btor_aigsim_add_root (sim, BTOR_AIG_TRUE);
+  btor_aigsim_set_var (sim, var1, v1);
+  btor_aigsim_set_var (sim, var2, v2);
+  btor_aigsim_set_var (sim, var3, v3);
+  btor_aigsim_simulate (sim);
+  ASSERT_EQ (btor_aigsim_get (sim, cond), (v1 & v2) | (~v1 & v3));
+  ASSERT_EQ (btor_aigsim_get (sim, BTOR_INVERT_AIG (cond)),
+             ~((v1 & v2) | (~v1 & v3)));
+  ASSERT_EQ (btor_aigsim_get (sim, eq), ~(v1 ^ v2));
+  ASSERT_EQ (btor_aigsim_get (sim, BTOR_AIG_TRUE), ~0ull);
+  ASSERT_EQ (btor_aigsim_get (sim, BTOR_AIG_FALSE), 0ull);
+  btor_aigsim_set_var (sim, var1, ~0ull);
+  btor_aigsim_simulate (sim);
+  ASSERT_EQ (btor_aigsim_get (sim, cond), v2);
+  btor_aigsim_delete (sim);
+  btor_aig_release (amgr, var1);
+  btor_aig_release (amgr, var2);
+  btor_aig_release (amgr, var3);
+  btor_aig_release (amgr, cond);
+  btor_aig_release (amgr, eq);
+  btor_aig_mgr_delete (amgr);
+}
@@ -842,6 +842,53 @@ TEST_F (TestBv, new_random_range)
   }
 }
 
+TEST_F (TestBv, random_uint64)
+{
+  uint32_t bw, i;
+  uint64_t val, from, to;
+  BtorRNG rng1, rng2;
+  BtorBitVector *bv, *bvfrom, *bvto;
+
+  /* same seed, must draw the same random numbers */
+  btor_rng_init (&rng1, 42);
+  btor_rng_init (&rng2, 42);
+  for (bw = 1; bw <= 64; bw++)
+  {
+    for (i = 0; i < 10; i++)
+    {
+      bv   = btor_bv_new_random (d_mm, &rng1, bw);
+      from = btor_bv_random_uint64 (d_mm, &rng2, bw);
+      ASSERT_EQ (from, btor_bv_to_uint64 (bv));
+      btor_bv_free (d_mm, bv);
+      bv = btor_bv_new_random (d_mm, &rng1, bw);
+      to = btor_bv_random_uint64 (d_mm, &rng2, bw);
+      ASSERT_EQ (to, btor_bv_to_uint64 (bv));
+      btor_bv_free (d_mm, bv);
+
+      if (to < from)
+      {
+        val  = to;
+        to   = from;
+        from = val;
+      }
+      if (i == 0) from = 0;
+      if (i == 1) to = bw == 64 ? ~((uint64_t) 0) : (((uint64_t) 1) << bw) - 1;
+      bvfrom = btor_bv_uint64_to_bv (d_mm, from, bw);
+      bvto   = btor_bv_uint64_to_bv (d_mm, to, bw);
+      bv     = btor_bv_new_random_range (d_mm, &rng1, bw, bvfrom, bvto);
+      val    = btor_bv_random_range_uint64 (d_mm, &rng2, bw, from, to);
+      ASSERT_GE (val, from);
+      ASSERT_LE (val, to);
+      ASSERT_EQ (val, btor_bv_to_uint64 (bv));
+      btor_bv_free (d_mm, bv);
+      btor_bv_free (d_mm, bvfrom);
+      btor_bv_free (d_mm, bvto);
+    }
+  }
+  btor_rng_delete (&rng1);
+  btor_rng_delete (&rng2);
+}
+
 TEST_F (TestBv, new_random_bit_range)
 {
   new_random_bit_range_bitvec (BTOR_TEST_BITVEC_TESTS, 1);
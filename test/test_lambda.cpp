@@ -12,6 +12,7 @@ extern "C" {
 #include "btorbeta.h"
 #include "btorcore.h"
 #include "btorexp.h"
+#include "preprocess/btorextract.h"
 #include "utils/btormem.h"
 #include "utils/btorutil.h"
 }
@@ -1613,3 +1614,74 @@ TEST_F (TestLambda, define_fun)
   btor_mem_free (d_btor->mm, ands, size - sizeof (BtorNode *));
   btor_node_release (d_btor, result);
 }
+
+/*---------------------------------------------------------------------------
+ * lambda extraction tests
+ *---------------------------------------------------------------------------*/
+
+TEST_F (TestLambda, extract_set_2d)
+{
+  uint32_t i, j;
+  BtorNode *a, *x, *idx, *val, *tmp, *read, *ne;
+
+  /* rows {0, 1, 2}, {8, 9, 10} and {16, 17, 18} set to the same value */
+  a   = btor_exp_array (d_btor, d_array_sort, "a");
+  x   = btor_exp_var (d_btor, d_index_sort, "x");
+  val = btor_exp_bv_unsigned (d_btor, 0xff, d_elem_sort);
+  for (i = 0; i < 3; i++)
+  {
+    for (j = 0; j < 3; j++)
+    {
+      idx = btor_exp_bv_unsigned (d_btor, 8 * i + j, d_index_sort);
+      tmp = btor_exp_write (d_btor, a, idx, val);
+      btor_node_release (d_btor, idx);
+      btor_node_release (d_btor, a);
+      a = tmp;
+    }
+  }
+  read = btor_exp_read (d_btor, a, x);
+  ne   = btor_exp_ne (d_btor, read, val);
+  btor_assert_exp (d_btor, ne);
+
+  btor_extract_lambdas (d_btor);
+  ASSERT_EQ (d_btor->stats.extracted_set_2d, 1u);
+
+  btor_node_release (d_btor, ne);
+  btor_node_release (d_btor, read);
+  btor_node_release (d_btor, val);
+  btor_node_release (d_btor, x);
+  btor_node_release (d_btor, a);
+}
+
+TEST_F (TestLambda, extract_affine)
+{
+  uint32_t i;
+  BtorNode *a, *x, *idx, *val, *tmp, *read, *c, *eq;
+
+  /* a[i] = 2 * i + 1 for 0 <= i < 6 */
+  a = btor_exp_array (d_btor, d_array_sort, "a");
+  x = btor_exp_var (d_btor, d_index_sort, "x");
+  for (i = 0; i < 6; i++)
+  {
+    idx = btor_exp_bv_unsigned (d_btor, i, d_index_sort);
+    val = btor_exp_bv_unsigned (d_btor, 2 * i + 1, d_elem_sort);
+    tmp = btor_exp_write (d_btor, a, idx, val);
+    btor_node_release (d_btor, val);
+    btor_node_release (d_btor, idx);
+    btor_node_release (d_btor, a);
+    a = tmp;
+  }
+  read = btor_exp_read (d_btor, a, x);
+  c    = btor_exp_bv_unsigned (d_btor, 7, d_elem_sort);
+  eq   = btor_exp_eq (d_btor, read, c);
+  btor_assert_exp (d_btor, eq);
+
+  btor_extract_lambdas (d_btor);
+  ASSERT_EQ (d_btor->stats.extracted_affine, 1u);
+
+  btor_node_release (d_btor, eq);
+  btor_node_release (d_btor, c);
+  btor_node_release (d_btor, read);
+  btor_node_release (d_btor, x);
+  btor_node_release (d_btor, a);
+}